@@ -0,0 +1,236 @@
+/*************************************
+ * Définition de la classe BitCount. *
+ *************************************/
+
+#include "BitCount.hpp"
+#include "SimdCount.hpp"
+#include <omp.h>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BIT_COUNT_X86
+#include <immintrin.h>
+#include <cpuid.h>
+#endif
+
+namespace paralgos {
+
+  namespace {
+
+    /**
+     * Nombre de bits d'un mot.
+     */
+    const size_t BITS = 64;
+
+    /**
+     * Nombre de bits d'une ligne de cache : les blocs des threads commencent
+     * sur une ligne de cache.
+     */
+    const size_t LIGNE = 512;
+
+    /**
+     * Version portable du noyau.
+     */
+    size_t
+    popcountScalar(const uint64_t words[], const size_t& n) {
+      size_t acc = 0;
+      for (size_t i = 0; i != n; i ++) {
+        acc += __builtin_popcountll(words[i]);
+      }
+      return acc;
+    }
+
+#ifdef BIT_COUNT_X86
+
+    /**
+     * Version du noyau utilisant l'instruction popcnt. Quatre accumulateurs
+     * indépendants masquent la latence de l'instruction.
+     */
+    __attribute__((target("popcnt")))
+    size_t
+    popcountPOPCNT(const uint64_t words[], const size_t& n) {
+      uint64_t a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4) {
+        a0 += _mm_popcnt_u64(words[i]);
+        a1 += _mm_popcnt_u64(words[i + 1]);
+        a2 += _mm_popcnt_u64(words[i + 2]);
+        a3 += _mm_popcnt_u64(words[i + 3]);
+      }
+      for (; i != n; i ++) {
+        a0 += _mm_popcnt_u64(words[i]);
+      }
+      return a0 + a1 + a2 + a3;
+    }
+
+    /**
+     * Version AVX-512 du noyau : huit mots sont comptés par instruction
+     * vpopcntq, les compteurs 64 bits de chaque voie ne pouvant déborder.
+     */
+    __attribute__((target("avx512f,avx512vpopcntdq")))
+    size_t
+    popcountAVX512(const uint64_t words[], const size_t& n) {
+      __m512i a0 = _mm512_setzero_si512();
+      __m512i a1 = _mm512_setzero_si512();
+      size_t i = 0;
+      for (; i + 16 <= n; i += 16) {
+        a0 = _mm512_add_epi64(a0, _mm512_popcnt_epi64(
+          _mm512_loadu_si512(words + i)));
+        a1 = _mm512_add_epi64(a1, _mm512_popcnt_epi64(
+          _mm512_loadu_si512(words + i + 8)));
+      }
+      if (i + 8 <= n) {
+        a0 = _mm512_add_epi64(a0, _mm512_popcnt_epi64(
+          _mm512_loadu_si512(words + i)));
+        i += 8;
+      }
+      if (i != n) {
+        const __mmask8 m = (1u << (n - i)) - 1;
+        a1 = _mm512_add_epi64(a1, _mm512_popcnt_epi64(
+          _mm512_maskz_loadu_epi64(m, words + i)));
+      }
+      alignas(64) uint64_t counters[8];
+      _mm512_store_si512(counters, _mm512_add_epi64(a0, a1));
+      size_t sum = 0;
+      for (size_t l = 0; l != 8; l ++) {
+        sum += counters[l];
+      }
+      return sum;
+    }
+
+#endif
+
+    /**
+     * Les instructions de comptage de bits disponibles.
+     */
+    enum Popcnt { PORTABLE, POPCNT, VPOPCNTQ };
+
+    /**
+     * Détermine, via l'instruction cpuid, l'instruction de comptage de bits
+     * la plus performante supportée par le processeur.
+     */
+    Popcnt
+    detect() {
+#ifdef BIT_COUNT_X86
+      unsigned eax, ebx, ecx, edx;
+      if (! __get_cpuid(1, &eax, &ebx, &ecx, &edx) || ! (ecx & bit_POPCNT)) {
+        return PORTABLE;
+      }
+
+      // vpopcntq n'est utilisable que si AVX-512 l'est (cf. SimdCount).
+      if (SimdCount::detect() == SimdCount::AVX512
+          && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)
+          && (ecx & bit_AVX512VPOPCNTDQ)) {
+        return VPOPCNTQ;
+      }
+      return POPCNT;
+#else
+      return PORTABLE;
+#endif
+    }
+
+    /** L'instruction de comptage de bits la plus performante disponible. */
+    const Popcnt best = detect();
+
+  } // anonyme
+
+  /*********
+   * apply *
+   *********/
+
+  size_t
+  BitCount::apply(const uint64_t words[],
+                  const size_t& first,
+                  const size_t& last,
+                  const bool& val) {
+    const size_t acc = ones(words, first, last);
+    return val ? acc : (last - first) - acc;
+  }
+
+  size_t
+  BitCount::apply(const uint64_t words[],
+                  const size_t& first,
+                  const size_t& last,
+                  const bool& val,
+                  const ExecutionContext& context) {
+
+    // Trop peu de mots pour amortir le coût d'une région parallèle.
+    const size_t n = last - first;
+    if (context.sequential(n / BITS)) {
+      return apply(words, first, last, val);
+    }
+
+    // Le nombre de bits à 1.
+    size_t acc = 0;
+
+    // Chaque thread traite un bloc de mots commençant sur une ligne de
+    // cache : seuls le premier et le dernier mot de la plage sont partiels.
+    const int threads = context.threads();
+#pragma omp parallel for schedule(static, 1) reduction(+: acc) num_threads(threads)
+    for (int r = 0; r < threads; r ++) {
+      const size_t ir = r == 0 ? first : std::min(
+        last, (first + n * r / threads + LIGNE - 1) / LIGNE * LIGNE);
+      const size_t ir1 = r == threads - 1 ? last : std::min(
+        last, (first + n * (r + 1) / threads + LIGNE - 1) / LIGNE * LIGNE);
+      acc += ones(words, ir, ir1);
+    }
+
+    // C'est terminé.
+    return val ? acc : n - acc;
+
+  }
+
+  /************
+   * popcount *
+   ************/
+
+  size_t
+  BitCount::popcount(const uint64_t words[], const size_t& n) {
+
+    // Le jeu d'instructions imposé à SimdCount borne celui utilisé ici.
+#ifdef BIT_COUNT_X86
+    const SimdCount::Isa isa = SimdCount::isa();
+    if (best == VPOPCNTQ && isa == SimdCount::AVX512) {
+      return popcountAVX512(words, n);
+    }
+    if (best != PORTABLE && isa != SimdCount::SCALAR) {
+      return popcountPOPCNT(words, n);
+    }
+#endif
+    return popcountScalar(words, n);
+
+  }
+
+  /********
+   * ones *
+   ********/
+
+  size_t
+  BitCount::ones(const uint64_t words[],
+                 const size_t& first,
+                 const size_t& last) {
+
+    // La plage est vide.
+    if (first >= last) {
+      return 0;
+    }
+
+    // Masques des bits couverts dans le premier et le dernier mot.
+    const size_t w0 = first / BITS;
+    const size_t w1 = (last - 1) / BITS;
+    const uint64_t debut = ~uint64_t(0) << (first % BITS);
+    const uint64_t fin = ~uint64_t(0) >> (BITS - 1 - (last - 1) % BITS);
+
+    // La plage tient dans un seul mot.
+    if (w0 == w1) {
+      return __builtin_popcountll(words[w0] & debut & fin);
+    }
+
+    // Mots partiels aux extrémités, mots complets entre les deux.
+    return __builtin_popcountll(words[w0] & debut)
+      + popcount(words + w0 + 1, w1 - w0 - 1)
+      + __builtin_popcountll(words[w1] & fin);
+
+  }
+
+} // paralgos
@@ -0,0 +1,344 @@
+/*****************************************
+ * Définition de la classe BitonicMerge. *
+ *****************************************/
+
+#include "BitonicMerge.hpp"
+#include "SimdCount.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BITONIC_MERGE_X86
+#include <immintrin.h>
+#endif
+
+namespace merging {
+
+  namespace {
+
+#ifdef BITONIC_MERGE_X86
+
+    /**
+     * Réseau de fusion bitonique pour des voies de 32 bits (huit voies par
+     * registre AVX2). Le paramètre @c M fournit les opérations min et max
+     * sur les éléments d'un registre.
+     *
+     * Dans min(a, b) et max(a, b), a est retenu si a < b (resp. a > b) et b
+     * sinon : à égalité ou face à un NaN, min(a, b) et max(b, a) se
+     * répartissent donc a et b au lieu de dupliquer l'un d'eux.
+     */
+    template< typename M >
+    struct Reseau32 {
+
+      typedef typename M::T T;
+      typedef __m256i V;
+      static const size_t VOIES = 8;
+
+      __attribute__((target("avx2"))) static inline V
+      load(const T* p) {
+        return _mm256_loadu_si256(reinterpret_cast< const V* >(p));
+      }
+
+      __attribute__((target("avx2"))) static inline void
+      store(T* p, const V& v) {
+        _mm256_storeu_si256(reinterpret_cast< V* >(p), v);
+      }
+
+      __attribute__((target("avx2"))) static inline V
+      reverse(const V& v) {
+        return _mm256_permutevar8x32_epi32(
+          v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+      }
+
+      /**
+       * Trie une suite bitonique : la voie i est comparée à la voie i ^ d
+       * pour d = 4, 2 puis 1, la plus petite valeur étant conservée dans la
+       * voie de rang inférieur.
+       */
+      __attribute__((target("avx2"))) static inline V
+      clean(V v) {
+        V x = _mm256_permute2x128_si256(v, v, 0x01);
+        v = _mm256_blend_epi32(M::min(v, x), M::max(v, x), 0xF0);
+        x = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+        v = _mm256_blend_epi32(M::min(v, x), M::max(v, x), 0xCC);
+        x = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm256_blend_epi32(M::min(v, x), M::max(v, x), 0xAA);
+        return v;
+      }
+
+    }; // Reseau32
+
+    /**
+     * Réseau de fusion bitonique pour des voies de 64 bits (quatre voies par
+     * registre AVX2).
+     */
+    template< typename M >
+    struct Reseau64 {
+
+      typedef typename M::T T;
+      typedef __m256i V;
+      static const size_t VOIES = 4;
+
+      __attribute__((target("avx2"))) static inline V
+      load(const T* p) {
+        return _mm256_loadu_si256(reinterpret_cast< const V* >(p));
+      }
+
+      __attribute__((target("avx2"))) static inline void
+      store(T* p, const V& v) {
+        _mm256_storeu_si256(reinterpret_cast< V* >(p), v);
+      }
+
+      __attribute__((target("avx2"))) static inline V
+      reverse(const V& v) {
+        return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+      }
+
+      __attribute__((target("avx2"))) static inline V
+      clean(V v) {
+        V x = _mm256_permute2x128_si256(v, v, 0x01);
+        v = _mm256_blend_epi32(M::min(v, x), M::max(v, x), 0xF0);
+        x = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+        v = _mm256_blend_epi32(M::min(v, x), M::max(v, x), 0xCC);
+        return v;
+      }
+
+    }; // Reseau64
+
+    /**
+     * Opérations min et max, une structure par type d'éléments.
+     */
+    struct MinMaxI32 {
+      typedef int32_t T;
+      __attribute__((target("avx2"))) static inline __m256i
+      min(const __m256i& a, const __m256i& b) {
+        return _mm256_min_epi32(a, b);
+      }
+      __attribute__((target("avx2"))) static inline __m256i
+      max(const __m256i& a, const __m256i& b) {
+        return _mm256_max_epi32(a, b);
+      }
+    };
+
+    struct MinMaxU32 {
+      typedef uint32_t T;
+      __attribute__((target("avx2"))) static inline __m256i
+      min(const __m256i& a, const __m256i& b) {
+        return _mm256_min_epu32(a, b);
+      }
+      __attribute__((target("avx2"))) static inline __m256i
+      max(const __m256i& a, const __m256i& b) {
+        return _mm256_max_epu32(a, b);
+      }
+    };
+
+    // minps et maxps retournent leur second opérande à égalité ou face à un
+    // NaN, conformément à la convention de Reseau32.
+    struct MinMaxF32 {
+      typedef float T;
+      __attribute__((target("avx2"))) static inline __m256i
+      min(const __m256i& a, const __m256i& b) {
+        return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a),
+                                                 _mm256_castsi256_ps(b)));
+      }
+      __attribute__((target("avx2"))) static inline __m256i
+      max(const __m256i& a, const __m256i& b) {
+        return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a),
+                                                 _mm256_castsi256_ps(b)));
+      }
+    };
+
+    // AVX2 ne dispose ni de min ni de max pour des entiers 64 bits : ils sont
+    // obtenus par comparaison puis sélection.
+    struct MinMaxI64 {
+      typedef int64_t T;
+      __attribute__((target("avx2"))) static inline __m256i
+      min(const __m256i& a, const __m256i& b) {
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+      }
+      __attribute__((target("avx2"))) static inline __m256i
+      max(const __m256i& a, const __m256i& b) {
+        return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+      }
+    };
+
+    // Les entiers non signés sont comparés après inversion de leur bit de
+    // poids fort.
+    struct MinMaxU64 {
+      typedef uint64_t T;
+      __attribute__((target("avx2"))) static inline __m256i
+      gt(const __m256i& a, const __m256i& b) {
+        const __m256i signe = _mm256_set1_epi64x(INT64_MIN);
+        return _mm256_cmpgt_epi64(_mm256_xor_si256(a, signe),
+                                  _mm256_xor_si256(b, signe));
+      }
+      __attribute__((target("avx2"))) static inline __m256i
+      min(const __m256i& a, const __m256i& b) {
+        return _mm256_blendv_epi8(a, b, gt(a, b));
+      }
+      __attribute__((target("avx2"))) static inline __m256i
+      max(const __m256i& a, const __m256i& b) {
+        return _mm256_blendv_epi8(b, a, gt(a, b));
+      }
+    };
+
+    struct MinMaxF64 {
+      typedef double T;
+      __attribute__((target("avx2"))) static inline __m256i
+      min(const __m256i& a, const __m256i& b) {
+        return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(a),
+                                                 _mm256_castsi256_pd(b)));
+      }
+      __attribute__((target("avx2"))) static inline __m256i
+      max(const __m256i& a, const __m256i& b) {
+        return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(a),
+                                                 _mm256_castsi256_pd(b)));
+      }
+    };
+
+    /**
+     * Version AVX2 du noyau. Le registre vb contient en permanence les plus
+     * grands éléments déjà lus, triés ; chaque registre lu est fusionné avec
+     * lui, la moitié inférieure du résultat étant recopiée dans le
+     * conteneur cible. Le registre suivant est lu dans la suite dont
+     * l'élément de tête est le plus petit : tous les éléments non encore lus
+     * sont ainsi supérieurs ou égaux à ceux déjà recopiés.
+     */
+    template< typename R, typename M >
+    __attribute__((target("avx2"))) void
+    mergeAVX2(const typename M::T a[], const size_t& m,
+              const typename M::T b[], const size_t& n,
+              typename M::T result[]) {
+      typedef typename M::T T;
+      typedef typename R::V V;
+      const size_t W = R::VOIES;
+
+      // Trop peu d'éléments pour remplir un registre de chaque suite.
+      if (m < W || n < W) {
+        std::merge(a, a + m, b, b + n, result);
+        return;
+      }
+
+      // Fusion des registres, tant que chacune des deux suites peut en
+      // fournir un.
+      V va = R::load(a);
+      V vb = R::load(b);
+      size_t i = W, j = W;
+      for (;;) {
+        const V vr = R::reverse(va);
+        R::store(result, R::clean(M::min(vb, vr)));
+        vb = R::clean(M::max(vr, vb));
+        result += W;
+        if (i + W > m || j + W > n) {
+          break;
+        }
+        const bool premiere = ! (b[j] < a[i]);
+        va = R::load(premiere ? a + i : b + j);
+        i += premiere ? W : 0;
+        j += premiere ? 0 : W;
+      }
+
+      // Fusion des éléments restants : ceux du registre vb et ceux des deux
+      // suites, dont l'une au moins compte moins de W éléments. Le registre
+      // est d'abord fusionné avec la plus courte, dans un tampon de 2W
+      // éléments au plus.
+      T reste[R::VOIES], tampon[2 * R::VOIES];
+      R::store(reste, vb);
+      if (m - i < W) {
+        T* const fin = std::merge(reste, reste + W, a + i, a + m, tampon);
+        std::merge(tampon, fin, b + j, b + n, result);
+      } else {
+        T* const fin = std::merge(reste, reste + W, b + j, b + n, tampon);
+        std::merge(tampon, fin, a + i, a + m, result);
+      }
+    }
+
+    /**
+     * Indique si la version AVX2 des noyaux doit être utilisée, le jeu
+     * d'instructions imposé à SimdCount bornant celui utilisé ici.
+     */
+    inline bool
+    avx2() {
+      return paralgos::SimdCount::isa() >= paralgos::SimdCount::AVX2;
+    }
+
+#endif
+
+  } // anonyme
+
+  /**********
+   * kernel *
+   **********/
+
+  void
+  BitonicMerge::kernel(const int32_t a[], const size_t& m,
+                       const int32_t b[], const size_t& n, int32_t result[]) {
+#ifdef BITONIC_MERGE_X86
+    if (avx2()) {
+      mergeAVX2< Reseau32< MinMaxI32 >, MinMaxI32 >(a, m, b, n, result);
+      return;
+    }
+#endif
+    std::merge(a, a + m, b, b + n, result);
+  }
+
+  void
+  BitonicMerge::kernel(const uint32_t a[], const size_t& m,
+                       const uint32_t b[], const size_t& n, uint32_t result[]) {
+#ifdef BITONIC_MERGE_X86
+    if (avx2()) {
+      mergeAVX2< Reseau32< MinMaxU32 >, MinMaxU32 >(a, m, b, n, result);
+      return;
+    }
+#endif
+    std::merge(a, a + m, b, b + n, result);
+  }
+
+  void
+  BitonicMerge::kernel(const int64_t a[], const size_t& m,
+                       const int64_t b[], const size_t& n, int64_t result[]) {
+#ifdef BITONIC_MERGE_X86
+    if (avx2()) {
+      mergeAVX2< Reseau64< MinMaxI64 >, MinMaxI64 >(a, m, b, n, result);
+      return;
+    }
+#endif
+    std::merge(a, a + m, b, b + n, result);
+  }
+
+  void
+  BitonicMerge::kernel(const uint64_t a[], const size_t& m,
+                       const uint64_t b[], const size_t& n, uint64_t result[]) {
+#ifdef BITONIC_MERGE_X86
+    if (avx2()) {
+      mergeAVX2< Reseau64< MinMaxU64 >, MinMaxU64 >(a, m, b, n, result);
+      return;
+    }
+#endif
+    std::merge(a, a + m, b, b + n, result);
+  }
+
+  void
+  BitonicMerge::kernel(const float a[], const size_t& m,
+                       const float b[], const size_t& n, float result[]) {
+#ifdef BITONIC_MERGE_X86
+    if (avx2()) {
+      mergeAVX2< Reseau32< MinMaxF32 >, MinMaxF32 >(a, m, b, n, result);
+      return;
+    }
+#endif
+    std::merge(a, a + m, b, b + n, result);
+  }
+
+  void
+  BitonicMerge::kernel(const double a[], const size_t& m,
+                       const double b[], const size_t& n, double result[]) {
+#ifdef BITONIC_MERGE_X86
+    if (avx2()) {
+      mergeAVX2< Reseau64< MinMaxF64 >, MinMaxF64 >(a, m, b, n, result);
+      return;
+    }
+#endif
+    std::merge(a, a + m, b, b + n, result);
+  }
+
+} // merging
@@ -0,0 +1,73 @@
+/*********************************************
+ * Définition de la classe ExecutionContext. *
+ *********************************************/
+
+#include "ExecutionContext.hpp"
+#include <omp.h>
+
+namespace paralgos {
+
+  /*********************
+   * DEFAULT_THRESHOLD *
+   *********************/
+
+  const size_t ExecutionContext::DEFAULT_THRESHOLD;
+
+  /********************
+   * ExecutionContext *
+   ********************/
+
+  ExecutionContext::ExecutionContext(const int& threads,
+                                     const size_t& threshold)
+    : threads_(threads > 0 ? threads : omp_get_max_threads()),
+      threshold_(threshold) {
+
+    // L'équipe doit conserver sa taille d'une région parallèle à l'autre.
+    omp_set_dynamic(0);
+
+    // Démarrage de l'équipe : ses threads sont ensuite conservés par le
+    // support d'exécution d'OpenMP.
+#pragma omp parallel num_threads(threads_)
+    {
+    }
+
+  }
+
+  /***********
+   * threads *
+   ***********/
+
+  const int&
+  ExecutionContext::threads() const {
+    return threads_;
+  }
+
+  /*************
+   * threshold *
+   *************/
+
+  const size_t&
+  ExecutionContext::threshold() const {
+    return threshold_;
+  }
+
+  /**************
+   * sequential *
+   **************/
+
+  bool
+  ExecutionContext::sequential(const size_t& n) const {
+    return threads_ == 1 || n < threshold_;
+  }
+
+  /************
+   * standard *
+   ************/
+
+  const ExecutionContext&
+  ExecutionContext::standard() {
+    static const ExecutionContext context;
+    return context;
+  }
+
+} // paralgos
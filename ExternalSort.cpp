@@ -0,0 +1,137 @@
+/***********************************************
+ * Définition de la classe ExternalSort::File. *
+ ***********************************************/
+
+#include "ExternalSort.hpp"
+#include <system_error>
+#include <vector>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace sorting {
+
+  const size_t ExternalSort::LEAF;
+  const size_t ExternalSort::CUTOFF;
+
+  /********
+   * File *
+   ********/
+
+  ExternalSort::File::File(const std::string& path, const Mode& mode)
+    : fd_(::open(path.c_str(),
+                 mode == READ ? O_RDONLY : O_WRONLY | O_CREAT | O_TRUNC,
+                 0644)),
+      path_(path) {
+    if (fd_ == -1) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+
+    // Simple indication : un échec n'empêche pas la lecture.
+    if (mode == READ) {
+      ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+  }
+
+  ExternalSort::File::File(File&& other)
+    : fd_(other.fd_), path_(std::move(other.path_)) {
+    other.fd_ = -1;
+  }
+
+  ExternalSort::File::File(const int& fd, const std::string& path)
+    : fd_(fd), path_(path) {
+  }
+
+  /*********
+   * ~File *
+   *********/
+
+  ExternalSort::File::~File() {
+    if (fd_ != -1) {
+      ::close(fd_);
+    }
+  }
+
+  /*************
+   * temporary *
+   *************/
+
+  ExternalSort::File
+  ExternalSort::File::temporary(const std::string& dir) {
+    const std::string modele = dir + "/ExternalSortXXXXXX";
+    std::vector< char > path(modele.begin(), modele.end());
+    path.push_back('\0');
+    const int fd = ::mkstemp(path.data());
+    if (fd == -1) {
+      throw std::system_error(errno, std::generic_category(), modele);
+    }
+
+    // Le fichier disparaîtra à la fermeture de son descripteur.
+    ::unlink(path.data());
+    return File(fd, path.data());
+  }
+
+  /********
+   * size *
+   ********/
+
+  size_t
+  ExternalSort::File::size() const {
+    struct stat infos;
+    if (::fstat(fd_, &infos) == -1) {
+      throw std::system_error(errno, std::generic_category(), path_);
+    }
+    return infos.st_size;
+  }
+
+  /********
+   * read *
+   ********/
+
+  size_t
+  ExternalSort::File::read(void* buf,
+                           const size_t& length,
+                           const size_t& offset) const {
+    char* const octets = static_cast< char* >(buf);
+    size_t lus = 0;
+    while (lus != length) {
+      const ssize_t r = ::pread(fd_, octets + lus, length - lus, offset + lus);
+      if (r == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(), path_);
+      }
+      if (r == 0) {
+        break;
+      }
+      lus += r;
+    }
+    return lus;
+  }
+
+  /*********
+   * write *
+   *********/
+
+  void
+  ExternalSort::File::write(const void* buf,
+                            const size_t& length,
+                            const size_t& offset) const {
+    const char* const octets = static_cast< const char* >(buf);
+    size_t ecrits = 0;
+    while (ecrits != length) {
+      const ssize_t r = ::pwrite(fd_, octets + ecrits, length - ecrits,
+                                 offset + ecrits);
+      if (r == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(), path_);
+      }
+      ecrits += r;
+    }
+  }
+
+} // sorting
@@ -0,0 +1,125 @@
+/***********************************************
+ * Définition de la classe FileCount::Mapping. *
+ ***********************************************/
+
+#include "FileCount.hpp"
+#include <system_error>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace paralgos {
+
+  namespace {
+
+    /**
+     * Taille visée pour un tronçon (quelques mégaoctets : assez pour amortir
+     * la répartition dynamique, assez peu pour équilibrer la charge).
+     */
+    const size_t TRONCON = 4 * 1024 * 1024;
+
+    /**
+     * Calcule le plus grand commun diviseur de deux entiers.
+     */
+    size_t
+    pgcd(size_t a, size_t b) {
+      while (b != 0) {
+        const size_t r = a % b;
+        a = b;
+        b = r;
+      }
+      return a;
+    }
+
+  } // anonyme
+
+  /***********
+   * Mapping *
+   ***********/
+
+  FileCount::Mapping::Mapping(const std::string& path)
+    : data_(nullptr), size_(0) {
+
+    // Ouverture du fichier et obtention de sa taille.
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+    struct stat infos;
+    if (::fstat(fd, &infos) == -1) {
+      const int erreur = errno;
+      ::close(fd);
+      throw std::system_error(erreur, std::generic_category(), path);
+    }
+    size_ = infos.st_size;
+
+    // Un fichier vide ne peut être projeté.
+    if (size_ != 0) {
+      data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data_ == MAP_FAILED) {
+        const int erreur = errno;
+        ::close(fd);
+        throw std::system_error(erreur, std::generic_category(), path);
+      }
+
+      // Simple indication : un échec n'empêche pas la lecture.
+      ::madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+
+    // La projection survit à la fermeture du descripteur.
+    ::close(fd);
+
+  }
+
+  /************
+   * ~Mapping *
+   ************/
+
+  FileCount::Mapping::~Mapping() {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+  }
+
+  /********
+   * data *
+   ********/
+
+  const void*
+  FileCount::Mapping::data() const {
+    return data_;
+  }
+
+  /********
+   * size *
+   ********/
+
+  const size_t&
+  FileCount::Mapping::size() const {
+    return size_;
+  }
+
+  /*********
+   * chunk *
+   *********/
+
+  size_t
+  FileCount::Mapping::chunk(const size_t& record) const {
+    const size_t page = ::sysconf(_SC_PAGESIZE);
+    const size_t ppcm = page / pgcd(page, record) * record;
+    return ppcm * std::max< size_t >(1, TRONCON / ppcm);
+  }
+
+  /************
+   * willNeed *
+   ************/
+
+  void
+  FileCount::Mapping::willNeed(const size_t& offset,
+                               const size_t& length) const {
+    ::madvise(static_cast< char* >(data_) + offset, length, MADV_WILLNEED);
+  }
+
+} // paralgos
@@ -0,0 +1,711 @@
+/**************************************
+ * Définition de la classe SimdCount. *
+ **************************************/
+
+#include "SimdCount.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_COUNT_X86
+#include <immintrin.h>
+#include <cpuid.h>
+#endif
+
+namespace paralgos {
+
+  // Le jeu d'instructions est déterminé une fois pour toutes au chargement du
+  // programme. SCALAR valant 0, une utilisation avant cette initialisation
+  // reste correcte.
+  SimdCount::Isa SimdCount::active = SimdCount::detect();
+
+  namespace {
+
+    /**
+     * Version scalaire du noyau.
+     */
+    template< typename W >
+    size_t
+    countScalar(const W x[], const size_t& n, const W& val) {
+      size_t acc = 0;
+      for (size_t i = 0; i != n; i ++) {
+        acc += x[i] == val;
+      }
+      return acc;
+    }
+
+    /**
+     * Version scalaire du noyau multi-valeurs.
+     */
+    template< typename W >
+    void
+    batchScalar(const W x[],
+                const size_t& n,
+                const W vals[],
+                const size_t& nvals,
+                size_t counts[]) {
+      for (size_t i = 0; i != n; i ++) {
+        for (size_t q = 0; q != nvals; q ++) {
+          counts[q] += x[i] == vals[q];
+        }
+      }
+    }
+
+    /**
+     * Taille, en octets, des blocs de données traités par les noyaux
+     * multi-valeurs : chaque bloc, chargé une fois depuis la mémoire, est
+     * relu depuis le cache L1 pour chaque groupe de valeurs recherchées.
+     */
+    const size_t BLOC = 4096;
+
+    /**
+     * Nombre de valeurs recherchées simultanément (une par registre) par les
+     * noyaux multi-valeurs SSE2 et AVX2.
+     */
+    const size_t GROUPE = 4;
+
+#ifdef SIMD_COUNT_X86
+
+    /**
+     * Comparaisons SSE2 : chaque voie égale est mise à 1 bit à bit.
+     */
+    __attribute__((target("sse2"))) inline __m128i
+    eqSSE2(const __m128i& a, const __m128i& b, const uint8_t&) {
+      return _mm_cmpeq_epi8(a, b);
+    }
+
+    __attribute__((target("sse2"))) inline __m128i
+    eqSSE2(const __m128i& a, const __m128i& b, const uint16_t&) {
+      return _mm_cmpeq_epi16(a, b);
+    }
+
+    __attribute__((target("sse2"))) inline __m128i
+    eqSSE2(const __m128i& a, const __m128i& b, const uint32_t&) {
+      return _mm_cmpeq_epi32(a, b);
+    }
+
+    // SSE2 ne dispose pas de comparaison d'entiers 64 bits : les deux moitiés
+    // 32 bits de chaque voie doivent être égales.
+    __attribute__((target("sse2"))) inline __m128i
+    eqSSE2(const __m128i& a, const __m128i& b, const uint64_t&) {
+      const __m128i eq = _mm_cmpeq_epi32(a, b);
+      return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    __attribute__((target("sse2"))) inline __m128i
+    eqSSE2(const __m128i& a, const __m128i& b, const float&) {
+      return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a),
+                                           _mm_castsi128_ps(b)));
+    }
+
+    __attribute__((target("sse2"))) inline __m128i
+    eqSSE2(const __m128i& a, const __m128i& b, const double&) {
+      return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a),
+                                           _mm_castsi128_pd(b)));
+    }
+
+    /**
+     * Soustractions SSE2 voie à voie (une voie égale valant -1, la soustraire
+     * incrémente le compteur de la voie).
+     */
+    __attribute__((target("sse2"))) inline __m128i
+    subSSE2(const __m128i& a, const __m128i& b, const uint8_t&) {
+      return _mm_sub_epi8(a, b);
+    }
+
+    __attribute__((target("sse2"))) inline __m128i
+    subSSE2(const __m128i& a, const __m128i& b, const uint16_t&) {
+      return _mm_sub_epi16(a, b);
+    }
+
+    __attribute__((target("sse2"))) inline __m128i
+    subSSE2(const __m128i& a, const __m128i& b, const uint32_t&) {
+      return _mm_sub_epi32(a, b);
+    }
+
+    __attribute__((target("sse2"))) inline __m128i
+    subSSE2(const __m128i& a, const __m128i& b, const uint64_t&) {
+      return _mm_sub_epi64(a, b);
+    }
+
+    __attribute__((target("sse2"))) inline __m128i
+    subSSE2(const __m128i& a, const __m128i& b, const float&) {
+      return _mm_sub_epi32(a, b);
+    }
+
+    __attribute__((target("sse2"))) inline __m128i
+    subSSE2(const __m128i& a, const __m128i& b, const double&) {
+      return _mm_sub_epi64(a, b);
+    }
+
+    /**
+     * Nombre maximal d'itérations avant débordement des compteurs d'une voie
+     * de sizeof(W) octets.
+     */
+    template< typename W >
+    inline size_t
+    limit() {
+      return sizeof(W) == 1 ? 0xFF : sizeof(W) == 2 ? 0xFFFF : 0x7FFFFFFF;
+    }
+
+    /**
+     * Somme les compteurs stockés dans les voies d'un registre (un compteur
+     * est un entier non signé de sizeof(W) octets).
+     */
+    template< typename W, size_t lanes >
+    inline size_t
+    reduce(const void* acc) {
+      typedef typename std::conditional<
+        sizeof(W) == 1, uint8_t, typename std::conditional<
+          sizeof(W) == 2, uint16_t, typename std::conditional<
+            sizeof(W) == 4, uint32_t, uint64_t >::type >::type >::type Int;
+      const Int* counters = static_cast< const Int* >(acc);
+      size_t sum = 0;
+      for (size_t l = 0; l != lanes; l ++) {
+        sum += counters[l];
+      }
+      return sum;
+    }
+
+    /**
+     * Version SSE2 du noyau : chaque voie dispose de son propre compteur,
+     * vidé avant débordement.
+     */
+    template< typename W >
+    __attribute__((target("sse2"))) size_t
+    countSSE2(const W x[], const size_t& n, const W& val) {
+      const size_t lanes = sizeof(__m128i) / sizeof(W);
+      W vals[lanes];
+      for (size_t l = 0; l != lanes; l ++) {
+        vals[l] = val;
+      }
+      const __m128i pk_val =
+        _mm_loadu_si128(reinterpret_cast< const __m128i* >(vals));
+      size_t acc = 0, i = 0;
+      while (i + lanes <= n) {
+        const size_t stop = std::min(n - (n - i) % lanes,
+                                     i + limit< W >() * lanes);
+        __m128i pk_acc = _mm_setzero_si128();
+        for (; i != stop; i += lanes) {
+          const __m128i pk =
+            _mm_loadu_si128(reinterpret_cast< const __m128i* >(x + i));
+          pk_acc = subSSE2(pk_acc, eqSSE2(pk, pk_val, val), val);
+        }
+        alignas(16) W counters[lanes];
+        _mm_store_si128(reinterpret_cast< __m128i* >(counters), pk_acc);
+        acc += reduce< W, lanes >(counters);
+      }
+      return acc + countScalar(x + i, n - i, val);
+    }
+
+    /**
+     * Version SSE2 du noyau multi-valeurs : les valeurs recherchées sont
+     * diffusées par groupes de GROUPE dans des registres, et chacune dispose
+     * de ses propres compteurs voie à voie.
+     */
+    template< typename W >
+    __attribute__((target("sse2"))) void
+    batchSSE2(const W x[],
+              const size_t& n,
+              const W vals[],
+              const size_t& nvals,
+              size_t counts[]) {
+      const size_t lanes = sizeof(__m128i) / sizeof(W);
+      const size_t bloc =
+        std::min(limit< W >(), BLOC / sizeof(__m128i)) * lanes;
+      size_t i = 0;
+      while (i + lanes <= n) {
+        const size_t stop = std::min(n - (n - i) % lanes, i + bloc);
+        for (size_t q = 0; q < nvals; q += GROUPE) {
+          __m128i pk_val[GROUPE], pk_acc[GROUPE];
+          for (size_t g = 0; g != GROUPE; g ++) {
+            W diffusion[lanes];
+            for (size_t l = 0; l != lanes; l ++) {
+              diffusion[l] = vals[std::min(q + g, nvals - 1)];
+            }
+            pk_val[g] =
+              _mm_loadu_si128(reinterpret_cast< const __m128i* >(diffusion));
+            pk_acc[g] = _mm_setzero_si128();
+          }
+          for (size_t k = i; k != stop; k += lanes) {
+            const __m128i pk =
+              _mm_loadu_si128(reinterpret_cast< const __m128i* >(x + k));
+            for (size_t g = 0; g != GROUPE; g ++) {
+              pk_acc[g] = subSSE2(pk_acc[g], eqSSE2(pk, pk_val[g], *x), *x);
+            }
+          }
+          for (size_t g = 0; g != GROUPE && q + g != nvals; g ++) {
+            alignas(16) W counters[lanes];
+            _mm_store_si128(reinterpret_cast< __m128i* >(counters), pk_acc[g]);
+            counts[q + g] += reduce< W, lanes >(counters);
+          }
+        }
+        i = stop;
+      }
+      batchScalar(x + i, n - i, vals, nvals, counts);
+    }
+
+    /**
+     * Comparaisons AVX2.
+     */
+    __attribute__((target("avx2"))) inline __m256i
+    eqAVX2(const __m256i& a, const __m256i& b, const uint8_t&) {
+      return _mm256_cmpeq_epi8(a, b);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    eqAVX2(const __m256i& a, const __m256i& b, const uint16_t&) {
+      return _mm256_cmpeq_epi16(a, b);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    eqAVX2(const __m256i& a, const __m256i& b, const uint32_t&) {
+      return _mm256_cmpeq_epi32(a, b);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    eqAVX2(const __m256i& a, const __m256i& b, const uint64_t&) {
+      return _mm256_cmpeq_epi64(a, b);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    eqAVX2(const __m256i& a, const __m256i& b, const float&) {
+      return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a),
+                                               _mm256_castsi256_ps(b),
+                                               _CMP_EQ_OQ));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    eqAVX2(const __m256i& a, const __m256i& b, const double&) {
+      return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a),
+                                               _mm256_castsi256_pd(b),
+                                               _CMP_EQ_OQ));
+    }
+
+    /**
+     * Soustractions AVX2 voie à voie.
+     */
+    __attribute__((target("avx2"))) inline __m256i
+    subAVX2(const __m256i& a, const __m256i& b, const uint8_t&) {
+      return _mm256_sub_epi8(a, b);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    subAVX2(const __m256i& a, const __m256i& b, const uint16_t&) {
+      return _mm256_sub_epi16(a, b);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    subAVX2(const __m256i& a, const __m256i& b, const uint32_t&) {
+      return _mm256_sub_epi32(a, b);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    subAVX2(const __m256i& a, const __m256i& b, const uint64_t&) {
+      return _mm256_sub_epi64(a, b);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    subAVX2(const __m256i& a, const __m256i& b, const float&) {
+      return _mm256_sub_epi32(a, b);
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    subAVX2(const __m256i& a, const __m256i& b, const double&) {
+      return _mm256_sub_epi64(a, b);
+    }
+
+    /**
+     * Version AVX2 du noyau.
+     */
+    template< typename W >
+    __attribute__((target("avx2"))) size_t
+    countAVX2(const W x[], const size_t& n, const W& val) {
+      const size_t lanes = sizeof(__m256i) / sizeof(W);
+      W vals[lanes];
+      for (size_t l = 0; l != lanes; l ++) {
+        vals[l] = val;
+      }
+      const __m256i pk_val =
+        _mm256_loadu_si256(reinterpret_cast< const __m256i* >(vals));
+      size_t acc = 0, i = 0;
+      while (i + lanes <= n) {
+        const size_t stop = std::min(n - (n - i) % lanes,
+                                     i + limit< W >() * lanes);
+        __m256i pk_acc = _mm256_setzero_si256();
+        for (; i != stop; i += lanes) {
+          const __m256i pk =
+            _mm256_loadu_si256(reinterpret_cast< const __m256i* >(x + i));
+          pk_acc = subAVX2(pk_acc, eqAVX2(pk, pk_val, val), val);
+        }
+        alignas(32) W counters[lanes];
+        _mm256_store_si256(reinterpret_cast< __m256i* >(counters), pk_acc);
+        acc += reduce< W, lanes >(counters);
+      }
+      return acc + countScalar(x + i, n - i, val);
+    }
+
+    /**
+     * Version AVX2 du noyau multi-valeurs.
+     */
+    template< typename W >
+    __attribute__((target("avx2"))) void
+    batchAVX2(const W x[],
+              const size_t& n,
+              const W vals[],
+              const size_t& nvals,
+              size_t counts[]) {
+      const size_t lanes = sizeof(__m256i) / sizeof(W);
+      const size_t bloc =
+        std::min(limit< W >(), BLOC / sizeof(__m256i)) * lanes;
+      size_t i = 0;
+      while (i + lanes <= n) {
+        const size_t stop = std::min(n - (n - i) % lanes, i + bloc);
+        for (size_t q = 0; q < nvals; q += GROUPE) {
+          __m256i pk_val[GROUPE], pk_acc[GROUPE];
+          for (size_t g = 0; g != GROUPE; g ++) {
+            W diffusion[lanes];
+            for (size_t l = 0; l != lanes; l ++) {
+              diffusion[l] = vals[std::min(q + g, nvals - 1)];
+            }
+            pk_val[g] =
+              _mm256_loadu_si256(reinterpret_cast< const __m256i* >(diffusion));
+            pk_acc[g] = _mm256_setzero_si256();
+          }
+          for (size_t k = i; k != stop; k += lanes) {
+            const __m256i pk =
+              _mm256_loadu_si256(reinterpret_cast< const __m256i* >(x + k));
+            for (size_t g = 0; g != GROUPE; g ++) {
+              pk_acc[g] = subAVX2(pk_acc[g], eqAVX2(pk, pk_val[g], *x), *x);
+            }
+          }
+          for (size_t g = 0; g != GROUPE && q + g != nvals; g ++) {
+            alignas(32) W counters[lanes];
+            _mm256_store_si256(reinterpret_cast< __m256i* >(counters),
+                               pk_acc[g]);
+            counts[q + g] += reduce< W, lanes >(counters);
+          }
+        }
+        i = stop;
+      }
+      batchScalar(x + i, n - i, vals, nvals, counts);
+    }
+
+    /**
+     * Comparaisons AVX-512 : le résultat est directement un masque comportant
+     * un bit par voie.
+     */
+    __attribute__((target("avx512f,avx512bw"))) inline uint64_t
+    eqAVX512(const __m512i& a, const __m512i& b, const uint8_t&) {
+      return _mm512_cmpeq_epi8_mask(a, b);
+    }
+
+    __attribute__((target("avx512f,avx512bw"))) inline uint64_t
+    eqAVX512(const __m512i& a, const __m512i& b, const uint16_t&) {
+      return _mm512_cmpeq_epi16_mask(a, b);
+    }
+
+    __attribute__((target("avx512f,avx512bw"))) inline uint64_t
+    eqAVX512(const __m512i& a, const __m512i& b, const uint32_t&) {
+      return _mm512_cmpeq_epi32_mask(a, b);
+    }
+
+    __attribute__((target("avx512f,avx512bw"))) inline uint64_t
+    eqAVX512(const __m512i& a, const __m512i& b, const uint64_t&) {
+      return _mm512_cmpeq_epi64_mask(a, b);
+    }
+
+    __attribute__((target("avx512f,avx512bw"))) inline uint64_t
+    eqAVX512(const __m512i& a, const __m512i& b, const float&) {
+      return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a),
+                                _mm512_castsi512_ps(b),
+                                _CMP_EQ_OQ);
+    }
+
+    __attribute__((target("avx512f,avx512bw"))) inline uint64_t
+    eqAVX512(const __m512i& a, const __m512i& b, const double&) {
+      return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a),
+                                _mm512_castsi512_pd(b),
+                                _CMP_EQ_OQ);
+    }
+
+    /**
+     * Version AVX-512 du noyau.
+     */
+    template< typename W >
+    __attribute__((target("avx512f,avx512bw,popcnt"))) size_t
+    countAVX512(const W x[], const size_t& n, const W& val) {
+      const size_t lanes = sizeof(__m512i) / sizeof(W);
+      W vals[lanes];
+      for (size_t l = 0; l != lanes; l ++) {
+        vals[l] = val;
+      }
+      const __m512i pk_val = _mm512_loadu_si512(vals);
+      size_t acc = 0, i = 0;
+      for (; i + lanes <= n; i += lanes) {
+        const __m512i pk = _mm512_loadu_si512(x + i);
+        acc += __builtin_popcountll(eqAVX512(pk, pk_val, val));
+      }
+      return acc + countScalar(x + i, n - i, val);
+    }
+
+    /**
+     * Version AVX-512 du noyau multi-valeurs : les masques de comparaison de
+     * chaque valeur recherchée sont comptés via popcount.
+     */
+    template< typename W >
+    __attribute__((target("avx512f,avx512bw,popcnt"))) void
+    batchAVX512(const W x[],
+                const size_t& n,
+                const W vals[],
+                const size_t& nvals,
+                size_t counts[]) {
+      const size_t lanes = sizeof(__m512i) / sizeof(W);
+      const size_t groupe = 2 * GROUPE;
+      const size_t bloc = BLOC / sizeof(W);
+      size_t i = 0;
+      while (i + lanes <= n) {
+        const size_t stop = std::min(n - (n - i) % lanes, i + bloc);
+        for (size_t q = 0; q < nvals; q += groupe) {
+          __m512i pk_val[groupe];
+          size_t acc[groupe] = {};
+          for (size_t g = 0; g != groupe; g ++) {
+            W diffusion[lanes];
+            for (size_t l = 0; l != lanes; l ++) {
+              diffusion[l] = vals[std::min(q + g, nvals - 1)];
+            }
+            pk_val[g] = _mm512_loadu_si512(diffusion);
+          }
+          for (size_t k = i; k != stop; k += lanes) {
+            const __m512i pk = _mm512_loadu_si512(x + k);
+            for (size_t g = 0; g != groupe; g ++) {
+              acc[g] += __builtin_popcountll(eqAVX512(pk, pk_val[g], *x));
+            }
+          }
+          for (size_t g = 0; g != groupe && q + g != nvals; g ++) {
+            counts[q + g] += acc[g];
+          }
+        }
+        i = stop;
+      }
+      batchScalar(x + i, n - i, vals, nvals, counts);
+    }
+
+#endif
+
+    /**
+     * Aiguillage vers la version du noyau correspondant au jeu d'instructions
+     * courant.
+     */
+    template< typename W >
+    size_t
+    count(const W x[], const size_t& n, const W& val, const SimdCount::Isa& isa) {
+      switch (isa) {
+#ifdef SIMD_COUNT_X86
+      case SimdCount::AVX512:
+        return countAVX512(x, n, val);
+      case SimdCount::AVX2:
+        return countAVX2(x, n, val);
+      case SimdCount::SSE2:
+        return countSSE2(x, n, val);
+#endif
+      default:
+        return countScalar(x, n, val);
+      }
+    }
+
+    /**
+     * Aiguillage vers la version du noyau multi-valeurs correspondant au jeu
+     * d'instructions courant.
+     */
+    template< typename W >
+    void
+    batch(const W x[],
+          const size_t& n,
+          const W vals[],
+          const size_t& nvals,
+          size_t counts[],
+          const SimdCount::Isa& isa) {
+      if (nvals == 0) {
+        return;
+      }
+      switch (isa) {
+#ifdef SIMD_COUNT_X86
+      case SimdCount::AVX512:
+        batchAVX512(x, n, vals, nvals, counts);
+        break;
+      case SimdCount::AVX2:
+        batchAVX2(x, n, vals, nvals, counts);
+        break;
+      case SimdCount::SSE2:
+        batchSSE2(x, n, vals, nvals, counts);
+        break;
+#endif
+      default:
+        batchScalar(x, n, vals, nvals, counts);
+      }
+    }
+
+  } // anonyme
+
+  /**********
+   * detect *
+   **********/
+
+  SimdCount::Isa
+  SimdCount::detect() {
+#ifdef SIMD_COUNT_X86
+    unsigned eax, ebx, ecx, edx;
+    if (! __get_cpuid(1, &eax, &ebx, &ecx, &edx) || ! (edx & bit_SSE2)) {
+      return SCALAR;
+    }
+
+    // Les registres AVX doivent être sauvegardés par le système
+    // d'exploitation (bits 1 et 2 de XCR0, plus 5 à 7 pour AVX-512).
+    if (! (ecx & bit_OSXSAVE) || ! (ecx & bit_AVX)) {
+      return SSE2;
+    }
+    unsigned xcr0, xcr0h;
+    __asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0h) : "c" (0));
+    if ((xcr0 & 0x06) != 0x06
+        || ! __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)
+        || ! (ebx & bit_AVX2)) {
+      return SSE2;
+    }
+    if ((xcr0 & 0xE6) == 0xE6
+        && (ebx & bit_AVX512F)
+        && (ebx & bit_AVX512BW)) {
+      return AVX512;
+    }
+    return AVX2;
+#else
+    return SCALAR;
+#endif
+  }
+
+  /*******
+   * isa *
+   *******/
+
+  SimdCount::Isa
+  SimdCount::isa() {
+    return active;
+  }
+
+  /**********
+   * setIsa *
+   **********/
+
+  SimdCount::Isa
+  SimdCount::setIsa(const Isa& isa) {
+    const Isa best = detect();
+    active = isa < best ? isa : best;
+    return active;
+  }
+
+  /********
+   * name *
+   ********/
+
+  const char*
+  SimdCount::name(const Isa& isa) {
+    switch (isa) {
+    case SSE2:
+      return "SSE2";
+    case AVX2:
+      return "AVX2";
+    case AVX512:
+      return "AVX-512";
+    default:
+      return "scalaire";
+    }
+  }
+
+  /**********
+   * kernel *
+   **********/
+
+  size_t
+  SimdCount::kernel(const uint8_t x[], const size_t& n, const uint8_t& val) {
+    return count(x, n, val, active);
+  }
+
+  size_t
+  SimdCount::kernel(const uint16_t x[], const size_t& n, const uint16_t& val) {
+    return count(x, n, val, active);
+  }
+
+  size_t
+  SimdCount::kernel(const uint32_t x[], const size_t& n, const uint32_t& val) {
+    return count(x, n, val, active);
+  }
+
+  size_t
+  SimdCount::kernel(const uint64_t x[], const size_t& n, const uint64_t& val) {
+    return count(x, n, val, active);
+  }
+
+  size_t
+  SimdCount::kernel(const float x[], const size_t& n, const float& val) {
+    return count(x, n, val, active);
+  }
+
+  size_t
+  SimdCount::kernel(const double x[], const size_t& n, const double& val) {
+    return count(x, n, val, active);
+  }
+
+  void
+  SimdCount::kernel(const uint8_t x[],
+                    const size_t& n,
+                    const uint8_t vals[],
+                    const size_t& nvals,
+                    size_t counts[]) {
+    batch(x, n, vals, nvals, counts, active);
+  }
+
+  void
+  SimdCount::kernel(const uint16_t x[],
+                    const size_t& n,
+                    const uint16_t vals[],
+                    const size_t& nvals,
+                    size_t counts[]) {
+    batch(x, n, vals, nvals, counts, active);
+  }
+
+  void
+  SimdCount::kernel(const uint32_t x[],
+                    const size_t& n,
+                    const uint32_t vals[],
+                    const size_t& nvals,
+                    size_t counts[]) {
+    batch(x, n, vals, nvals, counts, active);
+  }
+
+  void
+  SimdCount::kernel(const uint64_t x[],
+                    const size_t& n,
+                    const uint64_t vals[],
+                    const size_t& nvals,
+                    size_t counts[]) {
+    batch(x, n, vals, nvals, counts, active);
+  }
+
+  void
+  SimdCount::kernel(const float x[],
+                    const size_t& n,
+                    const float vals[],
+                    const size_t& nvals,
+                    size_t counts[]) {
+    batch(x, n, vals, nvals, counts, active);
+  }
+
+  void
+  SimdCount::kernel(const double x[],
+                    const size_t& n,
+                    const double vals[],
+                    const size_t& nvals,
+                    size_t counts[]) {
+    batch(x, n, vals, nvals, counts, active);
+  }
+
+} // paralgos
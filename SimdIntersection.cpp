@@ -0,0 +1,182 @@
+/*********************************************
+ * Définition de la classe SimdIntersection. *
+ *********************************************/
+
+#include "SimdIntersection.hpp"
+#include "SimdCount.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_INTERSECTION_X86
+#include <immintrin.h>
+#endif
+
+namespace merging {
+
+  namespace {
+
+    /**
+     * Version scalaire du noyau : celle de l'algorithme set_intersection,
+     * l'intersection n'étant recopiée que si @c Ecrire vaut @c true.
+     */
+    template< bool Ecrire, typename W >
+    size_t
+    intersectScalar(const W a[], const size_t& m,
+                    const W b[], const size_t& n,
+                    W result[]) {
+      size_t i = 0, j = 0, c = 0;
+      while (i < m && j < n) {
+        if (a[i] < b[j]) {
+          i ++;
+        } else if (b[j] < a[i]) {
+          j ++;
+        } else {
+          if (Ecrire) {
+            result[c] = a[i];
+          }
+          c ++;
+          i ++;
+          j ++;
+        }
+      }
+      return c;
+    }
+
+    /**
+     * Comparaisons AVX2 d'entiers de 32 bits : AVX2 ne comparant que des
+     * entiers signés, le bit de poids fort des entiers non signés est
+     * inversé au préalable.
+     */
+    struct BiaisI32 {
+#ifdef SIMD_INTERSECTION_X86
+      __attribute__((target("avx2"))) static inline __m256i
+      apply(const __m256i& x) {
+        return x;
+      }
+#endif
+    };
+
+    struct BiaisU32 {
+#ifdef SIMD_INTERSECTION_X86
+      __attribute__((target("avx2"))) static inline __m256i
+      apply(const __m256i& x) {
+        return _mm256_xor_si256(x, _mm256_set1_epi32(INT32_MIN));
+      }
+#endif
+    };
+
+#ifdef SIMD_INTERSECTION_X86
+
+    /**
+     * Saute les éléments d'une suite inférieurs à une valeur, huit par huit
+     * tant que possible : la suite étant ordonnée, les voies inférieures à
+     * la valeur forment un préfixe du registre, dont la longueur est le
+     * nombre de voies inférieures.
+     *
+     * @param[in] t la suite.
+     * @param[in] i le rang de l'élément de tête.
+     * @param[in] m le nombre d'éléments de la suite.
+     * @param[in] v la valeur.
+     * @return le rang du premier élément supérieur ou égal à v.
+     */
+    template< typename B, typename W >
+    __attribute__((target("avx2"))) inline size_t
+    sauterAVX2(const W t[], size_t i, const size_t& m, const W& v) {
+      const __m256i pivot = B::apply(_mm256_set1_epi32(v));
+      while (i + 8 <= m) {
+        const __m256i x =
+          B::apply(_mm256_loadu_si256(reinterpret_cast< const __m256i* >(t + i)));
+        const int masque =
+          _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, x)));
+        const size_t inferieurs = __builtin_popcount(masque);
+        i += inferieurs;
+        if (inferieurs < 8) {
+          return i;
+        }
+      }
+      while (i < m && t[i] < v) {
+        i ++;
+      }
+      return i;
+    }
+
+    /**
+     * Version AVX2 du noyau : les éléments égaux sont appariés un à un, les
+     * autres sont sautés par sauterAVX2.
+     */
+    template< bool Ecrire, typename B, typename W >
+    __attribute__((target("avx2"))) size_t
+    intersectAVX2(const W a[], const size_t& m,
+                  const W b[], const size_t& n,
+                  W result[]) {
+      size_t i = 0, j = 0, c = 0;
+      while (i < m && j < n) {
+        const W x = a[i], y = b[j];
+        if (x < y) {
+          i = sauterAVX2< B >(a, i + 1, m, y);
+        } else if (y < x) {
+          j = sauterAVX2< B >(b, j + 1, n, x);
+        } else {
+          if (Ecrire) {
+            result[c] = x;
+          }
+          c ++;
+          i ++;
+          j ++;
+        }
+      }
+      return c;
+    }
+
+    /**
+     * Indique si la version AVX2 des noyaux doit être utilisée, le jeu
+     * d'instructions imposé à SimdCount bornant celui utilisé ici.
+     */
+    inline bool
+    avx2() {
+      return paralgos::SimdCount::isa() >= paralgos::SimdCount::AVX2;
+    }
+
+#endif
+
+    /**
+     * Choix de la version du noyau.
+     */
+    template< typename B, typename W >
+    size_t
+    noyau(const W a[], const size_t& m,
+          const W b[], const size_t& n,
+          W result[]) {
+#ifdef SIMD_INTERSECTION_X86
+      if (avx2()) {
+        return result
+          ? intersectAVX2< true, B >(a, m, b, n, result)
+          : intersectAVX2< false, B >(a, m, b, n, result);
+      }
+#endif
+      return result
+        ? intersectScalar< true >(a, m, b, n, result)
+        : intersectScalar< false >(a, m, b, n, result);
+    }
+
+  } // anonyme
+
+  /**********
+   * kernel *
+   **********/
+
+  size_t
+  SimdIntersection::kernel(const int32_t a[], const size_t& m,
+                           const int32_t b[], const size_t& n,
+                           int32_t result[]) {
+    return noyau< BiaisI32 >(a, m, b, n, result);
+  }
+
+  size_t
+  SimdIntersection::kernel(const uint32_t a[], const size_t& m,
+                           const uint32_t b[], const size_t& n,
+                           uint32_t result[]) {
+    return noyau< BiaisU32 >(a, m, b, n, result);
+  }
+
+} // merging
@@ -0,0 +1,194 @@
+/***********************************************
+ * Définition de la classe ThreadPoolExecutor. *
+ ***********************************************/
+
+#include "ThreadPoolExecutor.hpp"
+#include <algorithm>
+
+namespace merging {
+
+  thread_local const ThreadPoolExecutor* ThreadPoolExecutor::pool_ = nullptr;
+  thread_local int ThreadPoolExecutor::courant_ = -1;
+
+  /**********************
+   * ThreadPoolExecutor *
+   **********************/
+
+  ThreadPoolExecutor::ThreadPoolExecutor(const int& threads)
+    : threads_(threads > 0
+               ? threads
+               : std::max(1, static_cast< int >(
+                   std::thread::hardware_concurrency()))),
+      enAttente_(0),
+      arret_(false) {
+    for (int i = 0; i <= threads_; i ++) {
+      files_.emplace_back(new File());
+    }
+    for (int i = 0; i != threads_; i ++) {
+      ouvriers_.emplace_back(&ThreadPoolExecutor::boucle, this, i);
+    }
+  }
+
+  /***********************
+   * ~ThreadPoolExecutor *
+   ***********************/
+
+  ThreadPoolExecutor::~ThreadPoolExecutor() {
+    {
+      std::lock_guard< std::mutex > verrou(mutex_);
+      arret_ = true;
+    }
+    travail_.notify_all();
+    for (std::thread& ouvrier : ouvriers_) {
+      ouvrier.join();
+    }
+  }
+
+  /***************
+   * concurrency *
+   ***************/
+
+  const int&
+  ThreadPoolExecutor::concurrency() const {
+    return threads_;
+  }
+
+  /********
+   * push *
+   ********/
+
+  void
+  ThreadPoolExecutor::push(Tache* tache, const int& file) const {
+    {
+      std::lock_guard< std::mutex > verrou(files_[file]->verrou);
+      files_[file]->taches.push_back(tache);
+    }
+    enAttente_ ++;
+
+    // Prendre le verrou garantit qu'un ouvrier ayant constaté l'absence de
+    // tâches est bien endormi avant d'être réveillé.
+    {
+      std::lock_guard< std::mutex > verrou(mutex_);
+    }
+    travail_.notify_one();
+  }
+
+  /*************
+   * reprendre *
+   *************/
+
+  bool
+  ThreadPoolExecutor::reprendre(Tache* tache) const {
+    File& file = *files_[courant_];
+    std::lock_guard< std::mutex > verrou(file.verrou);
+    if (file.taches.empty() || file.taches.back() != tache) {
+      return false;
+    }
+    file.taches.pop_back();
+    enAttente_ --;
+    return true;
+  }
+
+  /*******
+   * pop *
+   *******/
+
+  ThreadPoolExecutor::Tache*
+  ThreadPoolExecutor::pop(const int& file) const {
+    File& f = *files_[file];
+    std::lock_guard< std::mutex > verrou(f.verrou);
+    if (f.taches.empty()) {
+      return nullptr;
+    }
+    Tache* const tache = f.taches.back();
+    f.taches.pop_back();
+    enAttente_ --;
+    return tache;
+  }
+
+  /*********
+   * steal *
+   *********/
+
+  ThreadPoolExecutor::Tache*
+  ThreadPoolExecutor::steal() const {
+    const int n = threads_ + 1;
+    for (int k = 1; k != n; k ++) {
+      File& f = *files_[(courant_ + k) % n];
+      std::lock_guard< std::mutex > verrou(f.verrou);
+      if (! f.taches.empty()) {
+        Tache* const tache = f.taches.front();
+        f.taches.pop_front();
+        enAttente_ --;
+        return tache;
+      }
+    }
+    return nullptr;
+  }
+
+  /***********
+   * execute *
+   ***********/
+
+  void
+  ThreadPoolExecutor::execute(Tache* tache) const {
+    tache->corps();
+
+    // Une fois la tâche terminée, celui qui l'attend peut la détruire : elle
+    // ne doit plus être manipulée.
+    if (tache->externe) {
+      {
+        std::lock_guard< std::mutex > verrou(mutex_);
+        tache->terminee = true;
+      }
+      fin_.notify_all();
+    } else {
+      tache->terminee.store(true, std::memory_order_release);
+    }
+  }
+
+  /************
+   * attendre *
+   ************/
+
+  void
+  ThreadPoolExecutor::attendre(const Tache& tache) const {
+
+    // La file de l'ouvrier courant ne contient que des tâches empilées par
+    // ses appelants : seules les tâches des autres sont exécutées.
+    while (! tache.terminee.load(std::memory_order_acquire)) {
+      Tache* const autre = steal();
+      if (autre) {
+        execute(autre);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /**********
+   * boucle *
+   **********/
+
+  void
+  ThreadPoolExecutor::boucle(const int& id) {
+    pool_ = this;
+    courant_ = id;
+    for (;;) {
+      Tache* tache = pop(id);
+      if (! tache) {
+        tache = steal();
+      }
+      if (tache) {
+        execute(tache);
+        continue;
+      }
+      std::unique_lock< std::mutex > verrou(mutex_);
+      travail_.wait(verrou, [this]() { return arret_ || enAttente_ > 0; });
+      if (arret_) {
+        return;
+      }
+    }
+  }
+
+} // merging
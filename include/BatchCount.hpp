@@ -0,0 +1,284 @@
+#ifndef BatchCount_hpp
+#define BatchCount_hpp
+
+#include "SimdCount.hpp"
+#include "ExecutionContext.hpp"
+#include <omp.h>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace paralgos {
+
+  /**
+   * @class BatchCount BatchCount.hpp
+   *
+   * Compte, en une seule passe et en parallèle, les occurrences de plusieurs
+   * valeurs (typiquement de 8 à 64) dans un même conteneur, là où autant
+   * d'appels à Count::apply parcourraient autant de fois le conteneur.
+   *
+   * @note Les tableaux contigus d'entiers ou de flottants sont traités par
+   *   les noyaux vectoriels multi-valeurs de SimdCount, qui diffusent les
+   *   valeurs recherchées dans des registres SIMD.
+   */
+  class BatchCount {
+  public:
+
+    /**
+     * Forme générale de l'algorithme, exécutée au sein du contexte par défaut.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] vals les valeurs recherchées.
+     * @return les nombres d'occurrences, dans l'ordre des valeurs recherchées.
+     */
+    template< typename InputIterator, typename T >
+    static std::vector<
+      typename std::iterator_traits< InputIterator >::difference_type >
+    apply(const InputIterator& first,
+          const InputIterator& last,
+          const std::vector< T >& vals) {
+      return apply(first, last, vals, ExecutionContext::standard());
+    } // apply
+
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] vals les valeurs recherchées.
+     * @param[in] context le contexte d'exécution.
+     * @return les nombres d'occurrences, dans l'ordre des valeurs recherchées.
+     */
+    template< typename InputIterator, typename T >
+    static std::vector<
+      typename std::iterator_traits< InputIterator >::difference_type >
+    apply(const InputIterator& first,
+          const InputIterator& last,
+          const std::vector< T >& vals,
+          const ExecutionContext& context) {
+
+      // Types synonymes.
+      typedef typename std::iterator_traits< InputIterator >::difference_type
+        Size;
+      typedef typename SimdCount::Category< InputIterator, T >::type Category;
+      typedef Impl< Category > Impl;
+
+      // Chaque thread dispose de ses propres compteurs.
+      const int threads = Impl::threads(first, last, context);
+      std::vector< std::vector< size_t > >
+        counts(threads, std::vector< size_t >(vals.size()));
+      Impl::apply(first, last, vals, counts);
+
+      // Réduction des compteurs.
+      std::vector< Size > result(vals.size());
+      for (int r = 0; r != threads; r ++) {
+        for (size_t q = 0; q != vals.size(); q ++) {
+          result[q] += counts[r][q];
+        }
+      }
+      return result;
+
+    } // apply
+
+  private:
+
+    /**
+     * Compte séquentiellement les occurrences des valeurs recherchées dans un
+     * tronçon, élément par élément. Les occurrences sont comptées dans un
+     * tableau local puis ajoutées une seule fois aux compteurs du thread : les
+     * compteurs de threads voisins, alloués côte à côte, partagent sinon leurs
+     * lignes de cache à chaque incrément.
+     *
+     * @param[in] first un itérateur repérant le premier élément du tronçon.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du tronçon.
+     * @param[in] vals les valeurs recherchées.
+     * @param[in, out] counts les compteurs d'occurrences.
+     */
+    template< typename InputIterator, typename T >
+    static void sequential(const InputIterator& first,
+                           const InputIterator& last,
+                           const std::vector< T >& vals,
+                           std::vector< size_t >& counts) {
+      std::vector< size_t > local(vals.size());
+      for (InputIterator it = first; it != last; ++ it) {
+        for (size_t q = 0; q != vals.size(); q ++) {
+          if (*it == vals[q]) {
+            local[q] ++;
+          }
+        }
+      }
+      for (size_t q = 0; q != vals.size(); q ++) {
+        counts[q] += local[q];
+      }
+    } // sequential
+
+  public:
+
+    /**
+     * Implémentation de cet algorithme dédiée aux InputIterator : un thread
+     * parcourt le conteneur et crée une tâche par tronçon (cf.
+     * ExecutionContext::forEachChunk).
+     */
+    template< typename Category >
+    class Impl {
+    public:
+
+      // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+      // invoquer les méthodes de classe privées.
+      friend class BatchCount;
+
+    private:
+
+      /**
+       * @return le nombre de threads de l'équipe (le nombre d'éléments ne
+       *   pouvant être calculé sans un coût prohibitif).
+       */
+      template< typename InputIterator >
+      static int threads(const InputIterator&,
+                         const InputIterator&,
+                         const ExecutionContext& context) {
+        return context.threads();
+      } // threads
+
+      /**
+       * Implémentation de l'algorithme.
+       *
+       * @param[in] first un itérateur repérant le premier élément à traiter.
+       * @param[in] last un itérateur repérant l'élément situé juste derrière
+       *   le dernier élément à traiter.
+       * @param[in] vals les valeurs recherchées.
+       * @param[in, out] counts les compteurs d'occurrences de chaque thread.
+       */
+      template< typename InputIterator, typename T >
+      static void apply(const InputIterator& first,
+                        const InputIterator& last,
+                        const std::vector< T >& vals,
+                        std::vector< std::vector< size_t > >& counts) {
+        ExecutionContext::forEachChunk(first, last, int(counts.size()),
+                                       [&](const InputIterator& debut,
+                                           const InputIterator& fin) {
+          sequential(debut, fin, vals, counts[omp_get_thread_num()]);
+        });
+      } // apply
+
+    }; // Impl< not RandomAccessIterator >
+
+  }; // BatchCount
+
+  /**
+   * Implémentation de cet algorithme dédiée aux RandomAccessIterator : chaque
+   * thread traite un bloc contigu d'éléments.
+   */
+  template<>
+  class BatchCount::Impl< std::random_access_iterator_tag > {
+  public:
+
+    // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+    // invoquer les méthodes de classe privées.
+    friend class BatchCount;
+
+  protected:
+
+    /**
+     * @return 1 si le nombre d'éléments est inférieur au seuil du contexte,
+     *   le nombre de threads de l'équipe sinon.
+     */
+    template< typename RandomAccessIterator >
+    static int threads(const RandomAccessIterator& first,
+                       const RandomAccessIterator& last,
+                       const ExecutionContext& context) {
+      return context.sequential(last - first) ? 1 : context.threads();
+    } // threads
+
+    /**
+     * Implémentation de l'algorithme.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] vals les valeurs recherchées.
+     * @param[in, out] counts les compteurs d'occurrences de chaque thread.
+     */
+    template< typename RandomAccessIterator, typename T >
+    static void apply(const RandomAccessIterator& first,
+                      const RandomAccessIterator& last,
+                      const std::vector< T >& vals,
+                      std::vector< std::vector< size_t > >& counts) {
+      typedef typename std::iterator_traits< RandomAccessIterator >::
+        difference_type Size;
+      const int threads = counts.size();
+      const Size n = last - first;
+#pragma omp parallel for schedule(static, 1) num_threads(threads)
+      for (int r = 0; r < threads; r ++) {
+        sequential(first + n * r / threads,
+                   first + n * (r + 1) / threads,
+                   vals,
+                   counts[r]);
+      }
+    } // apply
+
+  }; // Impl< RandomAccessIterator >
+
+  /**
+   * Implémentation de cet algorithme dédiée aux tableaux contigus d'éléments
+   * arithmétiques : chaque thread applique le noyau vectoriel multi-valeurs à
+   * un bloc contigu du tableau.
+   */
+  template<>
+  class BatchCount::Impl< contiguous_arithmetic_iterator_tag >
+    : public BatchCount::Impl< std::random_access_iterator_tag > {
+  public:
+
+    // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+    // invoquer les méthodes de classe privées.
+    friend class BatchCount;
+
+  private:
+
+    /**
+     * Implémentation de l'algorithme.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] vals les valeurs recherchées.
+     * @param[in, out] counts les compteurs d'occurrences de chaque thread.
+     */
+    template< typename ContiguousIterator, typename T >
+    static void apply(const ContiguousIterator& first,
+                      const ContiguousIterator& last,
+                      const std::vector< T >& vals,
+                      std::vector< std::vector< size_t > >& counts) {
+      const int threads = counts.size();
+      const size_t n = last - first;
+      if (n == 0) {
+        return;
+      }
+      const T* x = std::addressof(*first);
+#pragma omp parallel for schedule(static, 1) num_threads(threads)
+      for (int r = 0; r < threads; r ++) {
+        const size_t ir = n * r / threads;
+        const size_t ir1 = n * (r + 1) / threads;
+        // Compteurs locaux, ajoutés une seule fois à ceux du thread (cf.
+        // BatchCount::sequential).
+        std::vector< size_t > local(vals.size());
+        SimdCount::apply(x + ir,
+                         ir1 - ir,
+                         vals.data(),
+                         vals.size(),
+                         local.data());
+        for (size_t q = 0; q != vals.size(); q ++) {
+          counts[r][q] += local[q];
+        }
+      }
+    } // apply
+
+  }; // Impl< ContiguousArithmeticIterator >
+
+} // paralgos
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef BitCount_hpp
+#define BitCount_hpp
+
+#include "ExecutionContext.hpp"
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace paralgos {
+
+  /**
+   * Catégorie d'itérateurs repérant des bits empaquetés dans des mots
+   * machine (itérateurs de std::vector<bool>). Ces itérateurs autorisent un
+   * traitement mot par mot.
+   */
+  struct bit_iterator_tag
+    : public std::random_access_iterator_tag {};
+
+  /**
+   * @class BitCount BitCount.hpp
+   *
+   * Version de l'algorithme count dédiée aux bits empaquetés dans des mots de
+   * 64 bits (std::vector<bool>, bitmaps de présence, ...) : les bits sont
+   * comptés mot par mot par l'instruction popcnt, voire huit mots à la fois
+   * par l'instruction vpopcntq d'AVX-512, et les mots sont répartis entre les
+   * threads.
+   *
+   * @note Le bit d'indice i d'un mot est son bit de poids 2^i, comme dans
+   *   std::vector<bool>.
+   * @note Le jeu d'instructions utilisé suit celui imposé à SimdCount.
+   */
+  class BitCount {
+  public:
+
+    /**
+     * Compte séquentiellement le nombre de bits égaux à une valeur donnée
+     * dans une plage de bits.
+     *
+     * @param[in] words les mots contenant les bits.
+     * @param[in] first l'indice du premier bit à traiter.
+     * @param[in] last l'indice du bit situé juste derrière le dernier bit à
+     *   traiter.
+     * @param[in] val la valeur recherchée.
+     * @return le nombre de bits égaux à la valeur recherchée.
+     */
+    static size_t apply(const uint64_t words[],
+                        const size_t& first,
+                        const size_t& last,
+                        const bool& val);
+
+    /**
+     * Compte en parallèle le nombre de bits égaux à une valeur donnée dans
+     * une plage de bits. Chaque thread traite un bloc de mots contigus, les
+     * mots partiellement couverts par la plage étant masqués.
+     *
+     * @param[in] words les mots contenant les bits.
+     * @param[in] first l'indice du premier bit à traiter.
+     * @param[in] last l'indice du bit situé juste derrière le dernier bit à
+     *   traiter.
+     * @param[in] val la valeur recherchée.
+     * @param[in] context le contexte d'exécution (son seuil s'applique au
+     *   nombre de mots).
+     * @return le nombre de bits égaux à la valeur recherchée.
+     */
+    static size_t apply(const uint64_t words[],
+                        const size_t& first,
+                        const size_t& last,
+                        const bool& val,
+                        const ExecutionContext& context);
+
+    /**
+     * Indique si un itérateur repère des bits empaquetés dans des mots de 64
+     * bits, et donne accès à ces mots.
+     */
+    template< typename Iterator >
+    struct IsBitIterator : public std::false_type {};
+
+    /**
+     * Détermine si la recherche d'une valeur de type @c T peut être traitée
+     * mot par mot : les itérateurs doivent repérer des bits empaquetés et la
+     * valeur recherchée doit être un booléen.
+     */
+    template< typename Iterator, typename T >
+    struct Category {
+
+      enum : bool {
+        value = IsBitIterator< Iterator >::value
+          && std::is_same< typename std::decay< T >::type, bool >::value
+      };
+
+      typedef typename std::conditional<
+        value,
+        bit_iterator_tag,
+        typename std::iterator_traits< Iterator >::iterator_category
+        >::type type;
+
+    }; // Category
+
+  private:
+
+    /**
+     * Compte les bits à 1 d'un tableau de mots via le jeu d'instructions
+     * courant.
+     *
+     * @param[in] words les mots.
+     * @param[in] n le nombre de mots.
+     * @return le nombre de bits à 1.
+     */
+    static size_t popcount(const uint64_t words[], const size_t& n);
+
+    /**
+     * Compte les bits à 1 d'une plage de bits, en masquant les mots
+     * partiellement couverts.
+     *
+     * @param[in] words les mots contenant les bits.
+     * @param[in] first l'indice du premier bit à traiter.
+     * @param[in] last l'indice du bit situé juste derrière le dernier bit à
+     *   traiter.
+     * @return le nombre de bits à 1.
+     */
+    static size_t ones(const uint64_t words[],
+                       const size_t& first,
+                       const size_t& last);
+
+  }; // BitCount
+
+#ifdef __GLIBCXX__
+  // Les itérateurs de std::vector<bool> repèrent un mot (_M_p) et la
+  // position d'un bit dans ce mot (_M_offset).
+  template<>
+  struct BitCount::IsBitIterator< std::vector< bool >::iterator >
+    : public std::integral_constant<
+    bool, sizeof(std::_Bit_type) == sizeof(uint64_t) > {
+
+    /**
+     * @return l'adresse du mot contenant le bit repéré.
+     */
+    static const uint64_t* word(const std::vector< bool >::iterator& it) {
+      return reinterpret_cast< const uint64_t* >(it._M_p);
+    }
+
+    /**
+     * @return la position du bit repéré dans son mot.
+     */
+    static size_t offset(const std::vector< bool >::iterator& it) {
+      return it._M_offset;
+    }
+
+  };
+
+  template<>
+  struct BitCount::IsBitIterator< std::vector< bool >::const_iterator >
+    : public std::integral_constant<
+    bool, sizeof(std::_Bit_type) == sizeof(uint64_t) > {
+
+    static const uint64_t*
+    word(const std::vector< bool >::const_iterator& it) {
+      return reinterpret_cast< const uint64_t* >(it._M_p);
+    }
+
+    static size_t offset(const std::vector< bool >::const_iterator& it) {
+      return it._M_offset;
+    }
+
+  };
+#endif
+
+} // paralgos
+
+#endif
@@ -0,0 +1,358 @@
+#ifndef BitonicMerge_hpp
+#define BitonicMerge_hpp
+
+#include "SimdCount.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+namespace merging {
+
+  /**
+   * @class BitonicMerge BitonicMerge.hpp
+   *
+   * Noyau vectoriel (AVX2) de l'algorithme merge de la bibliothèque standard
+   * pour des tableaux d'entiers ou de flottants de 32 ou 64 bits ordonnés
+   * par ordre croissant. Les deux suites sont consommées par registres
+   * entiers : chaque registre lu est fusionné avec le registre des plus
+   * grands éléments déjà lus par un réseau de fusion bitonique, dont la
+   * moitié inférieure est recopiée dans le conteneur cible. Le seul
+   * branchement restant, le choix de la suite dont est lu le registre
+   * suivant, est effectué une fois par registre et non plus une fois par
+   * élément.
+   *
+   * @note L'implémentation proposée est celle décrite dans H. Inoue,
+   *   T. Moriyama, H. Komatsu and T. Nakatani, "AA-Sort: A New Parallel
+   *   Sorting Algorithm for Multi-Core SIMD Processors", PACT 2007.
+   * @note Les échanges sont effectués de sorte qu'aucun élément ne soit
+   *   dupliqué ni perdu, même pour -0.0 et +0.0 ou les NaN (ce que ne
+   *   garantissent pas des instructions min et max utilisées naïvement). En
+   *   revanche, le réseau n'est pas stable : l'ordre relatif de -0.0 et
+   *   +0.0 peut différer de celui produit par l'algorithme merge. Tout comme
+   *   pour ce dernier, le résultat n'est pas trié si les suites contiennent
+   *   des NaN.
+   * @note Le jeu d'instructions utilisé suit celui imposé à
+   *   paralgos::SimdCount ; à défaut d'AVX2, la fusion est effectuée via
+   *   l'algorithme merge de la bibliothèque standard.
+   */
+  class BitonicMerge {
+  private:
+
+    /**
+     * Nature d'un comparateur : croissant strict (std::less), croissant
+     * large (std::less_equal) ou autre.
+     */
+    enum { AUTRE, STRICT, LARGE };
+
+    template< typename Compare, typename T >
+    struct Order : public std::integral_constant< int, AUTRE > {};
+
+    template< typename U, typename T >
+    struct Order< std::less< U >, T >
+      : public std::integral_constant<
+      int, std::is_same< typename std::decay< U >::type, T >::value
+      ? STRICT : AUTRE > {};
+
+    template< typename U, typename T >
+    struct Order< std::less_equal< U >, T >
+      : public std::integral_constant<
+      int, std::is_same< typename std::decay< U >::type, T >::value
+      ? LARGE : AUTRE > {};
+
+  public:
+
+    /**
+     * Fusionne séquentiellement, via le jeu d'instructions courant, deux
+     * tableaux ordonnés par ordre croissant.
+     *
+     * @param[in] a - le premier tableau ;
+     * @param[in] m - le nombre d'éléments du premier tableau ;
+     * @param[in] b - le second tableau ;
+     * @param[in] n - le nombre d'éléments du second tableau ;
+     * @param[out] result - le tableau accueillant les m + n éléments
+     *   résultant de la fusion.
+     * @return un pointeur repérant la fin de la zone de fusion.
+     */
+    template< typename T >
+    static T* apply(const T a[],
+		    const size_t& m,
+		    const T b[],
+		    const size_t& n,
+		    T result[]) {
+
+      // Les entiers ne sont distingués que par leur taille et leur signe.
+      typedef typename Word< T >::type W;
+      kernel(reinterpret_cast< const W* >(a),
+	     m,
+	     reinterpret_cast< const W* >(b),
+	     n,
+	     reinterpret_cast< W* >(result));
+      return result + m + n;
+
+    } // apply
+
+    /**
+     * Détermine si une fusion peut être confiée au noyau vectoriel : les
+     * trois itérateurs doivent repérer des éléments contigus du même type,
+     * entier ou flottant de 32 ou 64 bits, et le comparateur doit être
+     * std::less (ou std::less_equal pour des entiers, les éléments égaux
+     * étant alors indiscernables).
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    struct Category {
+
+      // Type des éléments repérés par le premier itérateur.
+      typedef typename std::iterator_traits< InputRandomAccessIterator1 >::
+	value_type value_type;
+
+      enum : bool {
+	value = paralgos::SimdCount::IsContiguous<
+	  InputRandomAccessIterator1 >::value
+	  && paralgos::SimdCount::IsContiguous<
+	    InputRandomAccessIterator2 >::value
+	  && paralgos::SimdCount::IsContiguous<
+	    OutputRandomAccessIterator >::value
+	  && std::is_same< value_type, typename std::iterator_traits<
+			     InputRandomAccessIterator2 >::value_type >::value
+	  && std::is_same< value_type, typename std::iterator_traits<
+			     OutputRandomAccessIterator >::value_type >::value
+	  && std::is_arithmetic< value_type >::value
+	  && (sizeof(value_type) == 4 || sizeof(value_type) == 8)
+	  && ! std::is_same< value_type, long double >::value
+	  && (Order< Compare, value_type >::value == STRICT
+	      || (Order< Compare, value_type >::value == LARGE
+		  && std::is_integral< value_type >::value))
+      };
+
+      typedef std::integral_constant< bool, value > type;
+
+    }; // Category
+
+    /**
+     * Feuille des fusions récursives ou par tranches : la fusion est confiée
+     * au noyau vectoriel si les types le permettent (cf. Category), à
+     * l'algorithme merge de la bibliothèque standard sinon.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    merge(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp) {
+      typedef typename Category< InputRandomAccessIterator1,
+				 InputRandomAccessIterator2,
+				 OutputRandomAccessIterator,
+				 Compare >::type Vectorisable;
+      return merge(first1, last1, first2, last2, result, comp,
+		   Vectorisable());
+    } // merge
+
+    /**
+     * Feuille des fusions par déplacement (cf. std::move_iterator) : pour
+     * des éléments trivialement copiables, déplacer revient à recopier et la
+     * fusion est confiée à la feuille ci-dessus (donc éventuellement au
+     * noyau vectoriel) ; les autres sont déplacés par l'algorithme merge de
+     * la bibliothèque standard.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou déplacer le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    merge(const std::move_iterator< InputRandomAccessIterator1 >& first1,
+	  const std::move_iterator< InputRandomAccessIterator1 >& last1,
+	  const std::move_iterator< InputRandomAccessIterator2 >& first2,
+	  const std::move_iterator< InputRandomAccessIterator2 >& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp) {
+      typedef typename std::iterator_traits< InputRandomAccessIterator1 >::
+	value_type value_type;
+      return moveMerge(first1, last1, first2, last2, result, comp,
+		       std::is_trivially_copyable< value_type >());
+    } // merge
+
+  private:
+
+    /**
+     * Fusion par déplacement d'éléments trivialement copiables.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    moveMerge(const std::move_iterator< InputRandomAccessIterator1 >& first1,
+	      const std::move_iterator< InputRandomAccessIterator1 >& last1,
+	      const std::move_iterator< InputRandomAccessIterator2 >& first2,
+	      const std::move_iterator< InputRandomAccessIterator2 >& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare& comp,
+	      std::true_type) {
+      return merge(first1.base(), last1.base(), first2.base(), last2.base(),
+		   result, comp);
+    } // moveMerge
+
+    /**
+     * Fusion par déplacement d'éléments quelconques.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    moveMerge(const std::move_iterator< InputRandomAccessIterator1 >& first1,
+	      const std::move_iterator< InputRandomAccessIterator1 >& last1,
+	      const std::move_iterator< InputRandomAccessIterator2 >& first2,
+	      const std::move_iterator< InputRandomAccessIterator2 >& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare& comp,
+	      std::false_type) {
+      return std::merge(first1, last1, first2, last2, result, comp);
+    } // moveMerge
+
+    /**
+     * Type machine utilisé pour comparer des éléments de type @c T.
+     */
+    template< typename T, bool integral = std::is_integral< T >::value >
+    struct Word;
+
+    /**
+     * Adresse de l'élément repéré par un itérateur d'éléments contigus.
+     */
+    template< typename T >
+    static T* pointer(T* const& it) {
+      return it;
+    }
+
+#ifdef __GLIBCXX__
+    template< typename Pointer, typename Container >
+    static Pointer
+    pointer(const __gnu_cxx::__normal_iterator< Pointer, Container >& it) {
+      return it.base();
+    }
+#endif
+
+    /**
+     * Feuille vectorielle.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    merge(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare&,
+	  std::true_type) {
+      apply(pointer(first1), last1 - first1,
+	    pointer(first2), last2 - first2,
+	    pointer(result));
+      return result + (last1 - first1) + (last2 - first2);
+    } // merge
+
+    /**
+     * Feuille scalaire.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    merge(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp,
+	  std::false_type) {
+      return std::merge(first1, last1, first2, last2, result, comp);
+    } // merge
+
+    /**
+     * Noyaux vectoriels, un par taille et signe d'entiers et par type de
+     * flottants.
+     *
+     * @param[in] a - le premier tableau ;
+     * @param[in] m - le nombre d'éléments du premier tableau ;
+     * @param[in] b - le second tableau ;
+     * @param[in] n - le nombre d'éléments du second tableau ;
+     * @param[out] result - le tableau accueillant le résultat de la fusion.
+     */
+    static void kernel(const int32_t a[], const size_t& m,
+		       const int32_t b[], const size_t& n, int32_t result[]);
+    static void kernel(const uint32_t a[], const size_t& m,
+		       const uint32_t b[], const size_t& n, uint32_t result[]);
+    static void kernel(const int64_t a[], const size_t& m,
+		       const int64_t b[], const size_t& n, int64_t result[]);
+    static void kernel(const uint64_t a[], const size_t& m,
+		       const uint64_t b[], const size_t& n, uint64_t result[]);
+    static void kernel(const float a[], const size_t& m,
+		       const float b[], const size_t& n, float result[]);
+    static void kernel(const double a[], const size_t& m,
+		       const double b[], const size_t& n, double result[]);
+
+  }; // BitonicMerge
+
+  // Entiers : seuls la taille et le signe importent.
+  template< typename T >
+  struct BitonicMerge::Word< T, true > {
+    typedef typename std::conditional<
+      std::is_signed< T >::value,
+      typename std::conditional< sizeof(T) == 4, int32_t, int64_t >::type,
+      typename std::conditional< sizeof(T) == 4, uint32_t, uint64_t >::type
+      >::type type;
+  };
+
+  // Flottants : ils sont comparés en tant que tels.
+  template< typename T >
+  struct BitonicMerge::Word< T, false > {
+    typedef T type;
+  };
+
+} // merging
+
+#endif
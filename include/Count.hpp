@@ -1,22 +1,66 @@
 #ifndef Count_hpp
 #define Count_hpp
 
+#include "SimdCount.hpp"
+#include "BitCount.hpp"
+#include "ExecutionContext.hpp"
 #include <omp.h>
 #include <algorithm>
+#include <utility>
 #include <vector>
+#include <deque>
 
 namespace paralgos {
 
+  /**
+   * Catégorie d'itérateurs repérant des éléments stockés par blocs contigus
+   * (itérateurs de std::deque). Chaque bloc autorise un traitement aussi
+   * efficace que celui d'un tableau.
+   */
+  struct segmented_iterator_tag
+    : public std::random_access_iterator_tag {};
+
   /**
    * @class Count Count.hpp
    *
    * Version OpenMP de l'algorithme count de la bibliothèque standard.
+   *
+   * @note Les tableaux contigus d'entiers ou de flottants sont traités par
+   *   des noyaux vectoriels (cf. SimdCount).
+   * @note Les std::vector<bool> sont traités mot par mot (cf. BitCount).
+   * @note Les std::deque sont traités bloc par bloc.
    */
   class Count {
   public:
 
     /**
-     * Forme générale de l'algorithme.
+     * Indique si un itérateur repère des éléments stockés par blocs contigus,
+     * et donne accès à ces blocs.
+     */
+    template< typename Iterator >
+    struct IsSegmented : public std::false_type {};
+
+    /**
+     * Détermine la catégorie d'un itérateur pour la recherche d'une valeur de
+     * type @c T : @c bit_iterator_tag pour des bits empaquetés,
+     * @c segmented_iterator_tag pour des blocs contigus,
+     * @c contiguous_arithmetic_iterator_tag pour un tableau contigu
+     * d'éléments arithmétiques, la catégorie de la bibliothèque standard
+     * sinon.
+     */
+    template< typename Iterator, typename T >
+    struct Category {
+      typedef typename std::conditional<
+        BitCount::Category< Iterator, T >::value,
+        bit_iterator_tag, typename std::conditional<
+          IsSegmented< Iterator >::value,
+          segmented_iterator_tag,
+          typename SimdCount::Category< Iterator, T >::type
+          >::type >::type type;
+    }; // Category
+
+    /**
+     * Forme générale de l'algorithme, exécutée au sein du contexte par défaut.
      *
      * @param[in, out] first un itérateur repérant le premier élément à traiter.
      * @param[in, out] last un itérateur repérant l'élément situé juste derrière
@@ -27,32 +71,70 @@ namespace paralgos {
     template< typename InputIterator, typename T >
     static typename std::iterator_traits< InputIterator >::difference_type
     apply(InputIterator first, InputIterator last, const T& val) {
+      return apply(first, last, val, ExecutionContext::standard());
+    } // apply
 
-      // Obtention du nombre de threads. Si celui-ci vaut 1, nous utilisons
-      // directement la version séquentielle de l'algorithme, c'est à dire celle
-      // de la bibliothèque standard.
-      int threads;
-#pragma omp parallel
-#pragma omp single
-      threads = omp_get_num_threads();
-      if (threads == 1) {
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in, out] first un itérateur repérant le premier élément à traiter.
+     * @param[in, out] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] val la valeur recherchée.
+     * @param[in] context le contexte d'exécution (nombre de threads et seuil
+     *   de repli sur la version séquentielle).
+     * @return le nombre d'occurrences de la valeur recherchée.
+     */
+    template< typename InputIterator, typename T >
+    static typename std::iterator_traits< InputIterator >::difference_type
+    apply(InputIterator first,
+          InputIterator last,
+          const T& val,
+          const ExecutionContext& context) {
+
+      // Obtention de la catégorie des itérateurs first et last (nous passons
+      // par le template iterator_traits de la bibliothèque standard afin de
+      // pouvoir gérer tous les types de RandomAccessIterator, y compris les
+      // simples pointeurs). Les tableaux contigus d'éléments arithmétiques
+      // et les bits empaquetés forment des catégories à part (cf. Category).
+      typedef typename Count::Category< InputIterator, T >::type Category;
+
+      // Si l'équipe ne compte qu'un thread, nous utilisons directement la
+      // version séquentielle de l'algorithme, c'est à dire celle de la
+      // bibliothèque standard, sauf pour les catégories à part dont les
+      // noyaux dédiés restent plus rapides même avec un seul thread.
+      if (context.threads() == 1
+          && std::is_same< Category,
+                           typename std::iterator_traits< InputIterator >::
+                           iterator_category >::value) {
       	return std::count(first, last, val);
       }
 
-      // Obtention du type des itérateurs first et last (nous passons par le
-      // template iterator_traits de la bibliothèque standard afin de pouvoir 
-      // gérer tous les types de RandomAccessIterator, y compris les simples 
-      // pointeurs).
-      typedef std::iterator_traits< InputIterator > Traits;
-
       // Instanciation de l'implémentation (sous-classe) adéquate.
-      typedef Impl< typename Traits::iterator_category > Impl;
+      typedef Impl< Category > Impl;
 
       // Invocation de la version dédiée de cet algorithme.
-      return Impl::apply(first, last, val, threads);
+      return Impl::apply(first, last, val, context);
 
     } // apply
 
+  private:
+
+    /**
+     * Compteur d'occurrences propre à un thread, occupant à lui seul une
+     * ligne de cache afin d'éviter tout faux partage entre threads.
+     */
+    template< typename Size >
+    struct Compteur {
+
+      /** Le nombre d'occurrences comptées par le thread. */
+      Size value;
+
+      /** Bourrage complétant la ligne de cache. */
+      char padding[64 - sizeof(Size) % 64];
+
+    }; // Compteur
+
   public:
 
     /**
@@ -76,7 +158,7 @@ namespace paralgos {
        * @param[in, out] last un itérateur repérant l'élément situé juste 
        *   derrière le dernier élément à traiter.
        * @param[in] val la valeur recherchée.
-       * @param[in] threads le nombre de threads disponibles.
+       * @param[in] context le contexte d'exécution.
        * @return le nombre d'occurrences de la valeur recherchée.
        */
       template< typename InputIterator, typename T >
@@ -85,11 +167,11 @@ namespace paralgos {
       apply(const InputIterator& first,
             const InputIterator& last,
             const T& val,
-            const int& threads) {
-	return strategyB(first, last, val, threads);
+            const ExecutionContext& context) {
+	return strategyB(first, last, val, context.threads());
       } // apply
 
-    private:
+    public:
 
       /**
        * Implémentation basée sur l'idée d'une répartition cyclique des
@@ -112,11 +194,38 @@ namespace paralgos {
                 const T& val,
                 const int& threads) {
 
-        // Le nombre d'occurrences.
-        typename std::iterator_traits< InputIterator >::difference_type
-          acc = 0;
+        // Type des entiers manipulés.
+        typedef typename std::iterator_traits< InputIterator >::
+          difference_type Size;
+
+        // Un compteur par thread.
+        std::vector< Compteur< Size > > compteurs(threads);
+
+        // Chaque thread parcourt l'intégralité du conteneur (un itérateur
+        // d'entrée ne permet pas de sauter directement à un élément) mais ne
+        // compare que les éléments dont le rang lui revient.
+#pragma omp parallel num_threads(threads)
+        {
+          const int r = omp_get_thread_num();
+          const int p = omp_get_num_threads();
+          Size local = 0;
+          int rang = 0;
+          for (InputIterator it = first; it != last; ++ it) {
+            if (rang == r && *it == val) {
+              local ++;
+            }
+            if (++ rang == p) {
+              rang = 0;
+            }
+          }
+          compteurs[r].value = local;
+        }
 
-        // ... à compléter ...
+        // Le nombre d'occurrences.
+        Size acc = 0;
+        for (int r = 0; r != threads; r ++) {
+          acc += compteurs[r].value;
+        }
  
         // C'est terminé.
         return acc;
@@ -146,15 +255,29 @@ namespace paralgos {
                 const T& val,
                 const int& threads) {
 
-	// Taille d'un tronçon fixée arbitrairement (le nombre des éléments
-        // du conteneur ne peut être calculé sans un coup prohibitif).
-	const int taille = 128 * threads;
-
-        // Le nombre d'occurrences de la valeur recherchée.
-        typename std::iterator_traits< InputIterator >::difference_type
-          acc = 0;
-
-        // ... à compléter ...
+        // Type des entiers manipulés.
+        typedef typename std::iterator_traits< InputIterator >::
+          difference_type Size;
+
+        // Un compteur par thread : chaque tâche ajoute son résultat à celui
+        // du thread qui l'exécute.
+        std::vector< Compteur< Size > > compteurs(threads);
+
+        // Un seul thread parcourt le conteneur et crée une tâche par tronçon
+        // (cf. ExecutionContext::forEachChunk).
+        ExecutionContext::forEachChunk(first, last, threads,
+                                       [&](const InputIterator& debut,
+                                           const InputIterator& fin) {
+          compteurs[omp_get_thread_num()].value +=
+            std::count(debut, fin, val);
+        });
+
+        // Le nombre d'occurrences de la valeur recherchée (la barrière de
+        // fin de région garantit que toutes les tâches sont terminées).
+        Size acc = 0;
+        for (int r = 0; r != threads; r ++) {
+          acc += compteurs[r].value;
+        }
 
         // C'est terminé.
         return acc;
@@ -185,7 +308,7 @@ namespace paralgos {
      * @param[in, out] last un itérateur repérant l'élément situé juste derrière
      *   le dernier élément à traiter.
      * @param[in] val la valeur recherchée.
-     * @param[in] threads le nombre de threads disponibles (inutile ici).
+     * @param[in] context le contexte d'exécution.
      * @return le nombre d'occurrences de la valeur recherchée.
      */
     template< typename RandomAccessIterator, typename T >
@@ -194,16 +317,31 @@ namespace paralgos {
     apply(const RandomAccessIterator& first,
           const RandomAccessIterator& last,
           const T& val,
-          const int& threads) {
+          const ExecutionContext& context) {
 
-      // Le compteur d'occurrences.
-      typename std::iterator_traits< RandomAccessIterator >::difference_type
-        acc = 0;
+      // Type des entiers manipulés.
+      typedef typename std::iterator_traits< RandomAccessIterator >::
+        difference_type Size;
 
-#pragma omp parallel
-#pragma omp for schedule(static, 1)
-      for(int i = 0; i < ; i++){ 
-      }      
+      // Trop peu d'éléments pour amortir le coût d'une région parallèle.
+      const Size n = last - first;
+      if (context.sequential(n)) {
+        return std::count(first, last, val);
+      }
+
+      // Le compteur d'occurrences.
+      Size acc = 0;
+
+      // Chaque thread traite un bloc contigu d'éléments (les blocs cycliques
+      // d'un élément, façon schedule(static, 1), provoquent du faux partage
+      // et empêchent toute vectorisation).
+      const int threads = context.threads();
+#pragma omp parallel for schedule(static) reduction(+: acc) num_threads(threads)
+      for (Size i = 0; i < n; i ++) {
+        if (first[i] == val) {
+          acc ++;
+        }
+      }
 
       // C'est terminé.
       return acc;
@@ -212,6 +350,282 @@ namespace paralgos {
 
   }; // Impl< RandomAccessIterator >
 
+  /**
+   * Implémentation de cet algorithme dédiée aux tableaux contigus d'éléments
+   * arithmétiques.
+   */
+  template<>
+  class Count::Impl< contiguous_arithmetic_iterator_tag > {
+  public:
+
+    // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+    // invoquer la méthode de classe privée @c apply.
+    friend class Count;
+
+  private:
+
+    /**
+     * Implémentation de count.
+     *
+     * @param[in, out] first un itérateur repérant le premier élément à traiter.
+     * @param[in, out] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] val la valeur recherchée.
+     * @param[in] context le contexte d'exécution.
+     * @return le nombre d'occurrences de la valeur recherchée.
+     */
+    template< typename ContiguousIterator, typename T >
+    static
+    typename std::iterator_traits< ContiguousIterator >::difference_type
+    apply(const ContiguousIterator& first,
+          const ContiguousIterator& last,
+          const T& val,
+          const ExecutionContext& context) {
+
+      // Type des entiers manipulés.
+      typedef typename std::iterator_traits< ContiguousIterator >::
+        difference_type Size;
+
+      // Le tableau est vide : il n'y a rien à déréférencer.
+      const Size n = last - first;
+      if (n == 0) {
+        return 0;
+      }
+
+      // Trop peu d'éléments pour amortir le coût d'une région parallèle : le
+      // noyau vectoriel est appliqué séquentiellement.
+      const T* x = std::addressof(*first);
+      if (context.sequential(n)) {
+        return SimdCount::apply(x, n, val);
+      }
+
+      // Le compteur d'occurrences.
+      Size acc = 0;
+
+      // Chaque thread applique le noyau vectoriel à un bloc contigu du tableau.
+      const int threads = context.threads();
+#pragma omp parallel for schedule(static, 1) reduction(+: acc) num_threads(threads)
+      for (int r = 0; r < threads; r ++) {
+        const Size ir = n * r / threads;
+        const Size ir1 = n * (r + 1) / threads;
+        acc += SimdCount::apply(x + ir, ir1 - ir, val);
+      }
+
+      // C'est terminé.
+      return acc;
+
+    } // apply
+
+  }; // Impl< ContiguousArithmeticIterator >
+
+  /**
+   * Implémentation de cet algorithme dédiée aux bits empaquetés : les bits
+   * sont comptés mot par mot (cf. BitCount).
+   */
+  template<>
+  class Count::Impl< bit_iterator_tag > {
+  public:
+
+    // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+    // invoquer la méthode de classe privée @c apply.
+    friend class Count;
+
+  private:
+
+    /**
+     * Implémentation de count.
+     *
+     * @param[in, out] first un itérateur repérant le premier bit à traiter.
+     * @param[in, out] last un itérateur repérant le bit situé juste derrière
+     *   le dernier bit à traiter.
+     * @param[in] val la valeur recherchée.
+     * @param[in] context le contexte d'exécution.
+     * @return le nombre d'occurrences de la valeur recherchée.
+     */
+    template< typename BitIterator >
+    static
+    typename std::iterator_traits< BitIterator >::difference_type
+    apply(const BitIterator& first,
+          const BitIterator& last,
+          const bool& val,
+          const ExecutionContext& context) {
+
+      // Les bits sont repérés par rapport au mot contenant le premier d'entre
+      // eux.
+      typedef BitCount::IsBitIterator< BitIterator > Bits;
+      const uint64_t* words = Bits::word(first);
+      const size_t debut = Bits::offset(first);
+      const size_t fin = (Bits::word(last) - words) * 64 + Bits::offset(last);
+      return BitCount::apply(words, debut, fin, val, context);
+
+    } // apply
+
+  }; // Impl< BitIterator >
+
+  /**
+   * Implémentation de cet algorithme dédiée aux éléments stockés par blocs
+   * contigus : chaque thread traite des blocs entiers, sans passer par
+   * l'itérateur pour accéder aux éléments.
+   */
+  template<>
+  class Count::Impl< segmented_iterator_tag > {
+  public:
+
+    // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+    // invoquer la méthode de classe privée @c apply.
+    friend class Count;
+
+  private:
+
+    /**
+     * Implémentation de count.
+     *
+     * @param[in, out] first un itérateur repérant le premier élément à traiter.
+     * @param[in, out] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] val la valeur recherchée.
+     * @param[in] context le contexte d'exécution.
+     * @return le nombre d'occurrences de la valeur recherchée.
+     */
+    template< typename SegmentedIterator, typename T >
+    static
+    typename std::iterator_traits< SegmentedIterator >::difference_type
+    apply(const SegmentedIterator& first,
+          const SegmentedIterator& last,
+          const T& val,
+          const ExecutionContext& context) {
+
+      // Type des entiers manipulés.
+      typedef typename std::iterator_traits< SegmentedIterator >::
+        difference_type Size;
+
+      // Le conteneur est vide : il n'y a aucun bloc à parcourir.
+      const Size n = last - first;
+      if (n == 0) {
+        return 0;
+      }
+
+      // Trop peu d'éléments pour amortir le coût d'une région parallèle : les
+      // blocs sont parcourus séquentiellement.
+      typedef IsSegmented< SegmentedIterator > Segments;
+      const long m = Segments::segments(first, last);
+      if (context.sequential(n)) {
+        return blocks(first, last, val, 0, m);
+      }
+
+      // Le compteur d'occurrences.
+      Size acc = 0;
+
+      // Chaque thread traite une suite de blocs consécutifs.
+      const int threads = context.threads();
+#pragma omp parallel for schedule(static, 1) reduction(+: acc) num_threads(threads)
+      for (int r = 0; r < threads; r ++) {
+        acc += blocks(first, last, val, m * r / threads, m * (r + 1) / threads);
+      }
+
+      // C'est terminé.
+      return acc;
+
+    } // apply
+
+    /**
+     * Compte séquentiellement les occurrences d'une valeur dans une suite de
+     * blocs.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] val la valeur recherchée.
+     * @param[in] debut le rang du premier bloc à traiter.
+     * @param[in] fin le rang du bloc situé juste derrière le dernier bloc à
+     *   traiter.
+     * @return le nombre d'occurrences de la valeur recherchée.
+     */
+    template< typename SegmentedIterator, typename T >
+    static
+    typename std::iterator_traits< SegmentedIterator >::difference_type
+    blocks(const SegmentedIterator& first,
+           const SegmentedIterator& last,
+           const T& val,
+           const long& debut,
+           const long& fin) {
+      typedef IsSegmented< SegmentedIterator > Segments;
+      typedef typename Segments::pointer Pointer;
+      typename std::iterator_traits< SegmentedIterator >::difference_type
+        acc = 0;
+      for (long k = debut; k < fin; k ++) {
+        const std::pair< Pointer, Pointer > s =
+          Segments::segment(first, last, k);
+        acc += kernel(s.first, s.second, val,
+                      std::integral_constant<
+                      bool, SimdCount::Category< Pointer, T >::value >());
+      }
+      return acc;
+    } // blocks
+
+    /**
+     * Compte les occurrences d'une valeur arithmétique dans un bloc via les
+     * noyaux vectoriels.
+     */
+    template< typename E, typename T >
+    static size_t kernel(const E* first,
+                         const E* last,
+                         const T& val,
+                         const std::true_type&) {
+      return SimdCount::apply(first, last - first, val);
+    } // kernel
+
+    /**
+     * Compte les occurrences d'une valeur quelconque dans un bloc.
+     */
+    template< typename E, typename T >
+    static size_t kernel(const E* first,
+                         const E* last,
+                         const T& val,
+                         const std::false_type&) {
+      return std::count(first, last, val);
+    } // kernel
+
+  }; // Impl< SegmentedIterator >
+
+#ifdef __GLIBCXX__
+  // Les itérateurs de std::deque repèrent un élément (_M_cur) et l'entrée
+  // de la table des blocs (_M_node) désignant le bloc qui le contient.
+  template< typename E, typename Reference, typename Pointer >
+  struct Count::IsSegmented< std::_Deque_iterator< E, Reference, Pointer > >
+    : public std::true_type {
+
+    /** Type des itérateurs. */
+    typedef std::_Deque_iterator< E, Reference, Pointer > iterator;
+
+    /** Type des pointeurs sur les éléments d'un bloc. */
+    typedef const E* pointer;
+
+    /**
+     * @return le nombre de blocs, éventuellement partiels, couverts par
+     *   l'intervalle [first, last[.
+     */
+    static long segments(const iterator& first, const iterator& last) {
+      return last._M_node - first._M_node + 1;
+    }
+
+    /**
+     * @return les bornes de la partie du bloc de rang @c k couverte par
+     *   l'intervalle [first, last[.
+     */
+    static std::pair< pointer, pointer > segment(const iterator& first,
+                                                 const iterator& last,
+                                                 const long& k) {
+      const typename iterator::_Map_pointer node = first._M_node + k;
+      return std::pair< pointer, pointer >(
+        k == 0 ? first._M_cur : *node,
+        node == last._M_node ? last._M_cur
+                             : *node + iterator::_S_buffer_size());
+    }
+
+  };
+#endif
+
 } // paralgos
 
 #endif
@@ -0,0 +1,197 @@
+#ifndef CountIndex_hpp
+#define CountIndex_hpp
+
+#include "Histogram.hpp"
+#include "ExecutionContext.hpp"
+#include <iterator>
+#include <vector>
+
+namespace paralgos {
+
+  /**
+   * @class CountIndex CountIndex.hpp
+   *
+   * Conteneur doté d'un index des nombres d'occurrences de ses valeurs :
+   * chaque insertion, suppression ou modification d'un élément met l'index à
+   * jour, de sorte qu'une requête équivalente à un appel à Count::apply sur
+   * l'ensemble du conteneur coûte O(1) (en moyenne) au lieu de O(n).
+   *
+   * @note Les éléments ne sont accessibles qu'en lecture : toute modification
+   *   doit passer par les méthodes de cette classe pour que l'index reste à
+   *   jour.
+   * @note L'index est reconstruit en parallèle (cf. Histogram) lors de la
+   *   construction et des affectations en bloc.
+   */
+  template< typename T, typename Container = std::vector< T > >
+  class CountIndex {
+  public:
+
+    /** Type des itérateurs (en lecture seule) sur les éléments. */
+    typedef typename Container::const_iterator const_iterator;
+
+    /** Type des nombres d'occurrences. */
+    typedef typename std::iterator_traits< const_iterator >::difference_type
+      size_type;
+
+    /**
+     * Constructeur d'un conteneur vide.
+     */
+    CountIndex() {}
+
+    /**
+     * Constructeur à partir d'un conteneur existant, dont l'index est
+     * construit en parallèle.
+     *
+     * @param[in] container le conteneur.
+     * @param[in] context le contexte d'exécution de la construction.
+     */
+    explicit CountIndex(Container container,
+                        const ExecutionContext& context =
+                        ExecutionContext::standard())
+      : container_(std::move(container)) {
+      rebuild(context);
+    }
+
+    /**
+     * Remplace le contenu du conteneur et reconstruit l'index en parallèle.
+     *
+     * @param[in] first un itérateur repérant le premier élément à copier.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à copier.
+     * @param[in] context le contexte d'exécution de la reconstruction.
+     */
+    template< typename InputIterator >
+    void assign(const InputIterator& first,
+                const InputIterator& last,
+                const ExecutionContext& context =
+                ExecutionContext::standard()) {
+      container_.assign(first, last);
+      rebuild(context);
+    }
+
+    /**
+     * Reconstruit l'index en parallèle à partir du contenu du conteneur.
+     *
+     * @param[in] context le contexte d'exécution.
+     */
+    void rebuild(const ExecutionContext& context =
+                 ExecutionContext::standard()) {
+      counts_ = Histogram::apply(container_.cbegin(), container_.cend(),
+                                 context);
+    }
+
+    /**
+     * Ajoute un élément à la fin du conteneur.
+     *
+     * @param[in] val la valeur de l'élément.
+     */
+    void push_back(const T& val) {
+      container_.push_back(val);
+      counts_[val] ++;
+    }
+
+    /**
+     * Insère un élément.
+     *
+     * @param[in] pos la position de l'élément inséré.
+     * @param[in] val la valeur de l'élément.
+     * @return un itérateur repérant l'élément inséré.
+     */
+    const_iterator insert(const const_iterator& pos, const T& val) {
+      const_iterator it = container_.insert(pos, val);
+      counts_[val] ++;
+      return it;
+    }
+
+    /**
+     * Supprime un élément.
+     *
+     * @param[in] pos la position de l'élément supprimé.
+     * @return un itérateur repérant l'élément suivant l'élément supprimé.
+     */
+    const_iterator erase(const const_iterator& pos) {
+      decrement(*pos);
+      return container_.erase(pos);
+    }
+
+    /**
+     * Modifie la valeur d'un élément.
+     *
+     * @param[in] pos la position de l'élément modifié.
+     * @param[in] val la nouvelle valeur de l'élément.
+     */
+    void set(const const_iterator& pos, const T& val) {
+      // La suppression d'un intervalle vide convertit l'itérateur constant
+      // en itérateur modifiant, sans coût ni effet sur le conteneur.
+      typename Container::iterator it = container_.erase(pos, pos);
+      if (*it == val) {
+        return;
+      }
+      decrement(*it);
+      counts_[val] ++;
+      *it = val;
+    }
+
+    /**
+     * Vide le conteneur.
+     */
+    void clear() {
+      container_.clear();
+      counts_.clear();
+    }
+
+    /**
+     * @param[in] val une valeur.
+     * @return le nombre d'occurrences de la valeur dans le conteneur.
+     */
+    size_type count(const T& val) const {
+      const typename Counts::const_iterator it = counts_.find(val);
+      return it == counts_.end() ? 0 : it->second;
+    }
+
+    /** @return le nombre de valeurs distinctes du conteneur. */
+    size_t distinct() const { return counts_.size(); }
+
+    /** @return le nombre d'éléments du conteneur. */
+    size_t size() const { return container_.size(); }
+
+    /** @return un itérateur repérant le premier élément. */
+    const_iterator begin() const { return container_.cbegin(); }
+
+    /** @return un itérateur repérant l'élément situé juste derrière le
+     *   dernier élément. */
+    const_iterator end() const { return container_.cend(); }
+
+    /** @return le conteneur. */
+    const Container& container() const { return container_; }
+
+  private:
+
+    /** Type de l'index, tel que construit par Histogram. */
+    typedef HashedCounts< T, size_type > Counts;
+
+    /**
+     * Retire une occurrence d'une valeur de l'index. Les valeurs absentes du
+     * conteneur sont retirées de l'index afin que sa taille reste bornée par
+     * le nombre de valeurs distinctes.
+     *
+     * @param[in] val la valeur.
+     */
+    void decrement(const T& val) {
+      const typename Counts::iterator it = counts_.find(val);
+      if (-- it->second == 0) {
+        counts_.erase(it);
+      }
+    }
+
+    /** Le conteneur. */
+    Container container_;
+
+    /** L'index : le nombre d'occurrences de chaque valeur présente. */
+    Counts counts_;
+
+  }; // CountIndex
+
+} // paralgos
+
+#endif
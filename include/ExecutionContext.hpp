@@ -0,0 +1,124 @@
+#ifndef ExecutionContext_hpp
+#define ExecutionContext_hpp
+
+#include <omp.h>
+#include <cstddef>
+
+namespace paralgos {
+
+  /**
+   * @class ExecutionContext ExecutionContext.hpp
+   *
+   * Contexte d'exécution partagé par les algorithmes de paralgos. Créé une
+   * fois pour toutes, il mémorise la taille de l'équipe de threads ainsi que
+   * le nombre d'éléments en dessous duquel un algorithme s'exécute
+   * séquentiellement, ce qui évite d'ouvrir une région parallèle à chaque
+   * appel pour connaître le nombre de threads.
+   *
+   * @note À sa construction, le contexte désactive l'ajustement dynamique du
+   *   nombre de threads (omp_set_dynamic) puis démarre une première fois
+   *   l'équipe : le support d'exécution d'OpenMP conserve ensuite ses threads
+   *   d'un appel à l'autre, de sorte que chaque région parallèle réutilise la
+   *   même équipe au lieu de la recréer. Le réglage OMP_WAIT_POLICY=active
+   *   réduit encore la latence de réveil de cette équipe.
+   */
+  class ExecutionContext {
+  public:
+
+    /**
+     * Nombre d'éléments par défaut en dessous duquel les algorithmes
+     * s'exécutent séquentiellement.
+     */
+    static const size_t DEFAULT_THRESHOLD = 32 * 1024;
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] threads le nombre de threads de l'équipe (0 pour le nombre
+     *   de threads par défaut d'OpenMP).
+     * @param[in] threshold le nombre d'éléments en dessous duquel les
+     *   algorithmes s'exécutent séquentiellement.
+     */
+    explicit ExecutionContext(const int& threads = 0,
+                              const size_t& threshold = DEFAULT_THRESHOLD);
+
+    /**
+     * @return le nombre de threads de l'équipe.
+     */
+    const int& threads() const;
+
+    /**
+     * @return le nombre d'éléments en dessous duquel les algorithmes
+     *   s'exécutent séquentiellement.
+     */
+    const size_t& threshold() const;
+
+    /**
+     * Indique si le traitement de n éléments doit être effectué
+     * séquentiellement.
+     *
+     * @param[in] n le nombre d'éléments à traiter.
+     * @return @c true si l'équipe ne compte qu'un thread ou si n est inférieur
+     *   au seuil.
+     */
+    bool sequential(const size_t& n) const;
+
+    /**
+     * @return le contexte utilisé par défaut par les algorithmes de paralgos,
+     *   construit lors de son premier usage.
+     */
+    static const ExecutionContext& standard();
+
+    /**
+     * Parcours parallèle d'un conteneur accessible par des itérateurs
+     * d'entrée, qui ne permettent pas de sauter directement à un élément : un
+     * seul thread parcourt le conteneur et crée une tâche par tronçon de 128
+     * éléments par thread, à la manière de la clause schedule(dynamic, size)
+     * des boucles for. Chaque tâche invoque chunk(debut, fin) sur le thread
+     * qui l'exécute : les tâches étant liées à leur thread, deux tâches ne
+     * peuvent modifier simultanément les données privées d'un même thread
+     * (repérées via omp_get_thread_num).
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] threads le nombre de threads de l'équipe.
+     * @param[in] chunk le traitement d'un tronçon, invoqué avec les
+     *   itérateurs repérant son premier élément et l'élément situé juste
+     *   derrière son dernier élément.
+     */
+    template< typename InputIterator, typename Chunk >
+    static void forEachChunk(const InputIterator& first,
+                             const InputIterator& last,
+                             const int& threads,
+                             const Chunk& chunk) {
+      const int taille = 128 * threads;
+#pragma omp parallel num_threads(threads)
+#pragma omp single
+      {
+        InputIterator debut = first;
+        while (debut != last) {
+          InputIterator fin = debut;
+          for (int i = 0; i != taille && fin != last; i ++) {
+            ++ fin;
+          }
+#pragma omp task firstprivate(debut, fin) shared(chunk)
+          chunk(debut, fin);
+          debut = fin;
+        }
+      }
+    } // forEachChunk
+
+  private:
+
+    /** Le nombre de threads de l'équipe. */
+    int threads_;
+
+    /** Le seuil de repli sur la version séquentielle. */
+    size_t threshold_;
+
+  }; // ExecutionContext
+
+} // paralgos
+
+#endif
@@ -0,0 +1,510 @@
+#ifndef ExternalSort_hpp
+#define ExternalSort_hpp
+
+#include "ParallelMergeSort.hpp"
+#include <functional>
+#include <algorithm>
+#include <type_traits>
+#include <future>
+#include <memory>
+#include <vector>
+#include <string>
+#include <omp.h>
+
+namespace sorting {
+
+  /**
+   * @class ExternalSort ExternalSort.hpp
+   *
+   * Tri externe d'un fichier d'enregistrements de taille fixe, éventuellement
+   * bien plus volumineux que la mémoire vive, en deux phases :
+   * - génération de suites triées : le fichier est lu par tronçons tenant
+   *   en mémoire, chacun étant trié par ParallelMergeSort puis écrit dans un
+   *   fichier temporaire, la lecture du tronçon suivant recouvrant le tri du
+   *   tronçon courant ;
+   * - fusion à k voies des suites triées, par blocs : chaque suite dispose de
+   *   deux blocs, l'un consommé par la fusion pendant que l'autre est lu en
+   *   arrière-plan, et le fichier cible de deux blocs, l'un rempli par la
+   *   fusion pendant que l'autre est écrit en arrière-plan.
+   *
+   * @note Les fichiers temporaires sont supprimés dès leur création : ils
+   *   disparaissent à la fermeture de leur descripteur, y compris en cas
+   *   d'erreur.
+   * @note Les erreurs d'accès aux fichiers sont signalées par une exception
+   *   de type std::system_error.
+   * @note Tout comme ParallelMergeSort, ce tri n'est pas stable.
+   */
+  class ExternalSort {
+  public:
+
+    /**
+     * Bilan d'un tri : volume traité et durée de chaque phase.
+     */
+    struct Report {
+
+      /** La taille du fichier trié en octets. */
+      size_t bytes;
+
+      /** Le nombre de suites triées générées. */
+      size_t runs;
+
+      /** La durée de la génération des suites triées en secondes. */
+      double runTime;
+
+      /** La durée de la fusion des suites triées en secondes. */
+      double mergeTime;
+
+    }; // Report
+
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in] input - le chemin du fichier à trier ;
+     * @param[in] output - le chemin du fichier trié (créé ou écrasé) ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les enregistrements ;
+     * @param[in] memory - la mémoire allouée au tri en octets ;
+     * @param[in] threads - le nombre de threads disponibles ;
+     * @param[in] tmpdir - le répertoire des fichiers temporaires.
+     * @return le bilan du tri.
+     */
+    template< typename T, typename Compare >
+    static Report apply(const std::string& input,
+			const std::string& output,
+			const Compare& comp,
+			const size_t& memory,
+			const int& threads,
+			const std::string& tmpdir = "/tmp") {
+
+      static_assert(std::is_trivially_copyable< T >::value,
+		    "ExternalSort : enregistrements de taille fixe uniquement");
+
+      Report report;
+      const File entree(input, File::READ);
+      report.bytes = entree.size() / sizeof(T) * sizeof(T);
+      const size_t n = report.bytes / sizeof(T);
+
+      // Génération des suites triées : deux tronçons alternativement lus et
+      // triés, plus le tampon de ParallelMergeSort.
+      const size_t troncon = std::max(memory / (3 * sizeof(T)), size_t(1));
+      std::vector< std::unique_ptr< File > > suites;
+      std::vector< size_t > longueurs;
+      double start = omp_get_wtime();
+      {
+	std::unique_ptr< T[] > courant(new T[std::min(troncon, n)]);
+	std::unique_ptr< T[] > suivant(new T[std::min(troncon, n)]);
+	std::future< size_t > lecture = read(entree, courant.get(), 0,
+					     std::min(troncon, n));
+	for (size_t offset = 0; offset < n; offset += troncon) {
+	  const size_t longueur = lecture.get();
+	  if (offset + troncon < n) {
+	    lecture = read(entree, suivant.get(), offset + troncon,
+			   std::min(troncon, n - offset - troncon));
+	  }
+	  ParallelMergeSort::apply(courant.get(), courant.get() + longueur,
+				   comp, LEAF, CUTOFF, threads);
+	  suites.emplace_back(new File(File::temporary(tmpdir)));
+	  suites.back()->write(courant.get(), longueur * sizeof(T), 0);
+	  longueurs.push_back(longueur);
+	  std::swap(courant, suivant);
+	}
+      }
+      double stop = omp_get_wtime();
+      report.runs = suites.size();
+      report.runTime = stop - start;
+
+      // Fusion à k voies : deux blocs par suite et deux pour le fichier
+      // cible.
+      start = omp_get_wtime();
+      {
+	const File sortie(output, File::WRITE);
+	const size_t k = suites.size();
+	const size_t bloc = std::max(memory / (2 * (k + 1) * sizeof(T)),
+				     size_t(1));
+	std::vector< std::unique_ptr< Reader< T > > > lecteurs;
+	for (size_t r = 0; r != k; r ++) {
+	  lecteurs.emplace_back(new Reader< T >(*suites[r], longueurs[r], bloc));
+	}
+	Writer< T > ecrivain(sortie, bloc);
+
+	// Un tas des suites non épuisées, ordonné par leur prochain
+	// enregistrement (à égalité, par rang de suite).
+	const auto plusGrand = [&lecteurs, &comp](const size_t& x,
+						  const size_t& y) -> bool {
+	  const T& a = lecteurs[x]->front();
+	  const T& b = lecteurs[y]->front();
+	  return comp(b, a) || (! comp(a, b) && y < x);
+	};
+	std::vector< size_t > tas;
+	for (size_t r = 0; r != k; r ++) {
+	  if (! lecteurs[r]->empty()) {
+	    tas.push_back(r);
+	  }
+	}
+	std::make_heap(tas.begin(), tas.end(), plusGrand);
+	while (! tas.empty()) {
+	  std::pop_heap(tas.begin(), tas.end(), plusGrand);
+	  Reader< T >& lecteur = *lecteurs[tas.back()];
+	  ecrivain.push(lecteur.front());
+	  lecteur.pop();
+	  if (lecteur.empty()) {
+	    tas.pop_back();
+	  } else {
+	    std::push_heap(tas.begin(), tas.end(), plusGrand);
+	  }
+	}
+	ecrivain.close();
+      }
+      stop = omp_get_wtime();
+      report.mergeTime = stop - start;
+
+      // C'est terminé.
+      return report;
+
+    } // apply
+
+    /**
+     * Forme spécifique de l'algorithme pour la relation d'ordre total
+     * strictement inférieur à.
+     *
+     * @param[in] input - le chemin du fichier à trier ;
+     * @param[in] output - le chemin du fichier trié (créé ou écrasé) ;
+     * @param[in] memory - la mémoire allouée au tri en octets ;
+     * @param[in] threads - le nombre de threads disponibles ;
+     * @param[in] tmpdir - le répertoire des fichiers temporaires.
+     * @return le bilan du tri.
+     */
+    template< typename T >
+    static Report apply(const std::string& input,
+			const std::string& output,
+			const size_t& memory,
+			const int& threads,
+			const std::string& tmpdir = "/tmp") {
+      return apply< T >(input, output, std::less< const T& >(),
+			memory, threads, tmpdir);
+    } // apply
+
+  private:
+
+    /**
+     * @class File ExternalSort.hpp
+     *
+     * Un fichier ouvert, fermé à la destruction de l'objet. Les lectures et
+     * écritures sont positionnées (pread et pwrite) et peuvent donc être
+     * concurrentes.
+     */
+    class File {
+    public:
+
+      /**
+       * Les modes d'ouverture.
+       */
+      enum Mode {
+	READ,  ///< Lecture seule.
+	WRITE  ///< Écriture seule (le fichier est créé ou tronqué).
+      };
+
+      /**
+       * Constructeur : ouvre un fichier.
+       *
+       * @param[in] path le chemin du fichier.
+       * @param[in] mode le mode d'ouverture.
+       */
+      File(const std::string& path, const Mode& mode);
+
+      /**
+       * Constructeur par déplacement.
+       */
+      File(File&& other);
+
+      /**
+       * Destructeur.
+       */
+      ~File();
+
+      /**
+       * Crée un fichier temporaire anonyme (supprimé dès sa création), ouvert
+       * en lecture et en écriture.
+       *
+       * @param[in] dir le répertoire du fichier.
+       * @return le fichier.
+       */
+      static File temporary(const std::string& dir);
+
+      /**
+       * @return la taille du fichier en octets.
+       */
+      size_t size() const;
+
+      /**
+       * Lit des octets, jusqu'à la fin du fichier le cas échéant.
+       *
+       * @param[out] buf le tampon cible.
+       * @param[in] length le nombre d'octets à lire.
+       * @param[in] offset la position du premier octet à lire.
+       * @return le nombre d'octets lus.
+       */
+      size_t read(void* buf, const size_t& length, const size_t& offset) const;
+
+      /**
+       * Écrit des octets.
+       *
+       * @param[in] buf le tampon source.
+       * @param[in] length le nombre d'octets à écrire.
+       * @param[in] offset la position du premier octet à écrire.
+       */
+      void write(const void* buf,
+		 const size_t& length,
+		 const size_t& offset) const;
+
+    private:
+
+      /**
+       * Constructeur : adopte un descripteur ouvert.
+       */
+      File(const int& fd, const std::string& path);
+
+      // Un fichier ne peut être copié.
+      File(const File&) = delete;
+      File& operator=(const File&) = delete;
+
+      /** Le descripteur du fichier. */
+      int fd_;
+
+      /** Le chemin du fichier (pour les messages d'erreur). */
+      std::string path_;
+
+    }; // File
+
+    /**
+     * Lit des enregistrements en arrière-plan.
+     *
+     * @param[in] file le fichier.
+     * @param[out] buf le tampon cible.
+     * @param[in] first le rang du premier enregistrement à lire.
+     * @param[in] count le nombre d'enregistrements à lire.
+     * @return le nombre d'enregistrements lus, une fois la lecture terminée.
+     */
+    template< typename T >
+    static std::future< size_t > read(const File& file,
+				      T* buf,
+				      const size_t& first,
+				      const size_t& count) {
+      return std::async(std::launch::async, [&file, buf, first, count]() {
+	  return file.read(buf, count * sizeof(T), first * sizeof(T))
+	    / sizeof(T);
+	});
+    } // read
+
+    /**
+     * @class Reader ExternalSort.hpp
+     *
+     * Lecture séquentielle d'une suite triée par blocs, en double tampon :
+     * le bloc suivant est lu en arrière-plan pendant la consommation du bloc
+     * courant.
+     */
+    template< typename T >
+    class Reader {
+    public:
+
+      /**
+       * Constructeur : lance la lecture du premier bloc.
+       *
+       * @param[in] file le fichier de la suite.
+       * @param[in] length le nombre d'enregistrements de la suite.
+       * @param[in] block le nombre d'enregistrements d'un bloc.
+       */
+      Reader(const File& file, const size_t& length, const size_t& block)
+	: file_(file), length_(length), block_(std::min(block, length)),
+	  next_(0), courant_(new T[block_]), suivant_(new T[block_]),
+	  taille_(0), pos_(0) {
+	prefetch();
+	refill();
+      }
+
+      /**
+       * @return @c true si la suite est épuisée.
+       */
+      bool empty() const {
+	return pos_ == taille_;
+      } // empty
+
+      /**
+       * @return le prochain enregistrement de la suite.
+       */
+      const T& front() const {
+	return courant_[pos_];
+      } // front
+
+      /**
+       * Consomme le prochain enregistrement de la suite.
+       */
+      void pop() {
+	++ pos_;
+	if (pos_ == taille_) {
+	  refill();
+	}
+      } // pop
+
+    private:
+
+      /**
+       * Lance la lecture du bloc suivant, s'il en reste un.
+       */
+      void prefetch() {
+	if (next_ < length_) {
+	  const size_t count = std::min(block_, length_ - next_);
+	  lecture_ = ExternalSort::read(file_, suivant_.get(), next_, count);
+	  next_ += count;
+	}
+      } // prefetch
+
+      /**
+       * Attend la lecture du bloc suivant, qui devient le bloc courant, puis
+       * lance celle du bloc d'après.
+       */
+      void refill() {
+	if (! lecture_.valid()) {
+	  taille_ = pos_ = 0;
+	  return;
+	}
+	taille_ = lecture_.get();
+	pos_ = 0;
+	std::swap(courant_, suivant_);
+	prefetch();
+      } // refill
+
+      /** Le fichier de la suite. */
+      const File& file_;
+
+      /** Le nombre d'enregistrements de la suite. */
+      const size_t length_;
+
+      /** Le nombre d'enregistrements d'un bloc. */
+      const size_t block_;
+
+      /** Le rang du premier enregistrement non encore demandé. */
+      size_t next_;
+
+      /** Le bloc courant et le bloc suivant. */
+      std::unique_ptr< T[] > courant_, suivant_;
+
+      /** Le nombre d'enregistrements du bloc courant. */
+      size_t taille_;
+
+      /** La position du prochain enregistrement dans le bloc courant. */
+      size_t pos_;
+
+      /** La lecture en cours du bloc suivant. */
+      std::future< size_t > lecture_;
+
+    }; // Reader
+
+    /**
+     * @class Writer ExternalSort.hpp
+     *
+     * Écriture séquentielle d'un fichier par blocs, en double tampon : le
+     * bloc plein est écrit en arrière-plan pendant le remplissage de l'autre.
+     */
+    template< typename T >
+    class Writer {
+    public:
+
+      /**
+       * Constructeur.
+       *
+       * @param[in] file le fichier.
+       * @param[in] block le nombre d'enregistrements d'un bloc.
+       */
+      Writer(const File& file, const size_t& block)
+	: file_(file), block_(block), courant_(new T[block]),
+	  suivant_(new T[block]), pos_(0), offset_(0) {
+      }
+
+      /**
+       * Destructeur : attend la fin de l'écriture en cours, le cas échéant.
+       */
+      ~Writer() {
+	if (ecriture_.valid()) {
+	  ecriture_.wait();
+	}
+      }
+
+      /**
+       * Ajoute un enregistrement au fichier.
+       *
+       * @param[in] x l'enregistrement.
+       */
+      void push(const T& x) {
+	courant_[pos_ ++] = x;
+	if (pos_ == block_) {
+	  flush();
+	}
+      } // push
+
+      /**
+       * Écrit les enregistrements restants et attend la fin des écritures.
+       */
+      void close() {
+	flush();
+	if (ecriture_.valid()) {
+	  ecriture_.get();
+	}
+      } // close
+
+    private:
+
+      /**
+       * Attend la fin de l'écriture précédente puis lance celle du bloc
+       * courant.
+       */
+      void flush() {
+	if (ecriture_.valid()) {
+	  ecriture_.get();
+	}
+	if (pos_ == 0) {
+	  return;
+	}
+	std::swap(courant_, suivant_);
+	const File& file = file_;
+	const T* const buf = suivant_.get();
+	const size_t length = pos_ * sizeof(T), offset = offset_;
+	ecriture_ = std::async(std::launch::async,
+			       [&file, buf, length, offset]() {
+				 file.write(buf, length, offset);
+			       });
+	offset_ += length;
+	pos_ = 0;
+      } // flush
+
+      /** Le fichier. */
+      const File& file_;
+
+      /** Le nombre d'enregistrements d'un bloc. */
+      const size_t block_;
+
+      /** Le bloc en cours de remplissage et le bloc en cours d'écriture. */
+      std::unique_ptr< T[] > courant_, suivant_;
+
+      /** Le nombre d'enregistrements du bloc en cours de remplissage. */
+      size_t pos_;
+
+      /** La position dans le fichier du prochain bloc à écrire. */
+      size_t offset_;
+
+      /** L'écriture en cours. */
+      std::future< void > ecriture_;
+
+    }; // Writer
+
+    /** Taille des feuilles de ParallelMergeSort. */
+    static const size_t LEAF = 16 * 1024;
+
+    /** Tolérance des fusions de ParallelMergeSort. */
+    static const size_t CUTOFF = 8 * 1024;
+
+  }; // ExternalSort
+
+} // sorting
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef FileCount_hpp
+#define FileCount_hpp
+
+#include "SimdCount.hpp"
+#include "ExecutionContext.hpp"
+#include <omp.h>
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
+#include <string>
+
+namespace paralgos {
+
+  /**
+   * @class FileCount FileCount.hpp
+   *
+   * Version de l'algorithme count dédiée aux fichiers, éventuellement bien
+   * plus volumineux que la mémoire vive : le fichier est projeté en mémoire
+   * (mmap) puis découpé en tronçons alignés sur les pages, répartis
+   * dynamiquement entre les threads. Le fichier est vu comme une suite
+   * d'enregistrements de taille fixe (des octets, des entiers, des
+   * structures, ...).
+   *
+   * @note Les octets situés au-delà du dernier enregistrement complet sont
+   *   ignorés.
+   * @note Les erreurs d'accès au fichier sont signalées par une exception de
+   *   type std::system_error.
+   */
+  class FileCount {
+  public:
+
+    /**
+     * Forme générale de l'algorithme, exécutée au sein du contexte par défaut.
+     *
+     * @param[in] path le chemin du fichier.
+     * @param[in] val l'enregistrement recherché.
+     * @return le nombre d'occurrences de l'enregistrement recherché.
+     */
+    template< typename T >
+    static size_t apply(const std::string& path, const T& val) {
+      return apply(path, val, ExecutionContext::standard());
+    } // apply
+
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in] path le chemin du fichier.
+     * @param[in] val l'enregistrement recherché. Les enregistrements de type
+     *   arithmétique (octets compris) sont comparés par les noyaux
+     *   vectoriels de SimdCount, sauf les long double, comparés par
+     *   l'opérateur ==, les autres octet à octet.
+     * @param[in] context le contexte d'exécution.
+     * @return le nombre d'occurrences de l'enregistrement recherché.
+     */
+    template< typename T >
+    static size_t apply(const std::string& path,
+                        const T& val,
+                        const ExecutionContext& context) {
+
+      static_assert(std::is_trivially_copyable< T >::value,
+                    "FileCount : enregistrements de taille fixe uniquement");
+
+      // Projection du fichier en mémoire.
+      const Mapping file(path);
+      const size_t n = file.size() / sizeof(T);
+      if (n == 0) {
+        return 0;
+      }
+      const T* x = static_cast< const T* >(file.data());
+
+      // Découpage en tronçons alignés à la fois sur les pages et sur les
+      // enregistrements.
+      const size_t taille = file.chunk(sizeof(T)) / sizeof(T);
+      const long chunks = (n + taille - 1) / taille;
+      const int threads = context.sequential(n) ? 1 : context.threads();
+
+      // Le nombre d'occurrences.
+      size_t acc = 0;
+
+#pragma omp parallel for schedule(dynamic) reduction(+: acc) num_threads(threads)
+      for (long c = 0; c < chunks; c ++) {
+        const size_t lo = c * taille;
+        const size_t hi = std::min(n, lo + taille);
+
+        // Les tronçons étant distribués dans l'ordre, le tronçon c + threads
+        // sera entamé dès qu'un des tronçons en cours sera terminé : il est
+        // annoncé au noyau afin d'être chargé pendant le comptage de
+        // celui-ci (le tronçon courant, lui, est déjà en cours de lecture).
+        if (c + threads < chunks) {
+          const size_t suivant = (c + threads) * taille;
+          file.willNeed(suivant * sizeof(T),
+                        (std::min(n, suivant + taille) - suivant) * sizeof(T));
+        }
+        acc += count(x + lo, hi - lo, val,
+                     typename SimdCount::Category< const T*, T >::type(),
+                     std::is_arithmetic< T >());
+      }
+
+      // C'est terminé.
+      return acc;
+
+    } // apply
+
+  private:
+
+    /**
+     * Compte les occurrences d'un enregistrement arithmétique dans un
+     * tronçon via les noyaux vectoriels.
+     */
+    template< typename T >
+    static size_t count(const T x[],
+                        const size_t& n,
+                        const T& val,
+                        const contiguous_arithmetic_iterator_tag&,
+                        const std::true_type&) {
+      return SimdCount::apply(x, n, val);
+    } // count
+
+    /**
+     * Compte les occurrences d'un enregistrement arithmétique dépourvu de
+     * noyau vectoriel (long double) dans un tronçon via l'opérateur ==, ses
+     * octets de remplissage interdisant la comparaison octet à octet.
+     */
+    template< typename T >
+    static size_t count(const T x[],
+                        const size_t& n,
+                        const T& val,
+                        const std::random_access_iterator_tag&,
+                        const std::true_type&) {
+      return std::count(x, x + n, val);
+    } // count
+
+    /**
+     * Compte les occurrences d'un enregistrement quelconque dans un tronçon
+     * en comparant les enregistrements octet à octet.
+     */
+    template< typename T >
+    static size_t count(const T x[],
+                        const size_t& n,
+                        const T& val,
+                        const std::random_access_iterator_tag&,
+                        const std::false_type&) {
+      size_t acc = 0;
+      for (size_t i = 0; i != n; i ++) {
+        acc += std::memcmp(x + i, &val, sizeof(T)) == 0;
+      }
+      return acc;
+    } // count
+
+    /**
+     * @class Mapping FileCount.hpp
+     *
+     * Projection en lecture seule d'un fichier en mémoire, libérée à la
+     * destruction de l'objet.
+     */
+    class Mapping {
+    public:
+
+      /**
+       * Constructeur : ouvre puis projette le fichier en mémoire, en
+       * annonçant au noyau une lecture séquentielle.
+       *
+       * @param[in] path le chemin du fichier.
+       */
+      explicit Mapping(const std::string& path);
+
+      /**
+       * Destructeur.
+       */
+      ~Mapping();
+
+      /**
+       * @return l'adresse du premier octet du fichier.
+       */
+      const void* data() const;
+
+      /**
+       * @return la taille du fichier en octets.
+       */
+      const size_t& size() const;
+
+      /**
+       * Calcule la taille des tronçons à répartir entre les threads : un
+       * multiple à la fois de la taille des pages et de celle des
+       * enregistrements.
+       *
+       * @param[in] record la taille d'un enregistrement en octets.
+       * @return la taille d'un tronçon en octets.
+       */
+      size_t chunk(const size_t& record) const;
+
+      /**
+       * Annonce au noyau la lecture prochaine d'une partie du fichier afin
+       * qu'il la charge par anticipation.
+       *
+       * @param[in] offset la position du premier octet concerné.
+       * @param[in] length le nombre d'octets concernés.
+       */
+      void willNeed(const size_t& offset, const size_t& length) const;
+
+    private:
+
+      // Une projection ne peut être copiée.
+      Mapping(const Mapping&) = delete;
+      Mapping& operator=(const Mapping&) = delete;
+
+      /** L'adresse de la projection. */
+      void* data_;
+
+      /** La taille du fichier en octets. */
+      size_t size_;
+
+    }; // Mapping
+
+  }; // FileCount
+
+} // paralgos
+
+#endif
@@ -0,0 +1,733 @@
+#ifndef Histogram_hpp
+#define Histogram_hpp
+
+#include "ExecutionContext.hpp"
+#include <omp.h>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+namespace paralgos {
+
+  /**
+   * @class HashedCounts Histogram.hpp
+   *
+   * Table de hachage des nombres d'occurrences, partagée en tables
+   * disjointes (shards) : la valeur k est rangée dans la table d'indice
+   * hash(k) modulo le nombre de tables. Chaque table peut ainsi être remplie
+   * ou fusionnée par un thread différent, sans verrou ni réunion finale.
+   * L'interface reprend celle de std::unordered_map pour les opérations
+   * usuelles (accès, recherche, suppression, parcours).
+   */
+  template< typename Key, typename Size >
+  class HashedCounts {
+  public:
+
+    /** Type d'une table. */
+    typedef std::unordered_map< Key, Size > Shard;
+
+    /** Types synonymes de ceux de std::unordered_map. */
+    typedef typename Shard::key_type key_type;
+    typedef typename Shard::mapped_type mapped_type;
+    typedef typename Shard::value_type value_type;
+    typedef typename Shard::hasher hasher;
+    typedef size_t size_type;
+
+    /**
+     * Itérateur parcourant les tables l'une après l'autre.
+     */
+    template< typename Shards, typename Inner >
+    class Iterator {
+    public:
+
+      // Déclaration d'amitié envers la table : seule cette dernière accède à
+      // la position de l'itérateur.
+      friend class HashedCounts;
+
+      /** Types requis par std::iterator_traits. */
+      typedef std::forward_iterator_tag iterator_category;
+      typedef typename std::iterator_traits< Inner >::value_type value_type;
+      typedef typename std::iterator_traits< Inner >::difference_type
+        difference_type;
+      typedef typename std::iterator_traits< Inner >::pointer pointer;
+      typedef typename std::iterator_traits< Inner >::reference reference;
+
+      /** Constructeur d'un itérateur singulier. */
+      Iterator() : shards_(nullptr), s_(0), it_() {}
+
+      reference operator*() const { return *it_; }
+
+      pointer operator->() const { return &*it_; }
+
+      Iterator& operator++() {
+        ++ it_;
+        skip();
+        return *this;
+      }
+
+      Iterator operator++(int) {
+        Iterator tmp = *this;
+        ++ *this;
+        return tmp;
+      }
+
+      bool operator==(const Iterator& rhs) const {
+        return s_ == rhs.s_ && (s_ == shards_->size() || it_ == rhs.it_);
+      }
+
+      bool operator!=(const Iterator& rhs) const { return ! (*this == rhs); }
+
+    private:
+
+      /**
+       * Constructeur.
+       *
+       * @param[in] shards les tables.
+       * @param[in] s l'indice de la table courante (le nombre de tables pour
+       *   l'itérateur de fin).
+       * @param[in] it la position dans la table courante.
+       */
+      Iterator(Shards* shards, const size_t& s, const Inner& it)
+        : shards_(shards), s_(s), it_(it) {
+        skip();
+      }
+
+      /**
+       * Passe les fins de tables jusqu'au prochain élément ou à la fin de la
+       * dernière table.
+       */
+      void skip() {
+        while (s_ != shards_->size() && it_ == (*shards_)[s_].end()) {
+          if (++ s_ != shards_->size()) {
+            it_ = (*shards_)[s_].begin();
+          }
+        }
+      }
+
+      /** Les tables. */
+      Shards* shards_;
+
+      /** L'indice de la table courante. */
+      size_t s_;
+
+      /** La position dans la table courante. */
+      Inner it_;
+
+    }; // Iterator
+
+    /** Types des itérateurs. */
+    typedef Iterator< std::vector< Shard >, typename Shard::iterator >
+      iterator;
+    typedef Iterator< const std::vector< Shard >,
+                      typename Shard::const_iterator > const_iterator;
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] shards le nombre de tables (au moins une).
+     */
+    explicit HashedCounts(const size_t& shards = 1)
+      : shards_(std::max(shards, size_t(1))) {}
+
+    /** @return le nombre de valeurs distinctes. */
+    size_t size() const {
+      size_t acc = 0;
+      for (size_t s = 0; s != shards_.size(); s ++) {
+        acc += shards_[s].size();
+      }
+      return acc;
+    }
+
+    /** @return @c true si aucune valeur n'est comptée. */
+    bool empty() const { return size() == 0; }
+
+    /** Retire toutes les valeurs. */
+    void clear() {
+      for (size_t s = 0; s != shards_.size(); s ++) {
+        shards_[s].clear();
+      }
+    }
+
+    /**
+     * @param[in] k une valeur.
+     * @return le nombre d'occurrences de la valeur, créé nul s'il est
+     *   absent.
+     */
+    Size& operator[](const Key& k) { return shards_[shard(k)][k]; }
+
+    /**
+     * @param[in] k une valeur.
+     * @return un itérateur repérant la valeur, ou end() si elle est absente.
+     */
+    iterator find(const Key& k) {
+      const size_t s = shard(k);
+      return iterator(&shards_, s, shards_[s].find(k));
+    }
+
+    /**
+     * @param[in] k une valeur.
+     * @return un itérateur repérant la valeur, ou end() si elle est absente.
+     */
+    const_iterator find(const Key& k) const {
+      const size_t s = shard(k);
+      return const_iterator(&shards_, s, shards_[s].find(k));
+    }
+
+    /**
+     * Retire une valeur.
+     *
+     * @param[in] pos un itérateur repérant la valeur.
+     * @return un itérateur repérant la valeur suivante.
+     */
+    iterator erase(const iterator& pos) {
+      return iterator(&shards_, pos.s_, shards_[pos.s_].erase(pos.it_));
+    }
+
+    iterator begin() { return iterator(&shards_, 0, shards_[0].begin()); }
+
+    iterator end() {
+      return iterator(&shards_, shards_.size(), typename Shard::iterator());
+    }
+
+    const_iterator begin() const {
+      return const_iterator(&shards_, 0, shards_[0].begin());
+    }
+
+    const_iterator end() const {
+      return const_iterator(&shards_, shards_.size(),
+                            typename Shard::const_iterator());
+    }
+
+    /** @return le nombre de tables. */
+    size_t shards() const { return shards_.size(); }
+
+    /**
+     * @param[in] k une valeur.
+     * @return l'indice de la table où ranger la valeur.
+     */
+    size_t shard(const Key& k) const {
+      return hasher()(k) % shards_.size();
+    }
+
+    /**
+     * @param[in] s l'indice d'une table.
+     * @return la table.
+     */
+    Shard& part(const size_t& s) { return shards_[s]; }
+
+    /**
+     * @param[in] s l'indice d'une table.
+     * @return la table.
+     */
+    const Shard& part(const size_t& s) const { return shards_[s]; }
+
+  private:
+
+    /** Les tables. */
+    std::vector< Shard > shards_;
+
+  }; // HashedCounts
+
+  /**
+   * @class Histogram Histogram.hpp
+   *
+   * Compte, en une seule passe et en parallèle, les occurrences de chacune
+   * des valeurs distinctes d'un conteneur (soit l'équivalent d'un appel à
+   * Count::apply par valeur distincte).
+   *
+   * @note Chaque thread remplit ses propres compteurs (privatisation), qui
+   *   sont ensuite fusionnés en parallèle. Ces compteurs sont denses (un
+   *   tableau indexé par la valeur) lorsque l'intervalle des valeurs est
+   *   petit, c'est à dire s'il est fourni par l'utilisateur ou si les valeurs
+   *   sont des entiers d'au plus 16 bits, et hachés (une table de hachage)
+   *   sinon.
+   * @note Les compteurs hachés de chaque thread sont partagés en autant de
+   *   tables que de threads (cf. HashedCounts) : la table r du résultat
+   *   n'est issue que des tables r de chaque thread et est fusionnée par un
+   *   seul thread, le résultat étant rendu sous cette forme partagée.
+   */
+  class Histogram {
+  public:
+
+    /**
+     * Forme générale de l'algorithme, exécutée au sein du contexte par défaut.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @return le nombre d'occurrences de chacune des valeurs présentes.
+     */
+    template< typename InputIterator >
+    static HashedCounts<
+      typename std::iterator_traits< InputIterator >::value_type,
+      typename std::iterator_traits< InputIterator >::difference_type >
+    apply(const InputIterator& first, const InputIterator& last) {
+      return apply(first, last, ExecutionContext::standard());
+    } // apply
+
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] context le contexte d'exécution.
+     * @return le nombre d'occurrences de chacune des valeurs présentes.
+     */
+    template< typename InputIterator >
+    static HashedCounts<
+      typename std::iterator_traits< InputIterator >::value_type,
+      typename std::iterator_traits< InputIterator >::difference_type >
+    apply(const InputIterator& first,
+          const InputIterator& last,
+          const ExecutionContext& context) {
+
+      // Les entiers d'au plus 16 bits disposent de compteurs denses.
+      typedef typename std::iterator_traits< InputIterator >::value_type Key;
+      typedef std::integral_constant< bool,
+                                      std::is_integral< Key >::value
+                                      && sizeof(Key) <= 2 > Dense;
+      return apply(first, last, context, Dense());
+
+    } // apply
+
+    /**
+     * Forme de l'algorithme pour des entiers dont l'intervalle est connu,
+     * exécutée au sein du contexte par défaut.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] lo la plus petite valeur à compter.
+     * @param[in] hi la plus grande valeur à compter.
+     * @return le tableau des hi - lo + 1 nombres d'occurrences, celui de la
+     *   valeur v étant rangé à l'indice v - lo. Les valeurs situées hors de
+     *   l'intervalle [lo, hi] sont ignorées.
+     */
+    template< typename InputIterator, typename Key >
+    static std::vector<
+      typename std::iterator_traits< InputIterator >::difference_type >
+    apply(const InputIterator& first,
+          const InputIterator& last,
+          const Key& lo,
+          const Key& hi) {
+      return apply(first, last, lo, hi, ExecutionContext::standard());
+    } // apply
+
+    /**
+     * Forme de l'algorithme pour des entiers dont l'intervalle est connu.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] lo la plus petite valeur à compter.
+     * @param[in] hi la plus grande valeur à compter.
+     * @param[in] context le contexte d'exécution.
+     * @return le tableau des hi - lo + 1 nombres d'occurrences, celui de la
+     *   valeur v étant rangé à l'indice v - lo. Les valeurs situées hors de
+     *   l'intervalle [lo, hi] sont ignorées.
+     * @throw std::invalid_argument si hi est inférieur à lo.
+     * @throw std::length_error si les hi - lo + 1 compteurs ne tiennent pas
+     *   dans un tableau.
+     */
+    template< typename InputIterator, typename Key >
+    static std::vector<
+      typename std::iterator_traits< InputIterator >::difference_type >
+    apply(const InputIterator& first,
+          const InputIterator& last,
+          const Key& lo,
+          const Key& hi,
+          const ExecutionContext& context) {
+
+      static_assert(std::is_integral< Key >::value,
+                    "Histogram : compteurs denses réservés aux entiers");
+
+      // Types synonymes.
+      typedef std::iterator_traits< InputIterator > Traits;
+      typedef typename Traits::difference_type Size;
+      typedef Impl< typename Traits::iterator_category > Impl;
+
+      // Remplissage des compteurs privés de chaque thread.
+      const int threads = Impl::threads(first, last, context);
+      std::vector< DenseBins< Key, Size > >
+        bins(threads, DenseBins< Key, Size >(lo, hi));
+      Impl::apply(first, last, bins);
+
+      // Fusion.
+      return merge(bins);
+
+    } // apply
+
+  private:
+
+    /**
+     * Compteurs denses : un compteur par valeur de l'intervalle [lo, hi].
+     */
+    template< typename Key, typename Size >
+    class DenseBins {
+    public:
+
+      /**
+       * Constructeur.
+       *
+       * @param[in] lo la plus petite valeur à compter.
+       * @param[in] hi la plus grande valeur à compter.
+       */
+      DenseBins(const Key& lo, const Key& hi)
+        : lo_(lo), hi_(hi), counts_(size(lo, hi)) {}
+
+      /**
+       * Compte une occurrence de la valeur k.
+       *
+       * @param[in] k la valeur.
+       */
+      void add(const Key& k) {
+        if (lo_ <= k && k <= hi_) {
+          counts_[size_t(UKey(UKey(k) - UKey(lo_)))] ++;
+        }
+      }
+
+      /**
+       * Type non signé de même taille que les valeurs, dans lequel l'écart
+       * entre deux valeurs est calculé sans dépassement (modulo 2^N).
+       */
+      typedef typename std::conditional< std::is_same< Key, bool >::value,
+                                         std::common_type< unsigned char >,
+                                         std::make_unsigned< Key > >::
+        type::type UKey;
+
+      /**
+       * @param[in] lo la plus petite valeur à compter.
+       * @param[in] hi la plus grande valeur à compter.
+       * @return le nombre de compteurs, hi - lo + 1.
+       * @throw std::invalid_argument si hi est inférieur à lo.
+       * @throw std::length_error si les compteurs ne tiennent pas dans un
+       *   tableau.
+       */
+      static size_t size(const Key& lo, const Key& hi) {
+        if (hi < lo) {
+          throw std::invalid_argument("Histogram : intervalle [lo, hi] vide");
+        }
+        const UKey ecart = UKey(UKey(hi) - UKey(lo));
+        if (ecart >= std::vector< Size >().max_size()) {
+          throw std::length_error("Histogram : intervalle [lo, hi] trop "
+                                  "large pour des compteurs denses");
+        }
+        return size_t(ecart) + 1;
+      }
+
+      /** La plus petite valeur comptée. */
+      Key lo_;
+
+      /** La plus grande valeur comptée. */
+      Key hi_;
+
+      /** Les compteurs. */
+      std::vector< Size > counts_;
+
+    }; // DenseBins
+
+    /**
+     * Compteurs hachés : un compteur par valeur rencontrée, rangé dès le
+     * comptage dans la table correspondant à son haché.
+     */
+    template< typename Key, typename Size >
+    class HashedBins {
+    public:
+
+      /**
+       * Constructeur.
+       *
+       * @param[in] shards le nombre de tables.
+       */
+      explicit HashedBins(const size_t& shards) : counts_(shards) {}
+
+      /**
+       * Compte une occurrence de la valeur k.
+       *
+       * @param[in] k la valeur.
+       */
+      void add(const Key& k) {
+        counts_[k] ++;
+      }
+
+      /** Les compteurs. */
+      HashedCounts< Key, Size > counts_;
+
+    }; // HashedBins
+
+    /**
+     * Implémentation de cet algorithme pour un nombre de valeurs
+     * potentiellement grand : compteurs hachés.
+     */
+    template< typename InputIterator >
+    static HashedCounts<
+      typename std::iterator_traits< InputIterator >::value_type,
+      typename std::iterator_traits< InputIterator >::difference_type >
+    apply(const InputIterator& first,
+          const InputIterator& last,
+          const ExecutionContext& context,
+          const std::false_type&) {
+
+      // Types synonymes.
+      typedef std::iterator_traits< InputIterator > Traits;
+      typedef typename Traits::value_type Key;
+      typedef typename Traits::difference_type Size;
+      typedef Impl< typename Traits::iterator_category > Impl;
+
+      // Remplissage des compteurs privés de chaque thread.
+      const int threads = Impl::threads(first, last, context);
+      std::vector< HashedBins< Key, Size > >
+        bins(threads, HashedBins< Key, Size >(threads));
+      Impl::apply(first, last, bins);
+
+      // Fusion.
+      return merge(bins);
+
+    } // apply
+
+    /**
+     * Implémentation de cet algorithme pour les entiers d'au plus 16 bits :
+     * compteurs denses couvrant toutes les valeurs possibles.
+     */
+    template< typename InputIterator >
+    static HashedCounts<
+      typename std::iterator_traits< InputIterator >::value_type,
+      typename std::iterator_traits< InputIterator >::difference_type >
+    apply(const InputIterator& first,
+          const InputIterator& last,
+          const ExecutionContext& context,
+          const std::true_type&) {
+
+      // Types synonymes.
+      typedef std::iterator_traits< InputIterator > Traits;
+      typedef typename Traits::value_type Key;
+      typedef typename Traits::difference_type Size;
+
+      // Comptage dense sur l'ensemble des valeurs du type.
+      const Key lo = std::numeric_limits< Key >::min();
+      const Key hi = std::numeric_limits< Key >::max();
+      const std::vector< Size > counts = apply(first, last, lo, hi, context);
+
+      // Seules les valeurs présentes figurent dans le résultat : chaque
+      // thread remplit une table.
+      const int threads =
+        context.sequential(counts.size()) ? 1 : context.threads();
+      HashedCounts< Key, Size > result(threads);
+      const long n = counts.size();
+#pragma omp parallel for schedule(static, 1) num_threads(threads)
+      for (int r = 0; r < threads; r ++) {
+        typename HashedCounts< Key, Size >::Shard& shard = result.part(r);
+        for (long i = 0; i < n; i ++) {
+          const Key k = Key(lo + i);
+          if (counts[i] != 0 && result.shard(k) == size_t(r)) {
+            shard[k] = counts[i];
+          }
+        }
+      }
+      return result;
+
+    } // apply
+
+    /**
+     * Fusion en parallèle des compteurs denses : chaque thread somme un bloc
+     * de compteurs.
+     *
+     * @param[in] bins les compteurs privés de chaque thread.
+     * @return les compteurs fusionnés.
+     */
+    template< typename Key, typename Size >
+    static std::vector< Size >
+    merge(std::vector< DenseBins< Key, Size > >& bins) {
+      const int threads = bins.size();
+      if (threads == 1) {
+        return std::move(bins[0].counts_);
+      }
+      std::vector< Size > result(bins[0].counts_.size());
+      const long n = result.size();
+#pragma omp parallel for schedule(static) num_threads(threads)
+      for (long i = 0; i < n; i ++) {
+        Size acc = 0;
+        for (int r = 0; r != threads; r ++) {
+          acc += bins[r].counts_[i];
+        }
+        result[i] = acc;
+      }
+      return result;
+    } // merge
+
+    /**
+     * Fusion en parallèle des compteurs hachés : la table r du résultat est
+     * la réunion des tables r de chaque thread, disjointes de toutes les
+     * autres, et n'est fusionnée que par un thread.
+     *
+     * @param[in] bins les compteurs privés de chaque thread.
+     * @return les compteurs fusionnés.
+     */
+    template< typename Key, typename Size >
+    static HashedCounts< Key, Size >
+    merge(std::vector< HashedBins< Key, Size > >& bins) {
+      typedef typename HashedCounts< Key, Size >::Shard Shard;
+      const int threads = bins.size();
+      if (threads == 1) {
+        return std::move(bins[0].counts_);
+      }
+      HashedCounts< Key, Size > result(threads);
+#pragma omp parallel for schedule(static, 1) num_threads(threads)
+      for (int r = 0; r < threads; r ++) {
+
+        // La plus grande des tables r sert de base à la fusion.
+        int base = 0;
+        for (int t = 1; t != threads; t ++) {
+          if (bins[t].counts_.part(r).size()
+              > bins[base].counts_.part(r).size()) {
+            base = t;
+          }
+        }
+        Shard& shard = result.part(r);
+        shard = std::move(bins[base].counts_.part(r));
+        for (int t = 0; t != threads; t ++) {
+          if (t != base) {
+            for (const auto& bin : bins[t].counts_.part(r)) {
+              shard[bin.first] += bin.second;
+            }
+          }
+        }
+      }
+      return result;
+    } // merge
+
+  public:
+
+    /**
+     * Implémentation du remplissage des compteurs dédiée aux InputIterator.
+     */
+    template< typename Category >
+    class Impl {
+    public:
+
+      // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+      // invoquer les méthodes de classe privées.
+      friend class Histogram;
+
+    private:
+
+      /**
+       * Détermine le nombre de threads à employer.
+       *
+       * @param[in] first un itérateur repérant le premier élément à traiter.
+       * @param[in] last un itérateur repérant l'élément situé juste derrière
+       *   le dernier élément à traiter.
+       * @param[in] context le contexte d'exécution.
+       * @return le nombre de threads de l'équipe (le nombre d'éléments ne
+       *   pouvant être calculé sans un coût prohibitif).
+       */
+      template< typename InputIterator >
+      static int threads(const InputIterator&,
+                         const InputIterator&,
+                         const ExecutionContext& context) {
+        return context.threads();
+      } // threads
+
+      /**
+       * Remplissage des compteurs : chaque tâche créée par
+       * ExecutionContext::forEachChunk incrémente les compteurs du thread qui
+       * l'exécute.
+       *
+       * @param[in] first un itérateur repérant le premier élément à traiter.
+       * @param[in] last un itérateur repérant l'élément situé juste derrière
+       *   le dernier élément à traiter.
+       * @param[in, out] bins les compteurs privés de chaque thread.
+       */
+      template< typename InputIterator, typename Bins >
+      static void apply(const InputIterator& first,
+                        const InputIterator& last,
+                        std::vector< Bins >& bins) {
+        ExecutionContext::forEachChunk(first, last, int(bins.size()),
+                                       [&](const InputIterator& debut,
+                                           const InputIterator& fin) {
+          Bins& local = bins[omp_get_thread_num()];
+          for (InputIterator it = debut; it != fin; ++ it) {
+            local.add(*it);
+          }
+        });
+      } // apply
+
+    }; // Impl< not RandomAccessIterator >
+
+  }; // Histogram
+
+  /**
+   * Implémentation du remplissage des compteurs dédiée aux
+   * RandomAccessIterator.
+   */
+  template<>
+  class Histogram::Impl< std::random_access_iterator_tag > {
+  public:
+
+    // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+    // invoquer les méthodes de classe privées.
+    friend class Histogram;
+
+  private:
+
+    /**
+     * Détermine le nombre de threads à employer.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] context le contexte d'exécution.
+     * @return 1 si le nombre d'éléments est inférieur au seuil du contexte,
+     *   le nombre de threads de l'équipe sinon.
+     */
+    template< typename RandomAccessIterator >
+    static int threads(const RandomAccessIterator& first,
+                       const RandomAccessIterator& last,
+                       const ExecutionContext& context) {
+      return context.sequential(last - first) ? 1 : context.threads();
+    } // threads
+
+    /**
+     * Remplissage des compteurs : chaque thread traite un bloc contigu
+     * d'éléments.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in, out] bins les compteurs privés de chaque thread.
+     */
+    template< typename RandomAccessIterator, typename Bins >
+    static void apply(const RandomAccessIterator& first,
+                      const RandomAccessIterator& last,
+                      std::vector< Bins >& bins) {
+      typedef typename std::iterator_traits< RandomAccessIterator >::
+        difference_type Size;
+      const int threads = bins.size();
+      const Size n = last - first;
+      if (threads == 1) {
+        for (RandomAccessIterator it = first; it != last; ++ it) {
+          bins[0].add(*it);
+        }
+        return;
+      }
+#pragma omp parallel for schedule(static, 1) num_threads(threads)
+      for (int r = 0; r < threads; r ++) {
+        const Size ir = n * r / threads;
+        const Size ir1 = n * (r + 1) / threads;
+        Bins& local = bins[r];
+        for (Size i = ir; i != ir1; i ++) {
+          local.add(first[i]);
+        }
+      }
+    } // apply
+
+  }; // Impl< RandomAccessIterator >
+
+} // paralgos
+
+#endif
@@ -0,0 +1,485 @@
+#ifndef KeyPayloadMerge_hpp
+#define KeyPayloadMerge_hpp
+
+#include "ParallelRecursiveMerge.hpp"
+#include "ParallelStableMerge.hpp"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace merging {
+
+  /**
+   * @class KeyPayloadMerge KeyPayloadMerge.hpp
+   *
+   * Fusion par clé de données rangées en structure de tableaux : chacun des
+   * deux conteneurs à fusionner est formé d'un tableau de clés ordonnées et
+   * d'un tableau de charges (les autres champs des enregistrements), de même
+   * taille. Seuls des rangs sont fusionnés, les clés n'étant que consultées :
+   * la fusion produit la permutation des rangs (permutation), qui peut être
+   * conservée et appliquée plus tard, à une partie des charges seulement ou
+   * à plusieurs tableaux de charges (gather) ; apply rassemble les clés et
+   * les charges en une seule passe finale.
+   *
+   * @note Les rangs des éléments du premier conteneur vont de 0 à m - 1,
+   *   ceux des éléments du second de m à m + n - 1. La permutation p est
+   *   telle que l'élément de rang r du conteneur cible est l'élément de rang
+   *   p[r] des deux conteneurs.
+   * @note La fusion des rangs est confiée soit à ParallelRecursiveMerge
+   *   (formes admettant une tolérance, cutoff), soit à ParallelStableMerge.
+   *   Toutes deux sont stables : à égalité, les éléments du premier
+   *   conteneur précèdent ceux du second.
+   * @note Les rangs de chaque conteneur étant consultés dans l'ordre, l'accès
+   *   indirect aux clés reste séquentiel ; il prive en revanche la fusion du
+   *   noyau vectoriel BitonicMerge.
+   * @note Le gain tient à la permutation seule, bien moins coûteuse à
+   *   calculer que la fusion des enregistrements lorsque les charges sont
+   *   volumineuses. Les fusions récursive et stable ne recopient en effet
+   *   chaque enregistrement qu'une fois, dans leurs feuilles : rassembler
+   *   toutes les charges coûte autant que fusionner les enregistrements.
+   */
+  class KeyPayloadMerge {
+  public:
+
+    /**
+     * Permutation de la fusion, les rangs étant fusionnés par
+     * ParallelRecursiveMerge.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second conteneur ;
+     * @param[in] perm - un itérateur repérant la position où écrire le
+     *   premier rang de la permutation, dont le type entier doit pouvoir
+     *   représenter m + n ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les clés des deux conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée séquentiellement ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la permutation.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    permutation(const InputRandomAccessIterator1& first1,
+		const InputRandomAccessIterator1& last1,
+		const InputRandomAccessIterator2& first2,
+		const InputRandomAccessIterator2& last2,
+		const OutputRandomAccessIterator& perm,
+		const Compare& comp,
+		const size_t& cutoff,
+		const Executor& executor) {
+      typedef typename std::iterator_traits< OutputRandomAccessIterator >::
+	value_type Index;
+      const Index m = last1 - first1;
+      const Index mpn = m + (last2 - first2);
+      return ParallelRecursiveMerge::apply(Rank< Index >(0),
+					   Rank< Index >(m),
+					   Rank< Index >(m),
+					   Rank< Index >(mpn),
+					   perm,
+					   ByKey< InputRandomAccessIterator1,
+					   InputRandomAccessIterator2,
+					   Compare, Index >(first1, first2, m,
+							    comp),
+					   cutoff,
+					   executor);
+    } // permutation
+
+    /**
+     * Permutation de la fusion, les rangs étant fusionnés par
+     * ParallelStableMerge.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second conteneur ;
+     * @param[in] perm - un itérateur repérant la position où écrire le
+     *   premier rang de la permutation, dont le type entier doit pouvoir
+     *   représenter m + n ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les clés des deux conteneurs ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor), chacun de ses
+     *   threads fusionnant une tranche de la permutation.
+     * @return un itérateur repérant la fin de la permutation.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    permutation(const InputRandomAccessIterator1& first1,
+		const InputRandomAccessIterator1& last1,
+		const InputRandomAccessIterator2& first2,
+		const InputRandomAccessIterator2& last2,
+		const OutputRandomAccessIterator& perm,
+		const Compare& comp,
+		const Executor& executor) {
+      typedef typename std::iterator_traits< OutputRandomAccessIterator >::
+	value_type Index;
+      const Index m = last1 - first1;
+      const Index mpn = m + (last2 - first2);
+      return ParallelStableMerge::apply(Rank< Index >(0),
+					Rank< Index >(m),
+					Rank< Index >(m),
+					Rank< Index >(mpn),
+					perm,
+					ByKey< InputRandomAccessIterator1,
+					InputRandomAccessIterator2,
+					Compare, Index >(first1, first2, m,
+							 comp),
+					executor);
+    } // permutation
+
+    /**
+     * Rassemble, selon une permutation, les éléments de deux conteneurs
+     * (clés ou charges) : chaque thread de l'exécuteur recopie une tranche
+     * du conteneur cible.
+     *
+     * @param[in] first - un itérateur repérant le premier rang de la
+     *   permutation ;
+     * @param[in] last - un itérateur repérant la position située juste
+     *   derrière le dernier rang de la permutation ;
+     * @param[in] m - le nombre d'éléments du premier conteneur ;
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la zone de recopie dans le
+     *   conteneur cible.
+     *
+     * @note Les itérateurs d'entrée peuvent être des std::move_iterator : les
+     *   éléments sont alors déplacés et non recopiés.
+     */
+    template< typename IndexRandomAccessIterator,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    gather(const IndexRandomAccessIterator& first,
+	   const IndexRandomAccessIterator& last,
+	   const size_t& m,
+	   const InputRandomAccessIterator1& first1,
+	   const InputRandomAccessIterator2& first2,
+	   const OutputRandomAccessIterator& result,
+	   const Executor& executor) {
+      const size_t size = last - first;
+      const int threads = executor.concurrency();
+      executor.run([&]() {
+	  executor.parallelFor(0, threads, [&](const int& r) {
+	      const size_t fin = size * (r + 1) / threads;
+	      for (size_t i = size * r / threads; i != fin; i ++) {
+		const size_t x = first[i];
+		result[i] = x < m ? first1[x] : first2[x - m];
+	      }
+	    });
+	});
+      return result + size;
+    } // gather
+
+    /**
+     * Fusion par clé, les rangs étant fusionnés par ParallelRecursiveMerge :
+     * les clés et les charges sont rassemblées une seule fois, à la fin.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second conteneur ;
+     * @param[in] payload1 - un itérateur repérant la première charge du
+     *   premier conteneur ;
+     * @param[in] payload2 - un itérateur repérant la première charge du
+     *   second conteneur ;
+     * @param[in] keys - un itérateur repérant la position où recopier la
+     *   première clé résultant de la fusion ;
+     * @param[in] payloads - un itérateur repérant la position où recopier la
+     *   première charge résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les clés des deux conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée séquentiellement ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible des charges.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename PayloadRandomAccessIterator1,
+	      typename PayloadRandomAccessIterator2,
+	      typename OutputRandomAccessIterator1,
+	      typename OutputRandomAccessIterator2,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator2
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const PayloadRandomAccessIterator1& payload1,
+	  const PayloadRandomAccessIterator2& payload2,
+	  const OutputRandomAccessIterator1& keys,
+	  const OutputRandomAccessIterator2& payloads,
+	  const Compare& comp,
+	  const size_t& cutoff,
+	  const Executor& executor) {
+      // Rangs de 32 bits lorsque c'est possible : moitié moins de données à
+      // déplacer.
+      const size_t m = last1 - first1;
+      const size_t mpn = m + (last2 - first2);
+      if (mpn <= std::numeric_limits< uint32_t >::max()) {
+	std::vector< uint32_t > perm(mpn);
+	permutation(first1, last1, first2, last2, perm.begin(), comp, cutoff,
+		    executor);
+	return gather(perm, m, first1, first2, payload1, payload2, keys,
+		      payloads, executor);
+      }
+      std::vector< uint64_t > perm(mpn);
+      permutation(first1, last1, first2, last2, perm.begin(), comp, cutoff,
+		  executor);
+      return gather(perm, m, first1, first2, payload1, payload2, keys,
+		    payloads, executor);
+    } // apply
+
+    /**
+     * Fusion par clé, les rangs étant fusionnés par ParallelStableMerge :
+     * les clés et les charges sont rassemblées une seule fois, à la fin.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second conteneur ;
+     * @param[in] payload1 - un itérateur repérant la première charge du
+     *   premier conteneur ;
+     * @param[in] payload2 - un itérateur repérant la première charge du
+     *   second conteneur ;
+     * @param[in] keys - un itérateur repérant la position où recopier la
+     *   première clé résultant de la fusion ;
+     * @param[in] payloads - un itérateur repérant la position où recopier la
+     *   première charge résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les clés des deux conteneurs ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible des charges.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename PayloadRandomAccessIterator1,
+	      typename PayloadRandomAccessIterator2,
+	      typename OutputRandomAccessIterator1,
+	      typename OutputRandomAccessIterator2,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator2
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const PayloadRandomAccessIterator1& payload1,
+	  const PayloadRandomAccessIterator2& payload2,
+	  const OutputRandomAccessIterator1& keys,
+	  const OutputRandomAccessIterator2& payloads,
+	  const Compare& comp,
+	  const Executor& executor) {
+      const size_t m = last1 - first1;
+      const size_t mpn = m + (last2 - first2);
+      if (mpn <= std::numeric_limits< uint32_t >::max()) {
+	std::vector< uint32_t > perm(mpn);
+	permutation(first1, last1, first2, last2, perm.begin(), comp,
+		    executor);
+	return gather(perm, m, first1, first2, payload1, payload2, keys,
+		      payloads, executor);
+      }
+      std::vector< uint64_t > perm(mpn);
+      permutation(first1, last1, first2, last2, perm.begin(), comp, executor);
+      return gather(perm, m, first1, first2, payload1, payload2, keys,
+		    payloads, executor);
+    } // apply
+
+  private:
+
+    /**
+     * Itérateur à accès direct sur les rangs consécutifs : il n'est adossé à
+     * aucun tableau.
+     */
+    template< typename Index >
+    class Rank {
+    public:
+      typedef std::random_access_iterator_tag iterator_category;
+      typedef Index value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const Index* pointer;
+      typedef Index reference;
+
+      explicit Rank(const Index& i = 0) : i_(i) {}
+
+      Index operator*() const { return i_; }
+      Index operator[](const difference_type& d) const { return i_ + d; }
+
+      Rank& operator++() { ++ i_; return *this; }
+      Rank& operator--() { -- i_; return *this; }
+      Rank operator++(int) { Rank r(*this); ++ i_; return r; }
+      Rank operator--(int) { Rank r(*this); -- i_; return r; }
+      Rank& operator+=(const difference_type& d) { i_ += d; return *this; }
+      Rank& operator-=(const difference_type& d) { i_ -= d; return *this; }
+
+      friend Rank operator+(Rank r, const difference_type& d) {
+	return r += d;
+      }
+      friend Rank operator+(const difference_type& d, Rank r) {
+	return r += d;
+      }
+      friend Rank operator-(Rank r, const difference_type& d) {
+	return r -= d;
+      }
+      friend difference_type operator-(const Rank& a, const Rank& b) {
+	return difference_type(a.i_) - difference_type(b.i_);
+      }
+
+      friend bool operator==(const Rank& a, const Rank& b) {
+	return a.i_ == b.i_;
+      }
+      friend bool operator!=(const Rank& a, const Rank& b) {
+	return a.i_ != b.i_;
+      }
+      friend bool operator<(const Rank& a, const Rank& b) {
+	return a.i_ < b.i_;
+      }
+      friend bool operator>(const Rank& a, const Rank& b) {
+	return a.i_ > b.i_;
+      }
+      friend bool operator<=(const Rank& a, const Rank& b) {
+	return a.i_ <= b.i_;
+      }
+      friend bool operator>=(const Rank& a, const Rank& b) {
+	return a.i_ >= b.i_;
+      }
+
+    private:
+      Index i_;
+    }; // Rank
+
+    /**
+     * Comparaison de deux rangs selon les clés qu'ils repèrent. Au sein des
+     * feuilles, les deux rangs comparés proviennent toujours du même
+     * conteneur respectif : les branchements sont prévisibles.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename Compare,
+	      typename Index >
+    class ByKey {
+    public:
+      ByKey(const InputRandomAccessIterator1& a,
+	    const InputRandomAccessIterator2& b,
+	    const Index& m,
+	    const Compare& comp)
+	: a_(a), b_(b), m_(m), comp_(comp) {}
+
+      bool operator()(const Index& x, const Index& y) const {
+	if (x < m_) {
+	  return y < m_ ? comp_(a_[x], a_[y]) : comp_(a_[x], b_[y - m_]);
+	}
+	return y < m_ ? comp_(b_[x - m_], a_[y])
+	  : comp_(b_[x - m_], b_[y - m_]);
+      }
+
+    private:
+      InputRandomAccessIterator1 a_;
+      InputRandomAccessIterator2 b_;
+      Index m_;
+      Compare comp_;
+    }; // ByKey
+
+    /**
+     * Rassemble les clés et les charges selon la permutation, en une seule
+     * passe.
+     *
+     * @param[in] perm - la permutation ;
+     * @param[in] m - le nombre d'éléments du premier conteneur ;
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   conteneur ;
+     * @param[in] payload1 - un itérateur repérant la première charge du
+     *   premier conteneur ;
+     * @param[in] payload2 - un itérateur repérant la première charge du
+     *   second conteneur ;
+     * @param[in] keys - un itérateur repérant la position où recopier la
+     *   première clé ;
+     * @param[in] payloads - un itérateur repérant la position où recopier la
+     *   première charge ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la zone de recopie dans le
+     *   conteneur cible des charges.
+     */
+    template< typename Index,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename PayloadRandomAccessIterator1,
+	      typename PayloadRandomAccessIterator2,
+	      typename OutputRandomAccessIterator1,
+	      typename OutputRandomAccessIterator2,
+	      typename Executor >
+    static OutputRandomAccessIterator2
+    gather(const std::vector< Index >& perm,
+	   const size_t& m,
+	   const InputRandomAccessIterator1& first1,
+	   const InputRandomAccessIterator2& first2,
+	   const PayloadRandomAccessIterator1& payload1,
+	   const PayloadRandomAccessIterator2& payload2,
+	   const OutputRandomAccessIterator1& keys,
+	   const OutputRandomAccessIterator2& payloads,
+	   const Executor& executor) {
+      const size_t size = perm.size();
+      const int threads = executor.concurrency();
+      executor.run([&]() {
+	  executor.parallelFor(0, threads, [&](const int& r) {
+	      const size_t fin = size * (r + 1) / threads;
+	      for (size_t i = size * r / threads; i != fin; i ++) {
+		const size_t x = perm[i];
+		if (x < m) {
+		  keys[i] = first1[x];
+		  payloads[i] = payload1[x];
+		} else {
+		  keys[i] = first2[x - m];
+		  payloads[i] = payload2[x - m];
+		}
+	      }
+	    });
+	});
+      return payloads + size;
+    } // gather
+
+  }; // KeyPayloadMerge
+
+} // merging
+
+#endif
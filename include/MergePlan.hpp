@@ -0,0 +1,221 @@
+#ifndef MergePlan_hpp
+#define MergePlan_hpp
+
+#include "ParallelStableMerge.hpp"
+#include <iterator>
+#include <vector>
+
+namespace merging {
+
+  /**
+   * @class MergePlan MergePlan.hpp
+   *
+   * Plan d'exécution réutilisable de la fusion stable et parallèle de
+   * ParallelStableMerge : les points de partage du conteneur cible en
+   * tranches, un par thread de l'exécuteur, sont obtenus par co-rang lors de
+   * la première fusion puis conservés. Les fusions suivantes des mêmes
+   * sous-conteneurs (par exemple, lorsque seules les charges utiles des
+   * éléments changent) en font l'économie.
+   *
+   * Le plan est recalculé automatiquement lorsque les sous-conteneurs
+   * changent :
+   * - lorsque leurs itérateurs ou leurs tailles, ou le nombre de threads de
+   *   l'exécuteur, diffèrent de ceux du plan ;
+   * - lorsque les points de partage ne sont plus valides, ce qui est vérifié
+   *   à chaque fusion en comparant les éléments situés de part et d'autre
+   *   de chaque point (deux comparaisons par thread) : tant qu'ils restent
+   *   valides, la fusion est identique à celle de ParallelStableMerge.
+   *
+   * La méthode invalidate force le recalcul du plan lors de la fusion
+   * suivante.
+   *
+   * @note Tout comme ParallelStableMerge, ce plan attend une relation d'ordre
+   *   strict (de type < ou >) et la fusion est stable.
+   * @note Les sous-conteneurs doivent rester ordonnés.
+   */
+  template< typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename Compare >
+  class MergePlan {
+  public:
+
+    // Types synonymes permettant de ne rien préjuger des types entiers
+    // manipulés.
+    typedef typename std::iterator_traits< InputRandomAccessIterator1 >::
+    difference_type InputSize1;
+    typedef typename std::iterator_traits< InputRandomAccessIterator2 >::
+    difference_type InputSize2;
+
+    /**
+     * Constructeur : le plan est vide, il sera calculé lors de la première
+     * fusion.
+     *
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     */
+    explicit MergePlan(const Compare& comp = Compare())
+      : comp_(comp), m_(0), n_(0), builds_(0) {
+    }
+
+    /**
+     * Fusion des deux sous-conteneurs selon le plan, calculé au préalable
+     * si nécessaire.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor), chacun de ses
+     *   threads fusionnant une tranche du conteneur cible.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename OutputRandomAccessIterator, typename Executor >
+    OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Executor& executor) {
+
+      // Le plan est recalculé s'il ne correspond plus aux sous-conteneurs.
+      const int threads = executor.concurrency();
+      if (! valid(first1, last1, first2, last2, threads)) {
+	build(first1, last1, first2, last2, threads, executor);
+      }
+
+      // Chaque thread fusionne sa tranche, la fusion étant vectorisée si les
+      // types le permettent.
+      executor.run([&]() {
+	  executor.parallelFor(0, threads, [&](const int& r) {
+	      BitonicMerge::merge(first1 + j_[r],
+				  first1 + j_[r + 1],
+				  first2 + k_[r],
+				  first2 + k_[r + 1],
+				  result + j_[r] + k_[r],
+				  comp_);
+	    });
+	});
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + m_ + n_;
+
+    } // apply
+
+    /**
+     * Détermine si le plan correspond à deux sous-conteneurs.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] threads - le nombre de tranches.
+     * @return @c true si les sous-conteneurs et le nombre de tranches sont
+     *   ceux du plan et si ses points de partage sont encore valides.
+     */
+    bool valid(const InputRandomAccessIterator1& first1,
+	       const InputRandomAccessIterator1& last1,
+	       const InputRandomAccessIterator2& first2,
+	       const InputRandomAccessIterator2& last2,
+	       const int& threads) const {
+      if (j_.empty()
+	  || j_.size() != static_cast< size_t >(threads) + 1
+	  || first1 != a_ || last1 - first1 != m_
+	  || first2 != b_ || last2 - first2 != n_) {
+	return false;
+      }
+
+      // Un point de partage (j, k) est valide si a[j-1] <= b[k] et
+      // b[k-1] < a[j] (cf. ParallelStableMerge::coRank).
+      for (int r = 1; r < threads; r ++) {
+	const InputSize1 j = j_[r];
+	const InputSize2 k = k_[r];
+	if ((j > 0 && k < n_ && comp_(first2[k], first1[j - 1]))
+	    || (k > 0 && j < m_ && ! comp_(first2[k - 1], first1[j]))) {
+	  return false;
+	}
+      }
+      return true;
+    } // valid
+
+    /**
+     * Force le recalcul du plan lors de la fusion suivante.
+     */
+    void invalidate() {
+      j_.clear();
+      k_.clear();
+    } // invalidate
+
+    /**
+     * @return le nombre de calculs du plan depuis sa construction.
+     */
+    const size_t& builds() const {
+      return builds_;
+    } // builds
+
+  private:
+
+    /**
+     * Calcule les points de partage du conteneur cible en tranches de
+     * tailles égales (à un élément près), un co-rang par thread.
+     */
+    template< typename Executor >
+    void build(const InputRandomAccessIterator1& first1,
+	       const InputRandomAccessIterator1& last1,
+	       const InputRandomAccessIterator2& first2,
+	       const InputRandomAccessIterator2& last2,
+	       const int& threads,
+	       const Executor& executor) {
+      a_ = first1;
+      b_ = first2;
+      m_ = last1 - first1;
+      n_ = last2 - first2;
+      j_.assign(threads + 1, 0);
+      k_.assign(threads + 1, 0);
+      const InputSize1 m = m_;
+      const InputSize2 n = n_;
+      const auto mpn = m + n;
+      executor.run([&]() {
+	  executor.parallelFor(0, threads + 1, [&](const int& r) {
+	      const decltype(mpn) i = mpn * r / threads;
+	      ParallelStableMerge::coRank(i, first1, m, first2, n, comp_,
+					  j_[r], k_[r]);
+	    });
+	});
+      builds_ ++;
+    } // build
+
+    /** La relation d'ordre. */
+    Compare comp_;
+
+    /** Les sous-conteneurs du plan. */
+    InputRandomAccessIterator1 a_;
+    InputRandomAccessIterator2 b_;
+
+    /** Les tailles des sous-conteneurs du plan. */
+    InputSize1 m_;
+    InputSize2 n_;
+
+    /** Les points de partage dans chacun des sous-conteneurs. */
+    std::vector< InputSize1 > j_;
+    std::vector< InputSize2 > k_;
+
+    /** Le nombre de calculs du plan. */
+    size_t builds_;
+
+  }; // MergePlan
+
+} // merging
+
+#endif
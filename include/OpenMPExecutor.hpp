@@ -0,0 +1,107 @@
+#ifndef OpenMPExecutor_hpp
+#define OpenMPExecutor_hpp
+
+#include <omp.h>
+
+namespace merging {
+
+  /**
+   * @class OpenMPExecutor OpenMPExecutor.hpp
+   *
+   * Exécuteur confiant le parallélisme des algorithmes de fusion à des tâches
+   * OpenMP. Un exécuteur fournit :
+   * - concurrency() : le nombre de threads disponibles ;
+   * - run(f) : l'exécution de f au sein de l'équipe de threads, jusqu'à son
+   *   terme ;
+   * - invoke(f, g) : l'exécution concurrente de f et g, jusqu'à leur terme ;
+   * - parallelFor(first, last, f) : l'exécution concurrente de f(i) pour i
+   *   dans [first, last[, jusqu'à leur terme.
+   *
+   * @note Une seule région parallèle est ouverte, par run, à moins que
+   *   l'appelant ne se trouve déjà dans une région parallèle : invoke et
+   *   parallelFor se contentent de créer des tâches.
+   * @see TBBExecutor, ThreadPoolExecutor
+   */
+  class OpenMPExecutor {
+  public:
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] threads - le nombre de threads de l'équipe (0 pour le nombre
+     *   de threads par défaut d'OpenMP).
+     */
+    explicit OpenMPExecutor(const int& threads = 0)
+      : threads_(threads > 0 ? threads : omp_get_max_threads()) {
+    }
+
+    /**
+     * @return le nombre de threads de l'équipe.
+     */
+    const int& concurrency() const {
+      return threads_;
+    }
+
+    /**
+     * Exécute une fonction au sein de l'équipe de threads : un seul thread
+     * l'invoque, les autres exécutant les tâches qu'elle crée.
+     *
+     * @param[in] f - la fonction, sans paramètre.
+     */
+    template< typename Function >
+    void run(const Function& f) const {
+      if (omp_in_parallel()) {
+	f();
+	return;
+      }
+#pragma omp parallel num_threads(threads_)
+#pragma omp single
+      f();
+    } // run
+
+    /**
+     * Exécute deux fonctions de manière concurrente : la première dans une
+     * tâche, la seconde par le thread appelant.
+     *
+     * @param[in] f - la première fonction, sans paramètre ;
+     * @param[in] g - la seconde fonction, sans paramètre.
+     */
+    template< typename Function1, typename Function2 >
+    void invoke(const Function1& f, const Function2& g) const {
+      const Function1* const pf = &f;
+#pragma omp task untied firstprivate(pf)
+      (*pf)();
+      g();
+#pragma omp taskwait
+    } // invoke
+
+    /**
+     * Exécute f(i) pour i dans [first, last[ de manière concurrente, une
+     * tâche par indice.
+     *
+     * @param[in] first - le premier indice ;
+     * @param[in] last - l'indice situé juste derrière le dernier indice ;
+     * @param[in] f - la fonction, paramétrée par un indice.
+     */
+    template< typename Function >
+    void parallelFor(const int& first,
+		     const int& last,
+		     const Function& f) const {
+      const Function* const pf = &f;
+      for (int i = first; i < last; i ++) {
+#pragma omp task untied firstprivate(pf, i)
+	(*pf)(i);
+      }
+#pragma omp taskwait
+    } // parallelFor
+
+  private:
+
+    /** Le nombre de threads de l'équipe. */
+    int threads_;
+
+  }; // OpenMPExecutor
+
+} // merging
+
+#endif
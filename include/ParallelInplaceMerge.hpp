@@ -0,0 +1,411 @@
+#ifndef ParallelInplaceMerge_hpp
+#define ParallelInplaceMerge_hpp
+
+#include "ParallelStableMerge.hpp"
+#include "OpenMPExecutor.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <memory>
+#include <cmath>
+
+namespace merging {
+
+  /**
+   * @class ParallelInplaceMerge ParallelInplaceMerge.hpp
+   *
+   * Version parallèle de l'algorithme inplace_merge de la bibliothèque
+   * standard : deux suites ordonnées adjacentes sont fusionnées sur place,
+   * avec un tampon de O(sqrt(n)) éléments au lieu d'un conteneur cible de
+   * taille n.
+   *
+   * La fusion procède en trois temps :
+   * - le conteneur cible est découpé en autant de tranches que de threads,
+   *   dont les bornes dans les deux suites (A_r et B_r pour la tranche r)
+   *   sont obtenues par co-rang (cf. ParallelStableMerge::coRank) ;
+   * - les tranches A_0 ... A_p-1 B_0 ... B_p-1 sont réordonnées en
+   *   A_0 B_0 ... A_p-1 B_p-1 par rotations de blocs, récursivement et en
+   *   parallèle (la rotation des deux moitiés centrales séparant les deux
+   *   moitiés du problème) ;
+   * - chaque paire A_r B_r est fusionnée sur place par un thread, via sa part
+   *   du tampon et, lorsqu'elle ne suffit pas, des rotations de blocs.
+   *
+   * @note Tout comme l'algorithme inplace_merge, cette fusion est stable.
+   */
+  class ParallelInplaceMerge {
+  public:
+
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in] first - un itérateur repérant le premier élément de la
+     *   première suite ;
+     * @param[in] middle - un itérateur repérant le premier élément de la
+     *   seconde suite, situé juste derrière le dernier élément de la
+     *   première ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément de la seconde suite ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les suites ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     */
+    template< typename RandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static void apply(const RandomAccessIterator& first,
+		      const RandomAccessIterator& middle,
+		      const RandomAccessIterator& last,
+		      const Compare& comp,
+		      const Executor& executor) {
+
+      // Types synonymes.
+      typedef std::iterator_traits< RandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+      typedef typename Traits::difference_type Size;
+
+      // Une suite vide : il n'y a rien à faire.
+      const Size n = last - first;
+      const Size m = middle - first;
+      if (m == 0 || m == n) {
+	return;
+      }
+
+      // Le tampon, alloué une seule fois et partagé entre les threads (au
+      // moins un élément par thread). Il n'est que de la mémoire brute : ses
+      // éléments sont construits par déplacement puis détruits par chaque
+      // fusion (cf. mergeAdaptive).
+      const int threads = executor.concurrency();
+      const Size taille = std::max(buffer(n), Size(threads));
+      const Tampon< value_type > tampon(taille);
+      value_type* const buf = tampon.get();
+
+      executor.run([&]() {
+
+	  // Un seul thread : fusion sur place de la totalité des suites.
+	  if (threads == 1) {
+	    mergeAdaptive(first, middle, last, buf, taille, comp);
+	    return;
+	  }
+
+	  // Bornes des tranches dans le conteneur cible (i) et dans les deux
+	  // suites (j et k) ; à égalité, la première suite précède la
+	  // seconde.
+	  std::vector< Size > i(threads + 1), j(threads + 1), k(threads + 1);
+	  executor.parallelFor(0, threads + 1, [&](const int& r) {
+	      i[r] = n * r / threads;
+	      ParallelStableMerge::coRank(i[r], first, m, middle, n - m, comp,
+					  j[r], k[r]);
+	    });
+
+	  // Regroupement des paires de tranches.
+	  rearrange(first, i, j, k, 0, threads, executor);
+
+	  // Fusion de chaque paire de tranches, chaque thread disposant de
+	  // sa part du tampon.
+	  const Size part = taille / threads;
+	  executor.parallelFor(0, threads, [&](const int& r) {
+	      mergeAdaptive(first + i[r],
+			    first + i[r] + (j[r + 1] - j[r]),
+			    first + i[r + 1],
+			    buf + r * part,
+			    part,
+			    comp);
+	    });
+
+	});
+
+    } // apply
+
+    /**
+     * Forme spécifique de l'algorithme pour la relation d'ordre total
+     * strictement inférieur à.
+     *
+     * @param[in] first - un itérateur repérant le premier élément de la
+     *   première suite ;
+     * @param[in] middle - un itérateur repérant le premier élément de la
+     *   seconde suite ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément de la seconde suite ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     */
+    template< typename RandomAccessIterator, typename Executor >
+    static void apply(const RandomAccessIterator& first,
+		      const RandomAccessIterator& middle,
+		      const RandomAccessIterator& last,
+		      const Executor& executor) {
+      typedef std::iterator_traits< RandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+      apply(first, middle, last, std::less< const value_type& >(), executor);
+    } // apply
+
+    /**
+     * Taille du tampon utilisé pour fusionner n éléments.
+     *
+     * @param[in] n - le nombre total d'éléments des deux suites.
+     * @return le nombre d'éléments du tampon, soit ceil(sqrt(n)).
+     */
+    template< typename Size >
+    static Size buffer(const Size& n) {
+      return static_cast< Size >(std::ceil(std::sqrt(static_cast< double >(n))));
+    } // buffer
+
+  protected:
+
+    /**
+     * Regroupe récursivement les tranches [lo, hi[ : la zone concernée,
+     * débutant au rang i[lo], contient A_lo ... A_hi-1 B_lo ... B_hi-1. La
+     * rotation de A_mid ... A_hi-1 et B_lo ... B_mid-1 sépare le problème en
+     * deux sous-problèmes indépendants, traités en parallèle.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du
+     *   conteneur ;
+     * @param[in] i - les rangs des tranches dans le conteneur cible ;
+     * @param[in] j - les rangs des tranches dans la première suite ;
+     * @param[in] k - les rangs des tranches dans la seconde suite ;
+     * @param[in] lo - la première tranche concernée ;
+     * @param[in] hi - la tranche située juste derrière la dernière tranche
+     *   concernée ;
+     * @param[in] executor - l'exécuteur.
+     */
+    template< typename RandomAccessIterator,
+	      typename Size,
+	      typename Executor >
+    static void rearrange(const RandomAccessIterator& first,
+			  const std::vector< Size >& i,
+			  const std::vector< Size >& j,
+			  const std::vector< Size >& k,
+			  const int& lo,
+			  const int& hi,
+			  const Executor& executor) {
+      if (hi - lo < 2) {
+	return;
+      }
+      const int mid = lo + (hi - lo) / 2;
+      const RandomAccessIterator debut = first + i[lo] + (j[mid] - j[lo]);
+      const RandomAccessIterator milieu = first + i[lo] + (j[hi] - j[lo]);
+      const RandomAccessIterator fin = milieu + (k[mid] - k[lo]);
+      rotate(debut, milieu, fin, executor);
+      executor.invoke([&]() {
+	  rearrange(first, i, j, k, lo, mid, executor);
+	},
+	[&]() {
+	  rearrange(first, i, j, k, mid, hi, executor);
+	});
+    } // rearrange
+
+    /**
+     * Rotation parallèle de blocs : [first, middle[ et [middle, last[ sont
+     * échangés. Les grandes rotations sont effectuées par trois
+     * renversements, chacun réparti entre les threads.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du premier
+     *   bloc ;
+     * @param[in] middle - un itérateur repérant le premier élément du second
+     *   bloc ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second bloc ;
+     * @param[in] executor - l'exécuteur.
+     */
+    template< typename RandomAccessIterator, typename Executor >
+    static void rotate(const RandomAccessIterator& first,
+		       const RandomAccessIterator& middle,
+		       const RandomAccessIterator& last,
+		       const Executor& executor) {
+      if (first == middle || middle == last) {
+	return;
+      }
+      const int threads = executor.concurrency();
+      if (threads == 1 || last - first < SEQUENTIAL) {
+	std::rotate(first, middle, last);
+	return;
+      }
+      reverse(first, middle, executor);
+      reverse(middle, last, executor);
+      reverse(first, last, executor);
+    } // rotate
+
+    /**
+     * Renversement parallèle d'un bloc : chaque thread échange une part des
+     * paires d'éléments symétriques.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du bloc ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du bloc ;
+     * @param[in] executor - l'exécuteur.
+     */
+    template< typename RandomAccessIterator, typename Executor >
+    static void reverse(const RandomAccessIterator& first,
+			const RandomAccessIterator& last,
+			const Executor& executor) {
+      typedef typename std::iterator_traits< RandomAccessIterator >::
+	difference_type Size;
+      const Size paires = (last - first) / 2;
+      const int threads = executor.concurrency();
+      executor.parallelFor(0, threads, [&](const int& r) {
+	  const Size lo = paires * r / threads;
+	  const Size hi = paires * (r + 1) / threads;
+	  std::swap_ranges(first + lo,
+			   first + hi,
+			   std::reverse_iterator< RandomAccessIterator >(
+			     last - lo));
+	});
+    } // reverse
+
+    /**
+     * Fusion séquentielle sur place de deux suites adjacentes via un tampon
+     * de taille bornée : la plus courte des deux suites est déplacée dans le
+     * tampon (mémoire brute, où ses éléments sont construits par
+     * déplacement puis détruits une fois la fusion achevée) si elle y tient,
+     * puis fusionnée avec l'autre ; sinon, les deux
+     * suites sont scindées (médiane de la plus longue et sa position dans
+     * l'autre), les deux blocs centraux échangés par rotation et les deux
+     * sous-problèmes traités récursivement.
+     *
+     * @param[in] first - un itérateur repérant le premier élément de la
+     *   première suite ;
+     * @param[in] middle - un itérateur repérant le premier élément de la
+     *   seconde suite ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément de la seconde suite ;
+     * @param[in] buf - le tampon ;
+     * @param[in] size - le nombre d'éléments du tampon ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les suites.
+     */
+    template< typename RandomAccessIterator,
+	      typename Pointer,
+	      typename Size,
+	      typename Compare >
+    static void mergeAdaptive(const RandomAccessIterator& first,
+			      const RandomAccessIterator& middle,
+			      const RandomAccessIterator& last,
+			      const Pointer& buf,
+			      const Size& size,
+			      const Compare& comp) {
+      const Size len1 = middle - first;
+      const Size len2 = last - middle;
+      if (len1 == 0 || len2 == 0) {
+	return;
+      }
+
+      // La première suite tient dans le tampon : fusion vers l'avant.
+      if (len1 <= len2 && len1 <= size) {
+	const Pointer fin1 =
+	  std::uninitialized_copy(std::make_move_iterator(first),
+				  std::make_move_iterator(middle),
+				  buf);
+	Pointer p1 = buf;
+	RandomAccessIterator p2 = middle, out = first;
+	while (p1 != fin1 && p2 != last) {
+	  if (comp(*p2, *p1)) {
+	    *out = std::move(*p2);
+	    ++ p2;
+	  } else {
+	    *out = std::move(*p1);
+	    ++ p1;
+	  }
+	  ++ out;
+	}
+	std::move(p1, fin1, out);
+	destroy(buf, fin1);
+	return;
+      }
+
+      // La seconde suite tient dans le tampon : fusion vers l'arrière.
+      if (len2 <= size) {
+	const Pointer fin2 =
+	  std::uninitialized_copy(std::make_move_iterator(middle),
+				  std::make_move_iterator(last),
+				  buf);
+	Pointer p2 = fin2;
+	RandomAccessIterator p1 = middle, out = last;
+	while (p1 != first && p2 != buf) {
+	  if (comp(*(p2 - 1), *(p1 - 1))) {
+	    -- p1;
+	    -- out;
+	    *out = std::move(*p1);
+	  } else {
+	    -- p2;
+	    -- out;
+	    *out = std::move(*p2);
+	  }
+	}
+	std::move_backward(buf, p2, out);
+	destroy(buf, fin2);
+	return;
+      }
+
+      // Aucune ne tient dans le tampon : scission puis récursion.
+      RandomAccessIterator cut1, cut2;
+      if (len1 > len2) {
+	cut1 = first + len1 / 2;
+	cut2 = std::lower_bound(middle, last, *cut1, comp);
+      } else {
+	cut2 = middle + len2 / 2;
+	cut1 = std::upper_bound(first, middle, *cut2, comp);
+      }
+      std::rotate(cut1, middle, cut2);
+      const RandomAccessIterator pivot = cut1 + (cut2 - middle);
+      mergeAdaptive(first, cut1, pivot, buf, size, comp);
+      mergeAdaptive(pivot, cut2, last, buf, size, comp);
+    } // mergeAdaptive
+
+    /**
+     * Détruit les éléments construits dans le tampon.
+     *
+     * @param[in] first - un pointeur repérant le premier élément ;
+     * @param[in] last - un pointeur repérant l'élément situé juste derrière
+     *   le dernier élément.
+     */
+    template< typename Pointer >
+    static void destroy(Pointer first, const Pointer& last) {
+      typedef typename std::iterator_traits< Pointer >::value_type T;
+      for (; first != last; ++ first) {
+	first->~T();
+      }
+    } // destroy
+
+    /**
+     * Tampon de mémoire brute : alloué sans construire le moindre élément,
+     * libéré sans en détruire.
+     */
+    template< typename T >
+    class Tampon {
+    public:
+
+      explicit Tampon(const size_t& taille)
+	: taille_(taille), data_(std::allocator< T >().allocate(taille)) {
+      }
+
+      ~Tampon() {
+	std::allocator< T >().deallocate(data_, taille_);
+      }
+
+      T* get() const {
+	return data_;
+      }
+
+    private:
+
+      Tampon(const Tampon&);
+      Tampon& operator=(const Tampon&);
+
+      /** Le nombre d'éléments du tampon. */
+      const size_t taille_;
+
+      /** La mémoire allouée. */
+      T* const data_;
+
+    }; // Tampon
+
+    /**
+     * Taille en dessous de laquelle une rotation est séquentielle.
+     */
+    static const long SEQUENTIAL = 64 * 1024;
+
+  }; // ParallelInplaceMerge
+
+} // merging
+
+#endif
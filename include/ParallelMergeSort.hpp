@@ -0,0 +1,162 @@
+#ifndef ParallelMergeSort_hpp
+#define ParallelMergeSort_hpp
+
+#include "ParallelRecursiveMerge.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <omp.h>
+
+namespace sorting {
+
+  /**
+   * @class ParallelMergeSort ParallelMergeSort.hpp
+   *
+   * Version OpenMP d'un tri fusion ascendant : le conteneur est découpé en
+   * feuilles triées via l'algorithme sort de la bibliothèque standard, puis
+   * les feuilles sont fusionnées deux à deux, niveau par niveau, par la
+   * stratégie à base de tâches de merging::ParallelRecursiveMerge.
+   *
+   * @note Chaque niveau fusionne les suites triées d'un tampon dans l'autre :
+   *   le conteneur lui-même et un tampon de même taille, alloué une seule
+   *   fois pour toute la durée du tri. Le tampon est construit en y
+   *   déplaçant les éléments du conteneur (les éléments n'ont pas à être
+   *   constructibles par défaut), et les feuilles y sont triées. Les suites
+   *   fusionnées étant consommées, leurs éléments sont déplacés et non
+   *   recopiés.
+   * @note Tout comme l'algorithme sort de la bibliothèque standard, ce tri
+   *   n'est pas stable.
+   */
+  class ParallelMergeSort : private merging::ParallelRecursiveMerge {
+  public:
+
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du conteneur
+     *   à trier ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du conteneur à trier ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant le conteneur ;
+     * @param[in] leaf - la taille des feuilles triées via l'algorithme sort de
+     *   la bibliothèque standard ;
+     * @param[in] cutoff - la somme des tailles des deux suites au dessous de
+     *   laquelle une fusion est effectuée via l'algorithme merge de la
+     *   bibliothèque standard ;
+     * @param[in] threads - le nombre de threads disponibles.
+     */
+    template< typename RandomAccessIterator, typename Compare >
+    static void apply(const RandomAccessIterator& first,
+		      const RandomAccessIterator& last,
+		      const Compare& comp,
+		      const size_t& leaf,
+		      const size_t& cutoff,
+		      const int& threads) {
+
+      // Types synonymes.
+      typedef std::iterator_traits< RandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+      typedef typename Traits::difference_type Size;
+
+      // Taille du conteneur et des feuilles.
+      const Size n = last - first;
+      const Size feuille = std::max(leaf, size_t(1));
+
+      // Le tampon, alloué une seule fois et rempli en y déplaçant les
+      // éléments du conteneur.
+      std::vector< value_type > tampon(std::make_move_iterator(first),
+				       std::make_move_iterator(last));
+      value_type* const buffer = tampon.data();
+
+#pragma omp parallel num_threads(threads)
+#pragma omp single
+      {
+	// Tri des feuilles, dans le tampon : une tâche par feuille.
+	for (Size i = 0; i < n; i += feuille) {
+#pragma omp task firstprivate(i)
+	  std::sort(buffer + i, buffer + std::min(i + feuille, n), comp);
+	}
+#pragma omp taskwait
+
+	// Fusion des suites deux à deux, niveau par niveau, alternativement
+	// du tampon vers le conteneur et du conteneur vers le tampon.
+	bool dansTampon = true;
+	for (Size largeur = feuille; largeur < n; largeur *= 2) {
+	  for (Size i = 0; i < n; i += 2 * largeur) {
+	    const Size milieu = std::min(i + largeur, n);
+	    const Size fin = std::min(i + 2 * largeur, n);
+#pragma omp task firstprivate(i, milieu, fin)
+	    if (dansTampon) {
+	      strategyBTasking(std::make_move_iterator(buffer + i),
+			       std::make_move_iterator(buffer + milieu),
+			       std::make_move_iterator(buffer + milieu),
+			       std::make_move_iterator(buffer + fin),
+			       first + i, comp, cutoff);
+	    } else {
+	      strategyBTasking(std::make_move_iterator(first + i),
+			       std::make_move_iterator(first + milieu),
+			       std::make_move_iterator(first + milieu),
+			       std::make_move_iterator(first + fin),
+			       buffer + i, comp, cutoff);
+	    }
+	  }
+#pragma omp taskwait
+	  dansTampon = ! dansTampon;
+	}
+
+	// Le résultat se trouve dans le tampon : déplacement dans le
+	// conteneur, une tâche par feuille.
+	if (dansTampon) {
+	  for (Size i = 0; i < n; i += feuille) {
+#pragma omp task firstprivate(i)
+	    std::move(buffer + i, buffer + std::min(i + feuille, n), first + i);
+	  }
+	}
+      }
+
+    } // apply
+
+    /**
+     * Forme spécifique de l'algorithme pour la relation d'ordre total
+     * strictement inférieur à.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du conteneur
+     *   à trier ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du conteneur à trier ;
+     * @param[in] leaf - la taille des feuilles triées via l'algorithme sort de
+     *   la bibliothèque standard ;
+     * @param[in] cutoff - la somme des tailles des deux suites au dessous de
+     *   laquelle une fusion est effectuée via l'algorithme merge de la
+     *   bibliothèque standard ;
+     * @param[in] threads - le nombre de threads disponibles.
+     */
+    template< typename RandomAccessIterator >
+    static void apply(const RandomAccessIterator& first,
+		      const RandomAccessIterator& last,
+		      const size_t& leaf,
+		      const size_t& cutoff,
+		      const int& threads) {
+
+      // Type synonyme pour le type des éléments du conteneur.
+      typedef std::iterator_traits< RandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Fabriquer le comparateur less puis invoquer la méthode définie
+      // ci-dessus.
+      apply(first,
+	    last,
+	    std::less< const value_type& >(),
+	    leaf,
+	    cutoff,
+	    threads);
+
+    } // apply
+
+  }; // ParallelMergeSort
+
+} // sorting
+
+#endif
@@ -0,0 +1,329 @@
+#ifndef ParallelMultiwayMerge_hpp
+#define ParallelMultiwayMerge_hpp
+
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+namespace merging {
+
+  /**
+   * @class ParallelMultiwayMerge ParallelMultiwayMerge.hpp
+   *
+   * Version OpenMP d'une fusion de k conteneurs ordonnés en une seule passe.
+   *
+   * @note Le conteneur cible est découpé en autant de tronçons de même taille
+   *   que de threads. Les rangs, dans chacun des k conteneurs, des éléments
+   *   délimitant chaque tronçon sont obtenus par une généralisation à k
+   *   conteneurs du co-rang de ParallelStableMerge. Chaque thread fusionne
+   *   ensuite ses k tranches via un arbre des perdants.
+   * @note La fusion est stable : deux éléments équivalents apparaissent dans
+   *   l'ordre des conteneurs puis dans leur ordre au sein d'un conteneur. Le
+   *   résultat est ainsi identique à celui de fusions successives des
+   *   conteneurs deux à deux via l'algorithme merge de la bibliothèque
+   *   standard.
+   * @note La relation d'ordre doit être stricte (< ou >).
+   */
+  class ParallelMultiwayMerge {
+  public:
+
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in] runs - les conteneurs à fusionner, chacun repéré par un
+     *   itérateur sur son premier élément et un itérateur sur l'élément situé
+     *   juste derrière son dernier élément ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total strict régissant les conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    apply(const std::vector< std::pair< InputRandomAccessIterator,
+					InputRandomAccessIterator > >& runs,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp,
+	  const int& threads) {
+
+      // Types synonymes.
+      typedef typename std::iterator_traits< InputRandomAccessIterator >::
+	difference_type InputSize;
+      typedef typename std::iterator_traits< OutputRandomAccessIterator >::
+	difference_type OutputSize;
+
+      // Taille du conteneur cible.
+      const int k = runs.size();
+      OutputSize mpn = 0;
+      for (int s = 0; s != k; s ++) {
+	mpn += runs[s].second - runs[s].first;
+      }
+
+      // Rangs délimitant les tronçons : splits[r][s] est le rang, dans le
+      // conteneur s, du premier élément du tronçon r.
+      std::vector< std::vector< InputSize > >
+	splits(threads + 1, std::vector< InputSize >(k));
+      for (int s = 0; s != k; s ++) {
+	splits[threads][s] = runs[s].second - runs[s].first;
+      }
+
+#pragma omp parallel num_threads(threads)
+      {
+	// Calcul des co-rangs du début de chaque tronçon.
+#pragma omp for schedule(static, 1)
+	for (int r = 1; r < threads; r ++) {
+	  coRank(OutputSize(mpn * r / threads), runs, comp, splits[r]);
+	}
+
+	// Fusion des tranches de chaque tronçon (la barrière implicite de la
+	// boucle précédente garantit que tous les co-rangs sont connus).
+#pragma omp for schedule(static, 1)
+	for (int r = 0; r < threads; r ++) {
+	  std::vector< std::pair< InputRandomAccessIterator,
+				  InputRandomAccessIterator > > slices(k);
+	  OutputSize ir = 0;
+	  for (int s = 0; s != k; s ++) {
+	    slices[s].first = runs[s].first + splits[r][s];
+	    slices[s].second = runs[s].first + splits[r + 1][s];
+	    ir += splits[r][s];
+	  }
+	  loserTree(slices, result + ir, comp);
+	}
+      }
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + mpn;
+
+    } // apply
+
+    /**
+     * Forme spécifique de l'algorithme pour la relation d'ordre total
+     * strictement inférieur à.
+     *
+     * @param[in] runs - les conteneurs à fusionner ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    apply(const std::vector< std::pair< InputRandomAccessIterator,
+					InputRandomAccessIterator > >& runs,
+	  const OutputRandomAccessIterator& result,
+	  const int& threads) {
+
+      // Type synonyme pour le type des éléments des conteneurs.
+      typedef std::iterator_traits< InputRandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Fabriquer le comparateur less puis invoquer la méthode définie
+      // ci-dessus.
+      return apply(runs,
+		   result,
+		   std::less< const value_type& >(),
+		   threads);
+
+    } // apply
+
+  protected:
+
+    /**
+     * Co-rang multi-séquences : recherche des rangs, dans chacun des
+     * conteneurs, des éléments susceptibles d'être accueillis à partir de la
+     * position de rang i dans le conteneur cible de la fusion.
+     *
+     * Les éléments sont ordonnés par valeur, puis par conteneur, puis par
+     * rang dans leur conteneur. Pour chaque conteneur s, un intervalle
+     * [lo[s], hi[s]] encadre le rang cherché. L'élément médian de l'intervalle
+     * le plus large sert de pivot : son rang dans le conteneur cible, comparé
+     * à i, resserre l'intervalle de chaque conteneur jusqu'à ce qu'ils soient
+     * tous réduits à un point.
+     *
+     * @param[in] i - le rang dans le conteneur cible ;
+     * @param[in] runs - les conteneurs à fusionner ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total strict régissant les conteneurs ;
+     * @param[out] j - les rangs dans chacun des conteneurs, de somme i.
+     */
+    template< typename OutputSize,
+	      typename InputRandomAccessIterator,
+	      typename InputSize,
+	      typename Compare >
+    static void coRank(const OutputSize& i,
+		       const std::vector< std::pair< InputRandomAccessIterator,
+						     InputRandomAccessIterator > >&
+		       runs,
+		       const Compare& comp,
+		       std::vector< InputSize >& j) {
+      const int k = runs.size();
+      if (k == 0) {
+	return;
+      }
+      std::vector< InputSize > lo(k, 0), hi(k), c(k);
+      for (int s = 0; s != k; s ++) {
+	hi[s] = runs[s].second - runs[s].first;
+      }
+      while (true) {
+
+	// Le pivot : l'élément médian de l'intervalle le plus large.
+	int p = 0;
+	for (int s = 1; s != k; s ++) {
+	  if (hi[s] - lo[s] > hi[p] - lo[p]) {
+	    p = s;
+	  }
+	}
+	if (hi[p] == lo[p]) {
+	  break;
+	}
+	const InputSize m = lo[p] + (hi[p] - lo[p]) / 2;
+	const InputRandomAccessIterator x = runs[p].first + m;
+
+	// Nombre d'éléments de chaque conteneur précédant le pivot : les
+	// éléments équivalents des conteneurs précédents le précèdent, ceux des
+	// conteneurs suivants le suivent.
+	OutputSize rank = 0;
+	for (int s = 0; s != k; s ++) {
+	  if (s < p) {
+	    c[s] = std::upper_bound(runs[s].first, runs[s].second, *x, comp)
+	      - runs[s].first;
+	  } else if (s > p) {
+	    c[s] = std::lower_bound(runs[s].first, runs[s].second, *x, comp)
+	      - runs[s].first;
+	  } else {
+	    c[s] = m;
+	  }
+	  rank += c[s];
+	}
+
+	// Le pivot précède la position i : lui et tous les éléments qui le
+	// précèdent se trouvent avant elle. Sinon, il se trouve après elle, de
+	// même que tous les éléments qui le suivent.
+	if (rank < i) {
+	  for (int s = 0; s != k; s ++) {
+	    lo[s] = std::max(lo[s], c[s]);
+	  }
+	  lo[p] = m + 1;
+	} else {
+	  for (int s = 0; s != k; s ++) {
+	    hi[s] = std::min(hi[s], c[s]);
+	  }
+	}
+
+      }
+      j = lo;
+
+    } // coRank
+
+    /**
+     * Fusion séquentielle de k tranches via un arbre des perdants : chaque
+     * noeud interne retient le perdant du match entre ses deux sous-arbres,
+     * le vainqueur remontant vers la racine. Après chaque recopie, seul le
+     * chemin de la feuille du vainqueur à la racine est rejoué, soit log2(k)
+     * comparaisons. L'arbre, un simple tableau de k indices, tient dans le
+     * cache L1.
+     *
+     * @param[in] slices - les tranches à fusionner ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total strict régissant les tranches.
+     */
+    template< typename InputRandomAccessIterator,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static void loserTree(const std::vector< std::pair<
+			  InputRandomAccessIterator,
+			  InputRandomAccessIterator > >& slices,
+			  OutputRandomAccessIterator result,
+			  const Compare& comp) {
+
+      // Nombre de feuilles, arrondi à une puissance de 2 (les feuilles
+      // supplémentaires sont des tranches vides), et nombre d'éléments à
+      // recopier.
+      const int k = slices.size();
+      int feuilles = 1;
+      while (feuilles < k) {
+	feuilles *= 2;
+      }
+      size_t total = 0;
+      for (int s = 0; s != k; s ++) {
+	total += slices[s].second - slices[s].first;
+      }
+
+      // Têtes des tranches, et tranches épuisées (dont les feuilles
+      // supplémentaires), rangées de manière contiguë. Une tranche épuisée
+      // n'est signalée que par son drapeau : aucune valeur sentinelle n'est
+      // construite.
+      std::vector< InputRandomAccessIterator > tetes(feuilles);
+      std::vector< char > epuisees(feuilles, 1);
+      for (int s = 0; s != k; s ++) {
+	tetes[s] = slices[s].first;
+	epuisees[s] = slices[s].first == slices[s].second;
+      }
+
+      // La tranche s l'emporte sur la tranche t si sa tête est strictement
+      // inférieure, ou équivalente mais issue d'un conteneur précédent : une
+      // seule comparaison suffit (s < t ? ! comp(ct, cs) : comp(cs, ct)),
+      // écrite sans branchement. Une tranche épuisée perd toujours. Les têtes sont
+      // lues par référence (éventuellement à une valeur à déplacer) : aucune
+      // n'est recopiée.
+      auto gagne = [&tetes, &epuisees, &comp](const int& s, const int& t)
+	-> bool {
+	if (epuisees[s] | epuisees[t]) {
+	  return ! epuisees[s];
+	}
+	const bool ordre = s < t;
+	const int x = ordre ? t : s;
+	const int y = ordre ? s : t;
+	return comp(*tetes[x], *tetes[y]) != ordre;
+      };
+
+      // Construction de l'arbre : arbre[0] accueille le vainqueur, arbre[n]
+      // (1 <= n < feuilles) l'indice du perdant du match du noeud n. Les
+      // vainqueurs des sous-arbres sont calculés de bas en haut.
+      std::vector< int > arbre(feuilles), vainqueurs(2 * feuilles);
+      for (int f = 0; f != feuilles; f ++) {
+	vainqueurs[feuilles + f] = f;
+      }
+      for (int n = feuilles - 1; n >= 1; n --) {
+	const int g = vainqueurs[2 * n];
+	const int d = vainqueurs[2 * n + 1];
+	const bool gauche = gagne(g, d);
+	vainqueurs[n] = gauche ? g : d;
+	arbre[n] = gauche ? d : g;
+      }
+      arbre[0] = vainqueurs[1];
+
+      // Recopie (ou déplacement, pour des std::move_iterator) du vainqueur
+      // puis rejeu de son chemin jusqu'à la racine.
+      for (size_t i = 0; i != total; i ++) {
+	int w = arbre[0];
+	*result = *tetes[w];
+	++ result;
+	epuisees[w] = ++ tetes[w] == slices[w].second;
+	for (int n = (feuilles + w) / 2; n >= 1; n /= 2) {
+	  if (gagne(arbre[n], w)) {
+	    std::swap(arbre[n], w);
+	  }
+	}
+	arbre[0] = w;
+      }
+
+    } // loserTree
+
+  }; // ParallelMultiwayMerge
+
+} // merging
+
+#endif
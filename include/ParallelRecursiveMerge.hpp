@@ -1,8 +1,14 @@
 #ifndef ParallelRecursiveMerge_hpp
 #define ParallelRecursiveMerge_hpp
 
+#include "BitonicMerge.hpp"
+#include "OpenMPExecutor.hpp"
+#include "ParallelStableMerge.hpp"
 #include <functional>
 #include <algorithm>
+#include <iterator>
+#include <utility>
+#include <unistd.h>
 #include <omp.h>
 
 namespace merging {
@@ -10,14 +16,31 @@ namespace merging {
   /**
    * @class ParallelRecursiveMerge ParallelRecursiveMerge.hpp
    *
-   * Version OpenMP de l'algorithme merge de la biblothèque standard.
+   * Version OpenMP de l'algorithme merge de la biblothèque standard. Le
+   * parallélisme peut aussi être confié à un exécuteur (OpenMPExecutor,
+   * TBBExecutor ou ThreadPoolExecutor) passé en paramètre.
    *
    * @note L'implémentation proposée est celle du recursive merging décrite dans
    *   Thomas H. Cormen, Charles E. Leiserson, Ronald L. Rivest and Clifford
    *   Stein, "Introduction to Algorithms", 3rd ed., 2009, pp 798-802. La
    *   récursion est interrompue lorsque la somme des tailles des deux
    *   sous-conteneurs à fusionner passe sous une certaine tolérance. La fusion
-   *   est alors effectuée via l'algorithme merge de la bibliothèque standard.
+   *   est alors effectuée via l'algorithme merge de la bibliothèque standard,
+   *   ou via le noyau vectoriel BitonicMerge lorsque les types le permettent
+   *   (entiers ou flottants de 32 ou 64 bits stockés de manière contiguë,
+   *   comparateur std::less).
+   * @note À chaque niveau de récursion, les suites de clés égales au pivot
+   *   sont réparties entre les deux fusions de sorte à équilibrer leurs
+   *   tailles (cf. split) : la fusion reste stable, et la récursion ne
+   *   dégénère pas sur des données comportant beaucoup de doublons.
+   * @note Le mode par tuiles (applyTiled) ne procède pas récursivement : le
+   *   conteneur cible est découpé en tuiles tenant dans le cache L2, dont
+   *   les bornes dans les conteneurs sources sont obtenues par co-rang
+   *   (cf. ParallelStableMerge::coRank) ; chaque thread fusionne
+   *   séquentiellement une suite de tuiles consécutives, via le même noyau
+   *   que les feuilles de la récursion.
+   * @note Le mode par déplacement (applyMove) fusionne des std::move_iterator :
+   *   les éléments sont alors déplacés par les feuilles.
    */
   class ParallelRecursiveMerge {
   public:
@@ -121,11 +144,63 @@ namespace merging {
 
     } // apply
 
-  protected:
+    /**
+     * Forme générale de l'algorithme, le parallélisme étant confié à un
+     * exécuteur.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée séquentiellement ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp,
+	  const size_t& cutoff,
+	  const Executor& executor) {
+
+      // Invocation de la stratégie reposant sur l'exécuteur.
+      executor.run([&]() {
+	  strategyA(first1,
+		    last1,
+		    first2,
+		    last2,
+		    result,
+		    comp,
+		    cutoff,
+		    executor);
+	});
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + (last1 - first1) + (last2 - first2);
+
+    } // apply
 
     /**
-     * Implémentation MIMD de cet algorithme basée sur l'utilisation de
-     * sections parallèles.
+     * Forme spécifique de l'algorithme pour la relation d'ordre total
+     * strictement inférieur à, le parallélisme étant confié à un exécuteur.
      *
      * @param[in] first1 - un itérateur repérant le premier élément du premier
      *   sous-conteneur concerné par la fusion ;
@@ -137,6 +212,53 @@ namespace merging {
      *   le dernier élément du second sous-conteneur concerné par la fusion ;
      * @param[in] result - un itérateur repérant la position ou récopier le
      *   premier élément résultant de la fusion ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée séquentiellement ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const size_t& cutoff,
+	  const Executor& executor) {
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+      return apply(first1,
+		   last1,
+		   first2,
+		   last2,
+		   result,
+		   std::less< const value_type& >(),
+		   cutoff,
+		   executor);
+    } // apply
+
+    /**
+     * Mode par déplacement de l'algorithme : les éléments des deux
+     * sous-conteneurs sont déplacés et non recopiés (ni copie ni allocation
+     * par élément), les deux sous-conteneurs n'étant plus exploitables
+     * (hormis pour y affecter de nouvelles valeurs ou les détruire) après la
+     * fusion.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou déplacer le
+     *   premier élément résultant de la fusion ;
      * @param[in] comp - un comparateur binaire représentant la relation d'ordre
      *   total régissant les sous-conteneurs ;
      * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
@@ -149,87 +271,251 @@ namespace merging {
 	      typename InputRandomAccessIterator2,
 	      typename OutputRandomAccessIterator,
 	      typename Compare >
+    static OutputRandomAccessIterator
+    applyMove(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare& comp,
+	      const size_t& cutoff) {
+      return apply(std::make_move_iterator(first1),
+		   std::make_move_iterator(last1),
+		   std::make_move_iterator(first2),
+		   std::make_move_iterator(last2),
+		   result,
+		   comp,
+		   cutoff);
+    } // applyMove
+
+    /**
+     * Mode par déplacement de l'algorithme, le parallélisme étant confié à
+     * un exécuteur.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou déplacer le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée séquentiellement ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    applyMove(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare& comp,
+	      const size_t& cutoff,
+	      const Executor& executor) {
+      return apply(std::make_move_iterator(first1),
+		   std::make_move_iterator(last1),
+		   std::make_move_iterator(first2),
+		   std::make_move_iterator(last2),
+		   result,
+		   comp,
+		   cutoff,
+		   executor);
+    } // applyMove
+
+    /**
+     * Mode par tuiles de l'algorithme, la taille des tuiles étant déduite de
+     * celle du cache L2.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    applyTiled(const InputRandomAccessIterator1& first1,
+	       const InputRandomAccessIterator1& last1,
+	       const InputRandomAccessIterator2& first2,
+	       const InputRandomAccessIterator2& last2,
+	       const OutputRandomAccessIterator& result,
+	       const Compare& comp,
+	       const Executor& executor) {
+      typedef std::iterator_traits< OutputRandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+      return applyTiled(first1,
+			last1,
+			first2,
+			last2,
+			result,
+			comp,
+			tile(sizeof(value_type)),
+			executor);
+    } // applyTiled
 
+    /**
+     * Mode par tuiles de l'algorithme.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] tile - le nombre d'éléments du conteneur cible par tuile ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor).
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    applyTiled(const InputRandomAccessIterator1& first1,
+	       const InputRandomAccessIterator1& last1,
+	       const InputRandomAccessIterator2& first2,
+	       const InputRandomAccessIterator2& last2,
+	       const OutputRandomAccessIterator& result,
+	       const Compare& comp,
+	       const size_t& tile,
+	       const Executor& executor) {
+
+      // Invocation de la stratégie par tuiles.
+      executor.run([&]() {
+	  strategyC(first1,
+		    last1,
+		    first2,
+		    last2,
+		    result,
+		    comp,
+		    std::max(tile, size_t(1)),
+		    executor);
+	});
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + (last1 - first1) + (last2 - first2);
+
+    } // applyTiled
+
+  protected:
+
+    /**
+     * Implémentation MIMD de cet algorithme basée sur l'utilisation d'un
+     * exécuteur : les deux fusions issues de chaque niveau de récursion sont
+     * confiées à sa méthode invoke. Aucune région parallèle n'est ouverte
+     * ici, à la différence d'une imbrication de sections OpenMP qui créerait
+     * une nouvelle équipe de threads à chaque niveau.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée séquentiellement ;
+     * @param[in] executor - l'exécuteur, au sein duquel cette méthode doit
+     *   être invoquée (cf. OpenMPExecutor::run).
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
     static void strategyA(const InputRandomAccessIterator1& first1,
 			  const InputRandomAccessIterator1& last1,
 			  const InputRandomAccessIterator2& first2,
 			  const InputRandomAccessIterator2& last2,
 			  const OutputRandomAccessIterator& result,
 			  const Compare& comp,
-			  const size_t& cutoff) {
+			  const size_t& cutoff,
+			  const Executor& executor) {
 
       // Taille des deux sous-conteneurs.
       const auto size1 = last1 - first1;
       const auto size2 = last2 - first2;
 
-      // Nous sommes passés sous la tolérance : la récursion s'arrête.
-      if (static_cast< size_t >(size1 + size2) < cutoff) {
-        std::merge(first1, last1, first2, last2, result, comp);
-	return;
-      }
-
-
-      // Le sous-conteneur correspondant à l'opérande gauche est par convention
-      // plus long que celui correspondant à l'opérande droit. Si ce n'est pas
-      // le cas, nous remettons les choses en ordre.
-
-      if (size1 < size2) {
-        strategyA(first2,
-		  last2,
-		  first1,
-		  last1,
-		  result,
-		  comp,
-		  cutoff);
+      // Nous sommes passés sous la tolérance : la récursion s'arrête, la
+      // fusion étant vectorisée si les types le permettent.
+      if (static_cast< size_t >(size1 + size2) < std::max(cutoff, size_t(2))) {
+	BitonicMerge::merge(first1, last1, first2, last2, result, comp);
 	return;
       }
 
-      // Itérateur repérant l'élément médian dans le sous-conteneur gauche.
-      const InputRandomAccessIterator1 middle1 =
-	first1 + size1 / 2 + size1 % 2;
-
-      // Itérateur repérant l'élément pivot dans le sous-conteneur droit.
-      const InputRandomAccessIterator2 middle2 =
-	std::lower_bound(first2, last2, *middle1, comp);
+      // Partage des deux sous-conteneurs en deux fusions de tailles
+      // équilibrées (cf. split).
+      const std::pair< InputRandomAccessIterator1,
+		       InputRandomAccessIterator2 > middle =
+	split(first1, last1, first2, last2, comp);
 
       // Itérateur répérant la position du sous-conteneur résultat à laquelle
-      // sera implanté l'élément médian du sous-conteneur gauche.
+      // débute la seconde fusion.
       const OutputRandomAccessIterator middle3 =
-	result + (middle1 - first1) + (middle2 - first2);
-
-      // Recopie de l'élément médian du sous-conteneur gauche dans le
-      // sous-conteneur résultat.
-      *middle3 = *middle1;
+	result + (middle.first - first1) + (middle.second - first2);
+
+      // Fusion des parties situées à gauche des points de partage, et fusion
+      // des parties situées à droite.
+      executor.invoke([&]() {
+	  strategyA(first1,
+		    middle.first,
+		    first2,
+		    middle.second,
+		    result,
+		    comp,
+		    cutoff,
+		    executor);
+	},
+	[&]() {
+	  strategyA(middle.first,
+		    last1,
+		    middle.second,
+		    last2,
+		    middle3,
+		    comp,
+		    cutoff,
+		    executor);
+	});
 
-      // Fusion de la partie située à gauche de l'élément médian dans le
-      // sous-conteneur gauche avec la partie située à gauche de l'élément
-      // pivot dans le sous-conteneur droit.
-      #pragma omp parallel
-      {
-        #pragma omp sections
-        {
-        #pragma omp section
-        strategyA(first1,
-                  middle1,
-                  first2,
-                  middle2,
-                  result,
-                  comp,
-                  cutoff);
-
-        // Fusion de la partie située à droite de l'élément médian dans le
-        // sous-conteneur gauche avec la partie située à droite (élément pivot
-        // inclu) de l'élément pivot dans le sous-conteneur droit.
-        #pragma omp section
-        strategyA(middle1 + 1,
-                  last1,
-                  middle2,
-                  last2,
-                  middle3 + 1,
-                  comp,
-                  cutoff);
-        }
-      }
     } // strategyA
 
     /**
@@ -313,66 +599,43 @@ namespace merging {
       const auto size1 = last1 - first1;
       const auto size2 = last2 - first2;
 
-      // Nous sommes passés sous la tolérance : la récursion s'arrête.
-      if (static_cast< size_t >(size1 + size2) < cutoff) {
-	std::merge(first1, last1, first2, last2, result, comp);
+      // Nous sommes passés sous la tolérance : la récursion s'arrête, la
+      // fusion étant vectorisée si les types le permettent.
+      if (static_cast< size_t >(size1 + size2) < std::max(cutoff, size_t(2))) {
+	BitonicMerge::merge(first1, last1, first2, last2, result, comp);
 	return;
       }
 
-      // Le sous-conteneur correspondant à l'opérande gauche est par convention
-      // plus long que celui correspondant à l'opérande droit. Si ce n'est pas
-      // le cas, nous remettons les choses en ordre.
-      if (size1 < size2) {
-	strategyBTasking(first2,
-			 last2,
-			 first1,
-			 last1,
-			 result,
-			 comp,
-			 cutoff);
-	return;
-      }
-
-      // Itérateur repérant l'élément médian dans le sous-conteneur gauche.
-      const InputRandomAccessIterator1 middle1 =
-	first1 + size1 / 2 + size1 % 2;
-
-      // Itérateur repérant l'élément pivot dans le sous-conteneur droit.
-      const InputRandomAccessIterator2 middle2 =
-	std::lower_bound(first2, last2, *middle1, comp);
+      // Partage des deux sous-conteneurs en deux fusions de tailles
+      // équilibrées (cf. split).
+      const std::pair< InputRandomAccessIterator1,
+		       InputRandomAccessIterator2 > middle =
+	split(first1, last1, first2, last2, comp);
 
       // Itérateur répérant la position du sous-conteneur résultat à laquelle
-      // sera implanté l'élément médian du sous-conteneur gauche.
+      // débute la seconde fusion.
       const OutputRandomAccessIterator middle3 =
-	result + (middle1 - first1) + (middle2 - first2);
+	result + (middle.first - first1) + (middle.second - first2);
 
-      // Recopie de l'élément médian du sous-conteneur gauche dans le
-      // sous-conteneur résultat.
-      *middle3 = *middle1;
-
-      // Fusion de la partie située à gauche de l'élément médian dans le
-      // sous-conteneur gauche avec la partie située à gauche de l'élément
-      // pivot dans le sous-conteneur droit.
+      // Fusion des parties situées à gauche des points de partage.
       #pragma omp task untied
       {
       strategyBTasking(first1,
-        middle1,
+        middle.first,
         first2,
-        middle2,
+        middle.second,
         result,
         comp,
         cutoff);
       }
-      // Fusion de la partie située à droite de l'élément médian dans le
-      // sous-conteneur gauche avec la partie située à droite (élément pivot
-      // inclu) de l'élément pivot dans le sous-conteneur droit.
+      // Fusion des parties situées à droite des points de partage.
       #pragma omp task untied
       {
-      strategyBTasking(middle1 + 1,
+      strategyBTasking(middle.first,
         last1,
-        middle2,
+        middle.second,
         last2,
-        middle3 + 1,
+        middle3,
         comp,
         cutoff);
 
@@ -380,6 +643,195 @@ namespace merging {
       #pragma omp taskwait
     } // strategyBTasking
 
+    /**
+     * Partage de deux sous-conteneurs en deux fusions indépendantes de
+     * tailles équilibrées, en tenant compte des suites de clés égales.
+     *
+     * L'élément médian du plus long sous-conteneur sert de pivot : la suite
+     * des éléments équivalents au pivot est localisée dans chacun des deux
+     * sous-conteneurs. Dans le conteneur cible, ces éléments forment un bloc
+     * unique (ceux du premier sous-conteneur, puis ceux du second) qui peut
+     * être coupé en n'importe quel point sans rompre la stabilité de la
+     * fusion : il est coupé au plus près du milieu du conteneur cible. Une
+     * longue suite de clés égales est ainsi répartie entre les deux fusions
+     * au lieu de revenir en entier à l'une d'elles.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return les points de partage dans le premier et le second
+     *   sous-conteneur. Pour au moins deux éléments au total, chacune des deux
+     *   fusions en reçoit au moins un.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename Compare >
+    static std::pair< InputRandomAccessIterator1, InputRandomAccessIterator2 >
+    split(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const Compare& comp) {
+
+      // Taille des deux sous-conteneurs.
+      const auto size1 = last1 - first1;
+      const auto size2 = last2 - first2;
+
+      // Suites des éléments équivalents au pivot dans les deux
+      // sous-conteneurs. Le pivot n'est lu que par référence constante : il
+      // n'est pas déplacé lorsque les sous-conteneurs sont parcourus par des
+      // std::move_iterator.
+      InputRandomAccessIterator1 lo1, hi1;
+      InputRandomAccessIterator2 lo2, hi2;
+      if (size1 >= size2) {
+	const InputRandomAccessIterator1 pivot = first1 + size1 / 2;
+	lo1 = std::lower_bound(first1, pivot, *pivot, comp);
+	hi1 = std::upper_bound(pivot, last1, *pivot, comp);
+	lo2 = std::lower_bound(first2, last2, *pivot, comp);
+	hi2 = std::upper_bound(lo2, last2, *pivot, comp);
+      } else {
+	const InputRandomAccessIterator2 pivot = first2 + size2 / 2;
+	lo2 = std::lower_bound(first2, pivot, *pivot, comp);
+	hi2 = std::upper_bound(pivot, last2, *pivot, comp);
+	lo1 = std::lower_bound(first1, last1, *pivot, comp);
+	hi1 = std::upper_bound(lo1, last1, *pivot, comp);
+      }
+
+      // Rang du bloc des éléments équivalents au pivot dans le conteneur
+      // cible, et rang du point de coupe dans ce bloc (au plus près du
+      // milieu du conteneur cible).
+      const auto debut = (lo1 - first1) + (lo2 - first2);
+      const auto egaux1 = hi1 - lo1;
+      const auto egaux = egaux1 + (hi2 - lo2);
+      const auto coupe =
+	std::min(std::max((size1 + size2) / 2 - debut, decltype(egaux)(0)),
+		 egaux);
+
+      // Les éléments du premier sous-conteneur précèdent ceux du second.
+      if (coupe <= egaux1) {
+	return std::make_pair(lo1 + coupe, lo2);
+      }
+      return std::make_pair(hi1, lo2 + (coupe - egaux1));
+
+    } // split
+
+    /**
+     * Implémentation MIMD de cet algorithme par tuiles : le conteneur cible
+     * est découpé en tuiles de taille fixe, les tuiles sont réparties par
+     * blocs de tuiles consécutives entre les threads de l'exécuteur, et
+     * chaque tuile est fusionnée séquentiellement. Les bornes d'une tuile
+     * dans les deux sous-conteneurs sont obtenues par co-rang : chaque
+     * thread produit ainsi exactement le même nombre d'éléments (à une tuile
+     * près) en parcourant les trois conteneurs de manière séquentielle.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] tile - le nombre (non nul) d'éléments du conteneur cible par
+     *   tuile ;
+     * @param[in] executor - l'exécuteur, au sein duquel cette méthode doit
+     *   être invoquée (cf. OpenMPExecutor::run).
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static void strategyC(const InputRandomAccessIterator1& first1,
+			  const InputRandomAccessIterator1& last1,
+			  const InputRandomAccessIterator2& first2,
+			  const InputRandomAccessIterator2& last2,
+			  const OutputRandomAccessIterator& result,
+			  const Compare& comp,
+			  const size_t& tile,
+			  const Executor& executor) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+      typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+      typedef std::iterator_traits< OutputRandomAccessIterator > TraitsOutput;
+      typedef typename TraitsInput1::difference_type InputSize1;
+      typedef typename TraitsInput2::difference_type InputSize2;
+      typedef typename TraitsOutput::difference_type OutputSize;
+
+      // Tailles des deux sous-conteneurs, du conteneur cible et nombre de
+      // tuiles.
+      const InputSize1 m = last1 - first1;
+      const InputSize2 n = last2 - first2;
+      const OutputSize mpn = m + n;
+      const OutputSize taille = tile;
+      const OutputSize tuiles = (mpn + taille - 1) / taille;
+
+      // Chaque thread fusionne un bloc de tuiles consécutives, le co-rang de
+      // la fin d'une tuile étant celui du début de la suivante.
+      const int threads = executor.concurrency();
+      executor.parallelFor(0, threads, [&](const int& r) {
+	  const OutputSize t0 = tuiles * r / threads;
+	  const OutputSize t1 = tuiles * (r + 1) / threads;
+	  if (t0 == t1) {
+	    return;
+	  }
+	  OutputSize i = t0 * taille;
+	  InputSize1 j;
+	  InputSize2 k;
+	  ParallelStableMerge::coRank(i, first1, m, first2, n, comp, j, k);
+	  for (OutputSize t = t0; t != t1; t ++) {
+	    const OutputSize i1 = std::min(i + taille, mpn);
+	    InputSize1 j1;
+	    InputSize2 k1;
+	    ParallelStableMerge::coRank(i1, first1, m, first2, n, comp,
+					j1, k1);
+	    BitonicMerge::merge(first1 + j,
+				first1 + j1,
+				first2 + k,
+				first2 + k1,
+				result + i,
+				comp);
+	    i = i1;
+	    j = j1;
+	    k = k1;
+	  }
+	});
+
+    } // strategyC
+
+  private:
+
+    /**
+     * Nombre d'éléments d'une tuile : les éléments lus et les éléments écrits
+     * par la fusion d'une tuile, en nombre égal, doivent tenir ensemble dans
+     * le cache L2 (256 Kio si sa taille ne peut être déterminée).
+     *
+     * @param[in] bytes - la taille d'un élément, en octets.
+     * @return le nombre d'éléments d'une tuile.
+     */
+    static size_t tile(const size_t& bytes) {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+      static const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#else
+      static const long l2 = 0;
+#endif
+      const size_t cache = l2 > 0 ? l2 : 256 * 1024;
+      return std::max(cache / (2 * bytes), size_t(1));
+    } // tile
+
   }; // ParallelRecursiveMerge
 
 } // merging
@@ -0,0 +1,414 @@
+#ifndef ParallelSetOperations_hpp
+#define ParallelSetOperations_hpp
+
+#include "ParallelStableMerge.hpp"
+#include "SimdIntersection.hpp"
+#include "TBBExecutor.hpp"
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <vector>
+
+namespace merging {
+
+  /**
+   * @class ParallelSetOperations ParallelSetOperations.hpp
+   *
+   * Versions parallèles des algorithmes set_union, set_intersection et
+   * set_difference de la bibliothèque standard. Le conteneur cible de la
+   * fusion des deux sous-conteneurs est partagé en tranches égales, une par
+   * thread de l'exécuteur, par co-rang (cf. ParallelStableMerge::coRankGroup)
+   * sans qu'aucun groupe d'éléments égaux ne soit partagé entre deux
+   * tranches. Chaque opération se déroule alors en trois temps :
+   * - chaque thread dénombre les éléments de l'intersection de sa tranche,
+   *   dont se déduisent ceux de l'union (m + n - intersection) et de la
+   *   différence (m - intersection) ;
+   * - une somme préfixe de ces tailles donne la position de chaque tranche
+   *   dans le conteneur cible ;
+   * - chaque thread recopie le résultat de sa tranche à sa position, sans
+   *   le moindre verrou.
+   *
+   * @note Les résultats sont ceux des algorithmes de la bibliothèque
+   *   standard, y compris pour des multi-ensembles (éléments répétés).
+   * @note L'intersection, ainsi que les dénombrements, sont confiés au noyau
+   *   vectoriel SimdIntersection pour des entiers de 32 bits ordonnés par
+   *   std::less.
+   */
+  class ParallelSetOperations {
+  public:
+
+    /**
+     * Union parallèle.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément de l'union ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les sous-conteneurs ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor), chacun de ses
+     *   threads traitant une tranche.
+     * @return un itérateur repérant la fin de l'union dans le conteneur
+     *   cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    setUnion(const InputRandomAccessIterator1& first1,
+	     const InputRandomAccessIterator1& last1,
+	     const InputRandomAccessIterator2& first2,
+	     const InputRandomAccessIterator2& last2,
+	     const OutputRandomAccessIterator& result,
+	     const Compare& comp,
+	     const Executor& executor) {
+      return apply< Union >(first1, last1, first2, last2, result, comp,
+			    executor);
+    } // setUnion
+
+    /**
+     * Union parallèle via TBB.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément de l'union ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de l'union dans le conteneur
+     *   cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    setUnion(const InputRandomAccessIterator1& first1,
+	     const InputRandomAccessIterator1& last1,
+	     const InputRandomAccessIterator2& first2,
+	     const InputRandomAccessIterator2& last2,
+	     const OutputRandomAccessIterator& result,
+	     const Compare& comp,
+	     const int& threads) {
+      return apply< Union >(first1, last1, first2, last2, result, comp,
+			    TBBExecutor(threads));
+    } // setUnion
+
+    /**
+     * Intersection parallèle.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément de l'intersection ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les sous-conteneurs ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor), chacun de ses
+     *   threads traitant une tranche.
+     * @return un itérateur repérant la fin de l'intersection dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    setIntersection(const InputRandomAccessIterator1& first1,
+		    const InputRandomAccessIterator1& last1,
+		    const InputRandomAccessIterator2& first2,
+		    const InputRandomAccessIterator2& last2,
+		    const OutputRandomAccessIterator& result,
+		    const Compare& comp,
+		    const Executor& executor) {
+      return apply< Intersection >(first1, last1, first2, last2, result, comp,
+				   executor);
+    } // setIntersection
+
+    /**
+     * Intersection parallèle via TBB.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément de l'intersection ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de l'intersection dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    setIntersection(const InputRandomAccessIterator1& first1,
+		    const InputRandomAccessIterator1& last1,
+		    const InputRandomAccessIterator2& first2,
+		    const InputRandomAccessIterator2& last2,
+		    const OutputRandomAccessIterator& result,
+		    const Compare& comp,
+		    const int& threads) {
+      return apply< Intersection >(first1, last1, first2, last2, result, comp,
+				   TBBExecutor(threads));
+    } // setIntersection
+
+    /**
+     * Différence parallèle : les éléments du premier sous-conteneur absents
+     * du second.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément de la différence ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les sous-conteneurs ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor), chacun de ses
+     *   threads traitant une tranche.
+     * @return un itérateur repérant la fin de la différence dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    setDifference(const InputRandomAccessIterator1& first1,
+		  const InputRandomAccessIterator1& last1,
+		  const InputRandomAccessIterator2& first2,
+		  const InputRandomAccessIterator2& last2,
+		  const OutputRandomAccessIterator& result,
+		  const Compare& comp,
+		  const Executor& executor) {
+      return apply< Difference >(first1, last1, first2, last2, result, comp,
+				 executor);
+    } // setDifference
+
+    /**
+     * Différence parallèle via TBB.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément de la différence ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   strict régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la différence dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    setDifference(const InputRandomAccessIterator1& first1,
+		  const InputRandomAccessIterator1& last1,
+		  const InputRandomAccessIterator2& first2,
+		  const InputRandomAccessIterator2& last2,
+		  const OutputRandomAccessIterator& result,
+		  const Compare& comp,
+		  const int& threads) {
+      return apply< Difference >(first1, last1, first2, last2, result, comp,
+				 TBBExecutor(threads));
+    } // setDifference
+
+  private:
+
+    /**
+     * Union d'une tranche : m + n - intersection éléments.
+     */
+    struct Union {
+
+      static size_t size(const size_t& m,
+			 const size_t& n,
+			 const size_t& intersection) {
+	return m + n - intersection;
+      }
+
+      template< typename InputRandomAccessIterator1,
+		typename InputRandomAccessIterator2,
+		typename OutputRandomAccessIterator,
+		typename Compare >
+      static void write(const InputRandomAccessIterator1& first1,
+			const InputRandomAccessIterator1& last1,
+			const InputRandomAccessIterator2& first2,
+			const InputRandomAccessIterator2& last2,
+			const OutputRandomAccessIterator& result,
+			const Compare& comp) {
+	std::set_union(first1, last1, first2, last2, result, comp);
+      }
+
+    }; // Union
+
+    /**
+     * Intersection d'une tranche.
+     */
+    struct Intersection {
+
+      static size_t size(const size_t&,
+			 const size_t&,
+			 const size_t& intersection) {
+	return intersection;
+      }
+
+      template< typename InputRandomAccessIterator1,
+		typename InputRandomAccessIterator2,
+		typename OutputRandomAccessIterator,
+		typename Compare >
+      static void write(const InputRandomAccessIterator1& first1,
+			const InputRandomAccessIterator1& last1,
+			const InputRandomAccessIterator2& first2,
+			const InputRandomAccessIterator2& last2,
+			const OutputRandomAccessIterator& result,
+			const Compare& comp) {
+	SimdIntersection::intersect(first1, last1, first2, last2, result,
+				    comp);
+      }
+
+    }; // Intersection
+
+    /**
+     * Différence d'une tranche : m - intersection éléments.
+     */
+    struct Difference {
+
+      static size_t size(const size_t& m,
+			 const size_t&,
+			 const size_t& intersection) {
+	return m - intersection;
+      }
+
+      template< typename InputRandomAccessIterator1,
+		typename InputRandomAccessIterator2,
+		typename OutputRandomAccessIterator,
+		typename Compare >
+      static void write(const InputRandomAccessIterator1& first1,
+			const InputRandomAccessIterator1& last1,
+			const InputRandomAccessIterator2& first2,
+			const InputRandomAccessIterator2& last2,
+			const OutputRandomAccessIterator& result,
+			const Compare& comp) {
+	std::set_difference(first1, last1, first2, last2, result, comp);
+      }
+
+    }; // Difference
+
+    /**
+     * Implémentation parallèle commune aux trois opérations.
+     */
+    template< typename Operation,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp,
+	  const Executor& executor) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+      typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+      typedef std::iterator_traits< OutputRandomAccessIterator > TraitsOutput;
+      typedef typename TraitsInput1::difference_type InputSize1;
+      typedef typename TraitsInput2::difference_type InputSize2;
+      typedef typename TraitsOutput::difference_type OutputSize;
+
+      // Tailles respectives des deux sous-conteneurs et de leur fusion.
+      const InputSize1 m = last1 - first1;
+      const InputSize2 n = last2 - first2;
+      const OutputSize mpn = m + n;
+
+      // Bornes des tranches dans les deux sous-conteneurs (j et k) et
+      // positions de leurs résultats dans le conteneur cible (o).
+      const int threads = executor.concurrency();
+      std::vector< InputSize1 > j(threads + 1);
+      std::vector< InputSize2 > k(threads + 1);
+      std::vector< OutputSize > o(threads + 1, 0);
+      executor.run([&]() {
+	  executor.parallelFor(0, threads + 1, [&](const int& r) {
+	      const OutputSize i = mpn * r / threads;
+	      ParallelStableMerge::coRankGroup(i, first1, m, first2, n, comp,
+					       j[r], k[r]);
+	    });
+
+	  // Taille du résultat de chaque tranche.
+	  executor.parallelFor(0, threads, [&](const int& r) {
+	      const size_t intersection =
+		SimdIntersection::count(first1 + j[r], first1 + j[r + 1],
+					first2 + k[r], first2 + k[r + 1],
+					comp);
+	      o[r + 1] = Operation::size(j[r + 1] - j[r], k[r + 1] - k[r],
+					 intersection);
+	    });
+
+	  // Somme préfixe : position du résultat de chaque tranche.
+	  std::partial_sum(o.begin(), o.end(), o.begin());
+
+	  // Chaque tranche recopie son résultat à sa position.
+	  executor.parallelFor(0, threads, [&](const int& r) {
+	      Operation::write(first1 + j[r], first1 + j[r + 1],
+			       first2 + k[r], first2 + k[r + 1],
+			       result + o[r], comp);
+	    });
+	});
+
+      // Respect de la sémantique des algorithmes de la bibliothèque standard.
+      return result + o[threads];
+
+    } // apply
+
+  }; // ParallelSetOperations
+
+} // merging
+
+#endif
@@ -1,10 +1,15 @@
 #ifndef ParallelStableMerge_hpp
 #define ParallelStableMerge_hpp
 
-#include <tbb/parallel_for.h>
+#include "BitonicMerge.hpp"
+#include "TBBExecutor.hpp"
 #include <functional>
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 #include <iostream>
 
@@ -14,13 +19,17 @@ namespace merging {
    * @class ParallelStableMerge ParallelStableMerge.hpp
    *
    * Version TBB (Intel Threading Building Blocks) de l'algorithme merge de la
-   * biblothèque standard.
+   * biblothèque standard. Le parallélisme peut aussi être confié à un autre
+   * exécuteur (OpenMPExecutor ou ThreadPoolExecutor) passé en paramètre.
    *
    * @note L'implémentation proposée est celle de l'algorithme de fusion stable
    *   et parallèle décrite dans C. Siebert and J.L. Träff, "Perfectly
    *   load-balanced, optimal, stable, parallel merge", CoRR, pp -1--1, 2013.
-   * @note Cette implémentation ne peut être employée qu'avec une relation
-   *   d'ordre de type <= ou >= mais pas < ou >.
+   * @note Tout comme l'algorithme merge, cette implémentation attend une
+   *   relation d'ordre strict (std::less par défaut) et elle est stable : à
+   *   égalité, les éléments du premier sous-conteneur précèdent ceux du
+   *   second. Un conteneur parcouru à l'envers (reverse_iterator) se fusionne
+   *   avec la relation inverse (std::greater).
    */
   class ParallelStableMerge {
   public:
@@ -40,14 +49,16 @@ namespace merging {
      *   premier élément résultant de la fusion ;
      * @param[in] comp - un comparateur binaire représentant la relation d'ordre
      *   total régissant les sous-conteneurs ;
-     * @param[in] threads - le nombre de threads disponibles.
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor), chacun de ses
+     *   threads fusionnant une tranche du conteneur cible.
      * @return un itérateur repérant la fin de la zone de fusion dans le
      *   conteneur cible.
      */
     template< typename InputRandomAccessIterator1,
 	      typename InputRandomAccessIterator2,
 	      typename OutputRandomAccessIterator,
-	      typename Compare >
+	      typename Compare,
+	      typename Executor >
     static OutputRandomAccessIterator
     apply(const InputRandomAccessIterator1& first1,
 	  const InputRandomAccessIterator1& last1,
@@ -55,7 +66,7 @@ namespace merging {
 	  const InputRandomAccessIterator2& last2,
 	  const OutputRandomAccessIterator& result,
 	  const Compare& comp,
-	  const int& threads) {
+	  const Executor& executor) {
 
       // Types synonymes permettant de ne rien préjuger des types entiers
       // manipulés.
@@ -73,55 +84,48 @@ namespace merging {
       // Calcul de la taille du conteneur accueillant la fusion.
       const OutputSize mpn = m + n;
 
-      // Calcul de la taille des fragments dans le conteneur cible de la fusion.
+      // Calcul de la taille des fragments dans le conteneur cible de la fusion,
+      // un par thread de l'exécuteur.
+      const int threads = executor.concurrency();
       const OutputSize taille = std::ceil(mpn * 1.0 / threads);
       const InputRandomAccessIterator1& a = first1;
-      const InputRandomAccessIterator1& b = first2;
+      const InputRandomAccessIterator2& b = first2;
       const OutputRandomAccessIterator& c = result;
 
-      tbb::parallel_for(0,
-			threads,
-			[taille,a,m,b,n,comp,c,mpn](const int & r)->void{
-         OutputSize ir = (r * taille);
-         OutputSize ir1 = (r + 1) * taille;
-
-	 // Attention à la taille réelle du dernier tronçon.
-	 if (ir1 > mpn) {
-	   ir1 = mpn;
-	 }
-
-         InputSize1 jr, jr1;
-         InputSize2 kr, kr1;
-         coRank(ir, a, m, b, n, comp, jr, kr);
-         coRank(ir1, a, m, b, n, comp, jr1, kr1);
-
-	 // Attention aux bornes exclues.
-         // std::merge(a+jr, a+jr1-1, b+kr, b+kr1-1, c+ir, comp);
-
-	 std::merge(a + jr,
-		    a + jr1,
-		    b + kr,
-		    b + kr1,
-		    c + ir,
-		    comp);
-
-	 /*
-         std::cout << "r: " << r << ' '
-                   << "ir: " << ir << ' ' << "ir1: " << ir1 << '\t'
-                   << "jr: "  << jr << ' ' << "jr1: " << jr1 << '\t'
-                   << "kr: "  << kr << ' ' << "kr1: " << kr1 << std::endl;
-	 */
-
-      });
+      // Les co-rangs des bornes des tranches sont tous calculés avant la
+      // moindre fusion : en mode par déplacement, une tranche ne doit pas
+      // être vidée pendant que le co-rang d'une borne voisine la consulte.
+      std::vector< InputSize1 > j(threads + 1);
+      std::vector< InputSize2 > k(threads + 1);
+      executor.run([&]() {
+	  executor.parallelFor(0, threads + 1, [&](const int& r) {
+	      // Attention à la taille réelle du dernier tronçon (les derniers
+	      // étant vides lorsque les threads sont plus nombreux que les
+	      // tranches).
+	      const OutputSize i = std::min(r * taille, mpn);
+	      coRank(i, a, m, b, n, comp, j[r], k[r]);
+	    });
+
+	  // La fusion de chaque tranche est vectorisée si les types le
+	  // permettent ; à égalité, l'algorithme merge place lui aussi les
+	  // éléments du premier sous-conteneur en tête.
+	  executor.parallelFor(0, threads, [&](const int& r) {
+	      BitonicMerge::merge(a + j[r],
+				  a + j[r + 1],
+				  b + k[r],
+				  b + k[r + 1],
+				  c + j[r] + k[r],
+				  comp);
+	    });
+	});
 
       // Respect de la sémantique de l'algorithme merge.
       return result + mpn;
 
     } // apply
 
-   /**
-     * Implémentation parallèle pour la relation d'ordre total inférieur ou
-     * égal.
+    /**
+     * Implémentation parallèle via TBB.
      *
      * @param[in] first1 - un itérateur repérant le premier élément du premier
      *   sous-conteneur concerné par la fusion ;
@@ -135,9 +139,91 @@ namespace merging {
      *   premier élément résultant de la fusion ;
      * @param[in] comp - un comparateur binaire représentant la relation d'ordre
      *   total régissant les sous-conteneurs ;
-     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
-     *   dessous de laquelle la fusion est effectuée via l'algorithme merge de
-     *   la bibliothèque standard.
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp,
+	  const int& threads) {
+      return apply(first1,
+		   last1,
+		   first2,
+		   last2,
+		   result,
+		   comp,
+		   TBBExecutor(threads));
+    } // apply
+
+    /**
+     * Mode par déplacement de l'implémentation parallèle : les éléments des
+     * deux sous-conteneurs sont déplacés et non recopiés (ni copie ni
+     * allocation par élément), les deux sous-conteneurs n'étant plus
+     * exploitables (hormis pour y affecter de nouvelles valeurs ou les
+     * détruire) après la fusion.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou déplacer le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] executor - l'exécuteur (cf. OpenMPExecutor), chacun de ses
+     *   threads fusionnant une tranche du conteneur cible.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename Executor >
+    static OutputRandomAccessIterator
+    applyMove(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare& comp,
+	      const Executor& executor) {
+      return apply(std::make_move_iterator(first1),
+		   std::make_move_iterator(last1),
+		   std::make_move_iterator(first2),
+		   std::make_move_iterator(last2),
+		   result,
+		   comp,
+		   executor);
+    } // applyMove
+
+    /**
+     * Implémentation parallèle pour la relation d'ordre strict inférieur.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] threads - le nombre de threads disponibles.
      * @return un itérateur repérant la fin de la zone de fusion dans le
      *   conteneur cible.
      */
@@ -165,18 +251,16 @@ namespace merging {
 		   first2,
 		   last2,
 		   result,
-		   std::less_equal< const value_type& >(),
+		   std::less< const value_type& >(),
 		   threads);
 
     } // apply
 
-  protected:
-
     /**
-     * Recherche dichotomique de la paire (j, k) représentant les rangs,
-     * respectivement dans le premier et le second conteneur, des éléments
-     * susceptibles d'être accueillis à la position de rang i dans le conteneur
-     * cible de la fusion.
+     * Recherche de la paire (j, k) représentant les rangs, respectivement
+     * dans le premier et le second conteneur, des éléments susceptibles
+     * d'être accueillis à la position de rang i dans le conteneur cible de la
+     * fusion.
      *
      * @param[in] i - le rang de l'élément actuellement traité dans le conteneur
      *   cible de la fusion ;
@@ -188,11 +272,23 @@ namespace merging {
      * @param[in] n - le nombre d'éléments du second conteneur ;
      * @param[in] comp - un comparateur binaire représentant la relation d'ordre
      *   total régissant les éléments des conteneurs àfusionner ;
-     * @param[in,out] j - le rang du candidat potentiel dans le premier
+     * @param[out] j - le rang du candidat potentiel dans le premier
      *   conteneur ;
-     * @param[in,out] k - le rang du candidat potentiel dans le second
+     * @param[out] k - le rang du candidat potentiel dans le second
      *   sous-conteneur.
      *
+     * @note j est le plus petit rang de [max(0, i - n), min(i, m)] qui n'est
+     *   pas trop petit, c'est-à-dire tel que a[j] ne doive pas précéder
+     *   b[i-j-1] (b[i-j-1] < a[j] ou bien j = min(i, m)) : ce prédicat étant
+     *   monotone, la paire (j, k = i - j) est unique. Elle est encadrée par
+     *   une recherche exponentielle (galop) à partir de l'estimation
+     *   i * m / (m + n), exacte à quelques éléments près lorsque les
+     *   conteneurs s'entrelacent régulièrement (l'un d'eux fût-il beaucoup
+     *   plus court que l'autre), puis déterminée par une
+     *   recherche dichotomique dont le pas, en arithmétique entière, ne
+     *   dépend d'aucun branchement (choix compilé en déplacement
+     *   conditionnel). Le prédicat n'étant évalué que sur des rangs
+     *   strictement intérieurs à l'intervalle, il ne vérifie aucune borne.
      * @note Les types abstraits autres que InputRandomAccessIterator1,
      *   InputRandomAccessIterator2 et Compare ne sont là que pour simplifier
      *   l'écriture de cette méthode et ne rien préjuger des types concrets
@@ -212,29 +308,135 @@ namespace merging {
 		       const Compare& comp,
 		       InputSize1& j,
 		       InputSize2& k) {
-      j = std::min(i,m);
-      k = i - j;
-      InputSize2 klow = 0;
-      InputSize1 jlow = i < n ? 0 : i - n;
-      bool active = true;
-      while (active) {
-        if (j > 0 and k < n and ! comp(a[j-1], b[k])) {
-          InputSize1 sigma = std::ceil((j - jlow) / 2.);
-          klow = k;
-          j = j - sigma;
-          k = k + sigma;
-        } else if (k > 0 and j < m and comp(a[j], b[k-1])) {
-          InputSize2 sigma = std::ceil((k - klow) / 2.);
-          jlow = j;
-          j = j + sigma;
-          k = k - sigma;
-        } else {
-          active = false;
-        }
+
+      // Intervalle des rangs possibles dans le premier conteneur.
+      const InputSize1 jmin = i < OutputSize(n) ? 0 : InputSize1(i - n);
+      const InputSize1 jmax = i < OutputSize(m) ? InputSize1(i) : m;
+
+      // j est trop petit : a[j] doit précéder b[i-j-1] (a[j] <= b[i-j-1],
+      // stabilité), pour jmin <= j < jmax.
+      const auto petit = [&](const InputSize1& x) -> bool {
+	return ! comp(b[i - x - 1], a[x]);
+      };
+
+      // Galop à partir de l'estimation : encadrement de j dans [lo, hi]. La
+      // borne de l'intervalle vers laquelle part le galop est d'abord
+      // éprouvée, de sorte que des conteneurs disjoints (l'un précédant
+      // l'autre) soient partagés en deux comparaisons. L'estimation, calculée
+      // en entiers élargis, est ramenée dans [jmin, jmax[ : un dépassement
+      // (faute d'entiers de 128 bits) n'affecte que le point de départ.
+      InputSize1 lo = jmin, hi = jmax;
+      if (jmin < jmax) {
+#ifdef __SIZEOF_INT128__
+	typedef unsigned __int128 Large;
+#else
+	typedef std::uintmax_t Large;
+#endif
+	InputSize1 x = jmin + InputSize1(Large(jmax - jmin) * Large(m)
+					 / (Large(m) + Large(n)));
+	if (x >= jmax) {
+	  x = jmax - 1;
+	}
+	InputSize1 pas = 1;
+	if (petit(x)) {
+	  lo = x + 1;
+	  if (lo < jmax) {
+	    if (petit(jmax - 1)) {
+	      lo = jmax;
+	    } else {
+	      hi = jmax - 1;
+	      while (x + pas < hi && petit(x + pas)) {
+		lo = x + pas + 1;
+		pas *= 2;
+	      }
+	      if (x + pas < hi) {
+		hi = x + pas;
+	      }
+	    }
+	  }
+	} else {
+	  hi = x;
+	  if (jmin < x) {
+	    if (! petit(jmin)) {
+	      hi = jmin;
+	    } else {
+	      lo = jmin + 1;
+	      while (x - pas >= lo && ! petit(x - pas)) {
+		hi = x - pas;
+		pas *= 2;
+	      }
+	      if (x - pas >= lo) {
+		lo = x - pas + 1;
+	      }
+	    }
+	  }
+	}
       }
 
+      // Recherche dichotomique sans branchement de j dans [lo, hi].
+      InputSize1 longueur = hi - lo + 1;
+      while (longueur > 1) {
+	const InputSize1 moitie = longueur / 2;
+	lo = petit(lo + moitie - 1) ? lo + moitie : lo;
+	longueur -= moitie;
+      }
+      j = lo;
+      k = i - j;
+
     } // coRank
 
+    /**
+     * Co-rang ramené au début d'un groupe d'éléments égaux : la paire (j, k)
+     * calculée par coRank est diminuée de sorte qu'aucun élément égal à
+     * l'élément de rang i du conteneur cible ne la précède, ni dans le
+     * premier ni dans le second conteneur. Les tranches ainsi délimitées ne
+     * partagent aucun groupe d'éléments égaux, ce qu'exigent les opérations
+     * ensemblistes ou les jointures (au prix d'un équilibre moindre lorsque
+     * les groupes sont de grande taille).
+     *
+     * @param[in] i - le rang de l'élément actuellement traité dans le conteneur
+     *   cible de la fusion ;
+     * @param[in] a - un itérateur repérant l'élément de tête du premier
+     *   conteneur ;
+     * @param[in] m - le nombre d'éléments du premier conteneur ;
+     * @param[in] b - un itérateur repérant l'élément de tête du second
+     *   conteneur ;
+     * @param[in] n - le nombre d'éléments du second conteneur ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les éléments des conteneurs àfusionner ;
+     * @param[out] j - le rang du début du groupe dans le premier conteneur ;
+     * @param[out] k - le rang du début du groupe dans le second conteneur.
+     */
+    template< typename OutputSize,
+	      typename InputRandomAccessIterator1,
+	      typename InputSize1,
+	      typename InputRandomAccessIterator2,
+	      typename InputSize2,
+	      typename Compare >
+    static void coRankGroup(const OutputSize& i,
+			    const InputRandomAccessIterator1& a,
+			    const InputSize1& m,
+			    const InputRandomAccessIterator2& b,
+			    const InputSize2& n,
+			    const Compare& comp,
+			    InputSize1& j,
+			    InputSize2& k) {
+      coRank(i, a, m, b, n, comp, j, k);
+
+      // L'élément de rang i du conteneur cible est le plus petit de a[j] et
+      // b[k] (a[j] à égalité) ; les éléments qui le précèdent lui sont
+      // inférieurs ou égaux.
+      if (j < m && (k == n || ! comp(b[k], a[j]))) {
+	const InputRandomAccessIterator1 v = a + j;
+	j = std::lower_bound(a, v, *v, comp) - a;
+	k = std::lower_bound(b, b + k, *v, comp) - b;
+      } else if (k < n) {
+	const InputRandomAccessIterator2 v = b + k;
+	j = std::lower_bound(a, a + j, *v, comp) - a;
+	k = std::lower_bound(b, v, *v, comp) - b;
+      }
+    } // coRankGroup
+
   }; // ParallelStableMerge
 
 } // merging
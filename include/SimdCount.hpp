@@ -0,0 +1,236 @@
+#ifndef SimdCount_hpp
+#define SimdCount_hpp
+
+#include <iterator>
+#include <type_traits>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace paralgos {
+
+  /**
+   * Catégorie d'itérateurs repérant des éléments de type arithmétique stockés
+   * de manière contiguë en mémoire (pointeurs, itérateurs de std::vector,
+   * de std::array, ...). Ces itérateurs autorisent un traitement SIMD.
+   */
+  struct contiguous_arithmetic_iterator_tag
+    : public std::random_access_iterator_tag {};
+
+  /**
+   * @class SimdCount SimdCount.hpp
+   *
+   * Noyaux vectoriels (SSE2, AVX2 et AVX-512) de l'algorithme count de la
+   * bibliothèque standard pour des tableaux d'entiers ou de flottants. Le jeu
+   * d'instructions utilisé est déterminé à l'exécution via l'instruction
+   * cpuid.
+   */
+  class SimdCount {
+  public:
+
+    /**
+     * Les jeux d'instructions supportés, du moins au plus performant.
+     */
+    enum Isa { SCALAR, SSE2, AVX2, AVX512 };
+
+    /**
+     * Détermine, via l'instruction cpuid, le jeu d'instructions le plus
+     * performant supporté par le processeur et le système d'exploitation.
+     *
+     * @return le jeu d'instructions le plus performant disponible.
+     */
+    static Isa detect();
+
+    /**
+     * @return le jeu d'instructions actuellement utilisé par les noyaux.
+     */
+    static Isa isa();
+
+    /**
+     * Impose le jeu d'instructions utilisé par les noyaux (utile pour les
+     * mesures de performances). Le jeu demandé est borné par celui retourné
+     * par @c detect.
+     *
+     * @param[in] isa le jeu d'instructions souhaité.
+     * @return le jeu d'instructions effectivement retenu.
+     * @note Cette méthode ne doit pas être invoquée au sein d'une région
+     *   parallèle.
+     */
+    static Isa setIsa(const Isa& isa);
+
+    /**
+     * @param[in] isa un jeu d'instructions.
+     * @return le nom du jeu d'instructions.
+     */
+    static const char* name(const Isa& isa);
+
+    /**
+     * Compte séquentiellement, via le jeu d'instructions courant, le nombre
+     * d'occurrences d'une valeur dans un tableau.
+     *
+     * @param[in] x le tableau.
+     * @param[in] n le nombre d'éléments du tableau.
+     * @param[in] val la valeur recherchée.
+     * @return le nombre d'occurrences de la valeur recherchée.
+     */
+    template< typename T >
+    static size_t apply(const T x[], const size_t& n, const T& val) {
+
+      // Les entiers sont comparés bit à bit : leur signe est sans importance,
+      // seule leur taille compte. Les flottants doivent en revanche être
+      // comparés en tant que tels (0.0 == -0.0 et NaN != NaN).
+      typedef typename Word< T >::type W;
+      return kernel(reinterpret_cast< const W* >(x),
+                    n,
+                    *reinterpret_cast< const W* >(std::addressof(val)));
+
+    } // apply
+
+    /**
+     * Compte séquentiellement, en une seule passe et via le jeu
+     * d'instructions courant, le nombre d'occurrences de plusieurs valeurs
+     * dans un tableau.
+     *
+     * @param[in] x le tableau.
+     * @param[in] n le nombre d'éléments du tableau.
+     * @param[in] vals les valeurs recherchées.
+     * @param[in] nvals le nombre de valeurs recherchées.
+     * @param[in, out] counts les compteurs d'occurrences, counts[q] étant
+     *   incrémenté du nombre d'occurrences de vals[q].
+     */
+    template< typename T >
+    static void apply(const T x[],
+                      const size_t& n,
+                      const T vals[],
+                      const size_t& nvals,
+                      size_t counts[]) {
+      typedef typename Word< T >::type W;
+      kernel(reinterpret_cast< const W* >(x),
+             n,
+             reinterpret_cast< const W* >(vals),
+             nvals,
+             counts);
+    } // apply
+
+    /**
+     * Indique si un itérateur repère des éléments contigus en mémoire.
+     */
+    template< typename Iterator >
+    struct IsContiguous : public std::false_type {};
+
+    /**
+     * Détermine la catégorie d'un itérateur pour la recherche d'une valeur de
+     * type @c T : @c contiguous_arithmetic_iterator_tag si un noyau vectoriel
+     * est applicable, la catégorie de la bibliothèque standard sinon.
+     */
+    template< typename Iterator, typename T >
+    struct Category {
+
+      // Type des éléments repérés par l'itérateur.
+      typedef typename std::iterator_traits< Iterator >::value_type value_type;
+
+      // Les noyaux vectoriels ne comparent que des éléments de même type que
+      // la valeur recherchée : toute conversion implicite est ainsi exclue.
+      enum : bool {
+        value = IsContiguous< Iterator >::value
+          && std::is_arithmetic< value_type >::value
+          && ! std::is_same< value_type, long double >::value
+          && std::is_same< value_type,
+                           typename std::decay< T >::type >::value
+      };
+
+      typedef typename std::conditional<
+        value,
+        contiguous_arithmetic_iterator_tag,
+        typename std::iterator_traits< Iterator >::iterator_category
+        >::type type;
+
+    }; // Category
+
+  private:
+
+    /**
+     * Type machine utilisé pour comparer des éléments de type @c T.
+     */
+    template< typename T, bool integral = std::is_integral< T >::value >
+    struct Word;
+
+    /**
+     * Noyaux vectoriels, un par taille d'entiers et par type de flottants.
+     *
+     * @param[in] x le tableau.
+     * @param[in] n le nombre d'éléments du tableau.
+     * @param[in] val la valeur recherchée.
+     * @return le nombre d'occurrences de la valeur recherchée.
+     */
+    static size_t kernel(const uint8_t x[], const size_t& n, const uint8_t& val);
+    static size_t kernel(const uint16_t x[], const size_t& n, const uint16_t& val);
+    static size_t kernel(const uint32_t x[], const size_t& n, const uint32_t& val);
+    static size_t kernel(const uint64_t x[], const size_t& n, const uint64_t& val);
+    static size_t kernel(const float x[], const size_t& n, const float& val);
+    static size_t kernel(const double x[], const size_t& n, const double& val);
+
+    /**
+     * Noyaux vectoriels multi-valeurs, un par taille d'entiers et par type de
+     * flottants.
+     *
+     * @param[in] x le tableau.
+     * @param[in] n le nombre d'éléments du tableau.
+     * @param[in] vals les valeurs recherchées.
+     * @param[in] nvals le nombre de valeurs recherchées.
+     * @param[in, out] counts les compteurs d'occurrences.
+     */
+    static void kernel(const uint8_t x[], const size_t& n,
+                       const uint8_t vals[], const size_t& nvals,
+                       size_t counts[]);
+    static void kernel(const uint16_t x[], const size_t& n,
+                       const uint16_t vals[], const size_t& nvals,
+                       size_t counts[]);
+    static void kernel(const uint32_t x[], const size_t& n,
+                       const uint32_t vals[], const size_t& nvals,
+                       size_t counts[]);
+    static void kernel(const uint64_t x[], const size_t& n,
+                       const uint64_t vals[], const size_t& nvals,
+                       size_t counts[]);
+    static void kernel(const float x[], const size_t& n,
+                       const float vals[], const size_t& nvals,
+                       size_t counts[]);
+    static void kernel(const double x[], const size_t& n,
+                       const double vals[], const size_t& nvals,
+                       size_t counts[]);
+
+    /** Le jeu d'instructions actuellement utilisé. */
+    static Isa active;
+
+  }; // SimdCount
+
+  // Les pointeurs repèrent des éléments contigus.
+  template< typename T >
+  struct SimdCount::IsContiguous< T* > : public std::true_type {};
+
+#ifdef __GLIBCXX__
+  // Tout comme les itérateurs de std::vector et de std::string.
+  template< typename Pointer, typename Container >
+  struct SimdCount::IsContiguous< __gnu_cxx::__normal_iterator< Pointer,
+                                                                Container > >
+    : public SimdCount::IsContiguous< Pointer > {};
+#endif
+
+  // Entiers : seule la taille importe.
+  template< typename T >
+  struct SimdCount::Word< T, true > {
+    typedef typename std::conditional<
+      sizeof(T) == 1, uint8_t, typename std::conditional<
+        sizeof(T) == 2, uint16_t, typename std::conditional<
+          sizeof(T) == 4, uint32_t, uint64_t >::type >::type >::type type;
+  };
+
+  // Flottants : ils sont comparés en tant que tels.
+  template< typename T >
+  struct SimdCount::Word< T, false > {
+    typedef T type;
+  };
+
+} // paralgos
+
+#endif
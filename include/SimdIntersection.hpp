@@ -0,0 +1,383 @@
+#ifndef SimdIntersection_hpp
+#define SimdIntersection_hpp
+
+#include "SimdCount.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+namespace merging {
+
+  /**
+   * @class SimdIntersection SimdIntersection.hpp
+   *
+   * Noyau vectoriel (AVX2) de l'algorithme set_intersection de la
+   * bibliothèque standard pour des tableaux d'entiers de 32 bits ordonnés par
+   * ordre croissant. Tant que les éléments de tête des deux suites diffèrent,
+   * les éléments de la suite dont la tête est la plus petite qui sont
+   * inférieurs à la tête de l'autre sont sautés huit par huit : une
+   * comparaison vectorielle, suivie du décompte des voies inférieures,
+   * remplace huit comparaisons et autant de branchements imprévisibles.
+   *
+   * @note Les éléments égaux sont appariés un à un, exactement comme par
+   *   l'algorithme set_intersection : le noyau convient donc aux
+   *   multi-ensembles et pas seulement aux suites strictement croissantes.
+   * @note Le gain est d'autant plus grand que l'intersection est peu dense
+   *   (les sauts étant alors longs) ; lorsque la plupart des éléments sont
+   *   communs, les sauts ne dépassent guère un élément et le noyau est un
+   *   peu plus lent que l'algorithme set_intersection.
+   * @note Le jeu d'instructions utilisé suit celui imposé à
+   *   paralgos::SimdCount ; à défaut d'AVX2, l'intersection est calculée via
+   *   l'algorithme set_intersection de la bibliothèque standard.
+   */
+  class SimdIntersection {
+  private:
+
+    /**
+     * Détermine si un comparateur est std::less pour des éléments de type
+     * @c T.
+     */
+    template< typename Compare, typename T >
+    struct IsLess : public std::false_type {};
+
+    template< typename U, typename T >
+    struct IsLess< std::less< U >, T >
+      : public std::is_same< typename std::decay< U >::type, T > {};
+
+  public:
+
+    /**
+     * Calcule séquentiellement, via le jeu d'instructions courant,
+     * l'intersection de deux tableaux ordonnés par ordre croissant.
+     *
+     * @param[in] a - le premier tableau ;
+     * @param[in] m - le nombre d'éléments du premier tableau ;
+     * @param[in] b - le second tableau ;
+     * @param[in] n - le nombre d'éléments du second tableau ;
+     * @param[out] result - le tableau accueillant l'intersection (min(m, n)
+     *   éléments au plus).
+     * @return un pointeur repérant la fin de l'intersection.
+     */
+    template< typename T >
+    static T* apply(const T a[],
+		    const size_t& m,
+		    const T b[],
+		    const size_t& n,
+		    T result[]) {
+
+      // Les entiers ne sont distingués que par leur signe.
+      typedef typename Word< T >::type W;
+      return result + kernel(reinterpret_cast< const W* >(a),
+			     m,
+			     reinterpret_cast< const W* >(b),
+			     n,
+			     reinterpret_cast< W* >(result));
+
+    } // apply
+
+    /**
+     * Dénombre séquentiellement, via le jeu d'instructions courant, les
+     * éléments de l'intersection de deux tableaux ordonnés par ordre
+     * croissant.
+     *
+     * @param[in] a - le premier tableau ;
+     * @param[in] m - le nombre d'éléments du premier tableau ;
+     * @param[in] b - le second tableau ;
+     * @param[in] n - le nombre d'éléments du second tableau.
+     * @return le nombre d'éléments de l'intersection.
+     */
+    template< typename T >
+    static size_t count(const T a[],
+			const size_t& m,
+			const T b[],
+			const size_t& n) {
+      typedef typename Word< T >::type W;
+      return kernel(reinterpret_cast< const W* >(a),
+		    m,
+		    reinterpret_cast< const W* >(b),
+		    n,
+		    static_cast< W* >(nullptr));
+    } // count
+
+    /**
+     * Détermine si une intersection peut être confiée au noyau vectoriel :
+     * les deux itérateurs doivent repérer des éléments contigus du même
+     * type, entier de 32 bits, et le comparateur doit être std::less.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename Compare >
+    struct Category {
+
+      // Type des éléments repérés par le premier itérateur.
+      typedef typename std::iterator_traits< InputRandomAccessIterator1 >::
+	value_type value_type;
+
+      enum : bool {
+	value = paralgos::SimdCount::IsContiguous<
+	  InputRandomAccessIterator1 >::value
+	  && paralgos::SimdCount::IsContiguous<
+	    InputRandomAccessIterator2 >::value
+	  && std::is_same< value_type, typename std::iterator_traits<
+			     InputRandomAccessIterator2 >::value_type >::value
+	  && std::is_integral< value_type >::value
+	  && sizeof(value_type) == 4
+	  && IsLess< Compare, value_type >::value
+      };
+
+      typedef std::integral_constant< bool, value > type;
+
+    }; // Category
+
+    /**
+     * Feuille des intersections par tranches : l'intersection est confiée
+     * au noyau vectoriel si les types le permettent (cf. Category, le
+     * conteneur cible devant lui aussi repérer des éléments contigus du même
+     * type), à l'algorithme set_intersection de la bibliothèque standard
+     * sinon.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément de l'intersection ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return un itérateur repérant la fin de l'intersection dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    intersect(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare& comp) {
+      typedef Category< InputRandomAccessIterator1,
+			InputRandomAccessIterator2,
+			Compare > Entree;
+      typedef std::integral_constant<
+	bool,
+	Entree::value
+	&& paralgos::SimdCount::IsContiguous<
+	  OutputRandomAccessIterator >::value
+	&& std::is_same< typename Entree::value_type,
+			 typename std::iterator_traits<
+			   OutputRandomAccessIterator >::value_type >::value
+	> Vectorisable;
+      return intersect(first1, last1, first2, last2, result, comp,
+		       Vectorisable());
+    } // intersect
+
+    /**
+     * Feuille des dénombrements par tranches : le dénombrement est confié au
+     * noyau vectoriel si les types le permettent (cf. Category), à
+     * l'algorithme set_intersection de la bibliothèque standard muni d'un
+     * itérateur de sortie se contentant de compter sinon.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return le nombre d'éléments de l'intersection.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename Compare >
+    static size_t count(const InputRandomAccessIterator1& first1,
+			const InputRandomAccessIterator1& last1,
+			const InputRandomAccessIterator2& first2,
+			const InputRandomAccessIterator2& last2,
+			const Compare& comp) {
+      typedef typename Category< InputRandomAccessIterator1,
+				 InputRandomAccessIterator2,
+				 Compare >::type Vectorisable;
+      return count(first1, last1, first2, last2, comp, Vectorisable());
+    } // count
+
+  private:
+
+    /**
+     * Itérateur de sortie se contentant de compter les éléments qui lui
+     * sont affectés.
+     */
+    class Compteur {
+    public:
+
+      typedef std::output_iterator_tag iterator_category;
+      typedef void value_type;
+      typedef void difference_type;
+      typedef void pointer;
+      typedef void reference;
+
+      Compteur()
+	: n_(0) {
+      }
+
+      Compteur& operator*() {
+	return *this;
+      }
+
+      template< typename T >
+      Compteur& operator=(const T&) {
+	return *this;
+      }
+
+      Compteur& operator++() {
+	n_ ++;
+	return *this;
+      }
+
+      Compteur operator++(int) {
+	Compteur tmp(*this);
+	n_ ++;
+	return tmp;
+      }
+
+      /** @return le nombre d'éléments affectés. */
+      const size_t& value() const {
+	return n_;
+      }
+
+    private:
+
+      /** Le nombre d'éléments affectés. */
+      size_t n_;
+
+    }; // Compteur
+
+    /**
+     * Type machine utilisé pour comparer des éléments de type @c T.
+     */
+    template< typename T >
+    struct Word {
+      typedef typename std::conditional< std::is_signed< T >::value,
+					 int32_t, uint32_t >::type type;
+    };
+
+    /**
+     * Adresse de l'élément repéré par un itérateur d'éléments contigus.
+     */
+    template< typename T >
+    static T* pointer(T* const& it) {
+      return it;
+    }
+
+#ifdef __GLIBCXX__
+    template< typename Pointer, typename Container >
+    static Pointer
+    pointer(const __gnu_cxx::__normal_iterator< Pointer, Container >& it) {
+      return it.base();
+    }
+#endif
+
+    /**
+     * Feuille vectorielle.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    intersect(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare&,
+	      std::true_type) {
+      return result + (apply(pointer(first1), last1 - first1,
+			     pointer(first2), last2 - first2,
+			     pointer(result))
+		       - pointer(result));
+    } // intersect
+
+    /**
+     * Feuille scalaire.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    intersect(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare& comp,
+	      std::false_type) {
+      return std::set_intersection(first1, last1, first2, last2, result, comp);
+    } // intersect
+
+    /**
+     * Dénombrement vectoriel.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename Compare >
+    static size_t count(const InputRandomAccessIterator1& first1,
+			const InputRandomAccessIterator1& last1,
+			const InputRandomAccessIterator2& first2,
+			const InputRandomAccessIterator2& last2,
+			const Compare&,
+			std::true_type) {
+      return count(pointer(first1), last1 - first1,
+		   pointer(first2), last2 - first2);
+    } // count
+
+    /**
+     * Dénombrement scalaire.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename Compare >
+    static size_t count(const InputRandomAccessIterator1& first1,
+			const InputRandomAccessIterator1& last1,
+			const InputRandomAccessIterator2& first2,
+			const InputRandomAccessIterator2& last2,
+			const Compare& comp,
+			std::false_type) {
+      return std::set_intersection(first1, last1, first2, last2,
+				   Compteur(), comp).value();
+    } // count
+
+    /**
+     * Noyaux vectoriels, un par signe d'entiers.
+     *
+     * @param[in] a - le premier tableau ;
+     * @param[in] m - le nombre d'éléments du premier tableau ;
+     * @param[in] b - le second tableau ;
+     * @param[in] n - le nombre d'éléments du second tableau ;
+     * @param[out] result - le tableau accueillant l'intersection, ou
+     *   @c nullptr pour se contenter de la dénombrer.
+     * @return le nombre d'éléments de l'intersection.
+     */
+    static size_t kernel(const int32_t a[], const size_t& m,
+			 const int32_t b[], const size_t& n, int32_t result[]);
+    static size_t kernel(const uint32_t a[], const size_t& m,
+			 const uint32_t b[], const size_t& n, uint32_t result[]);
+
+  }; // SimdIntersection
+
+} // merging
+
+#endif
@@ -0,0 +1,611 @@
+#ifndef Sketch_hpp
+#define Sketch_hpp
+
+#include "ExecutionContext.hpp"
+#include <omp.h>
+#include <iterator>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace paralgos {
+
+  /**
+   * Fonction de hachage des éléments d'un sketch : le haché de la
+   * bibliothèque standard (l'identité pour les entiers) est mélangé par le
+   * finaliseur de SplitMix64 afin que tous ses bits soient exploitables.
+   */
+  template< typename T >
+  struct SketchHash {
+
+    /**
+     * @param[in] x l'élément à hacher.
+     * @return le haché de l'élément sur 64 bits.
+     */
+    uint64_t operator()(const T& x) const {
+      uint64_t h = uint64_t(std::hash< T >()(x)) + 0x9E3779B97F4A7C15ULL;
+      h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+      return h ^ (h >> 31);
+    }
+
+  }; // SketchHash
+
+  /**
+   * @class CountMinSketch Sketch.hpp
+   *
+   * Sketch Count-Min : estimation de la fréquence des éléments d'un flux en
+   * mémoire constante. L'estimation n'est jamais inférieure à la fréquence
+   * exacte et ne la dépasse de plus de epsilon * N (N étant le nombre
+   * d'éléments comptés) qu'avec une probabilité d'au plus delta.
+   */
+  template< typename T >
+  class CountMinSketch {
+  public:
+
+    // Déclaration d'amitié envers la classe chargée de la construction en
+    // parallèle : seule cette dernière peut fusionner une partie des
+    // compteurs.
+    friend class Sketch;
+
+    /**
+     * Constructeur : e / epsilon compteurs par ligne et ln(1 / delta) lignes.
+     *
+     * @param[in] epsilon l'erreur additive relative au nombre d'éléments.
+     * @param[in] delta la probabilité de dépasser cette erreur.
+     */
+    CountMinSketch(const double& epsilon, const double& delta)
+      : epsilon_(epsilon),
+        delta_(delta),
+        width_(0),
+        depth_(0),
+        total_(0) {
+      if (! (epsilon > 0 && epsilon < 1 && delta > 0 && delta < 1)) {
+        throw std::invalid_argument("CountMinSketch : epsilon et delta "
+                                    "doivent appartenir à ]0, 1[");
+      }
+      width_ = size_t(std::ceil(std::exp(1.0) / epsilon));
+      depth_ = std::max(1, int(std::ceil(std::log(1.0 / delta))));
+      counts_.resize(width_ * depth_);
+    }
+
+    /**
+     * Compte une ou plusieurs occurrences d'un élément.
+     *
+     * @param[in] x l'élément.
+     * @param[in] c le nombre d'occurrences.
+     */
+    void add(const T& x, const size_t& c = 1) {
+      const uint64_t h = hash_(x);
+      for (size_t d = 0; d != depth_; d ++) {
+        counts_[d * width_ + column(h, d)] += c;
+      }
+      total_ += c;
+    }
+
+    /**
+     * @param[in] x un élément.
+     * @return l'estimation du nombre d'occurrences de l'élément.
+     */
+    size_t estimate(const T& x) const {
+      const uint64_t h = hash_(x);
+      size_t acc = counts_[column(h, 0)];
+      for (size_t d = 1; d != depth_; d ++) {
+        acc = std::min(acc, counts_[d * width_ + column(h, d)]);
+      }
+      return acc;
+    }
+
+    /**
+     * Ajoute à ce sketch les compteurs d'un autre sketch de mêmes
+     * paramètres.
+     *
+     * @param[in] other l'autre sketch.
+     */
+    void merge(const CountMinSketch& other) {
+      if (width_ != other.width_ || depth_ != other.depth_) {
+        throw std::invalid_argument("CountMinSketch : dimensions différentes");
+      }
+      merge(other, 0, cells());
+      total_ += other.total_;
+    }
+
+    /** @return l'erreur additive relative au nombre d'éléments. */
+    const double& epsilon() const { return epsilon_; }
+
+    /** @return la probabilité de dépasser l'erreur additive. */
+    const double& delta() const { return delta_; }
+
+    /** @return le nombre de compteurs par ligne. */
+    const size_t& width() const { return width_; }
+
+    /** @return le nombre de lignes. */
+    const size_t& depth() const { return depth_; }
+
+    /** @return le nombre d'éléments comptés. */
+    const size_t& total() const { return total_; }
+
+  private:
+
+    /**
+     * Calcule la colonne d'un élément dans une ligne. Les fonctions de
+     * hachage des lignes sont dérivées d'un unique haché (h1 + d * h2,
+     * d'après Kirsch et Mitzenmacher), ramené à la largeur par une
+     * multiplication plutôt que par une division.
+     *
+     * @param[in] h le haché de l'élément.
+     * @param[in] d la ligne.
+     * @return la colonne de l'élément.
+     */
+    size_t column(const uint64_t& h, const size_t& d) const {
+      const uint32_t hd = uint32_t(h) + uint32_t(d) * uint32_t((h >> 32) | 1);
+      return (uint64_t(hd) * width_) >> 32;
+    }
+
+    /**
+     * @return le nombre total de compteurs.
+     */
+    size_t cells() const {
+      return counts_.size();
+    }
+
+    /**
+     * Ajoute à ce sketch une partie des compteurs d'un autre sketch.
+     *
+     * @param[in] other l'autre sketch.
+     * @param[in] lo l'indice du premier compteur concerné.
+     * @param[in] hi l'indice du compteur situé juste derrière le dernier
+     *   compteur concerné.
+     */
+    void merge(const CountMinSketch& other,
+               const size_t& lo,
+               const size_t& hi) {
+      for (size_t i = lo; i != hi; i ++) {
+        counts_[i] += other.counts_[i];
+      }
+    }
+
+    /** L'erreur additive relative au nombre d'éléments. */
+    double epsilon_;
+
+    /** La probabilité de dépasser l'erreur additive. */
+    double delta_;
+
+    /** Le nombre de compteurs par ligne. */
+    size_t width_;
+
+    /** Le nombre de lignes. */
+    size_t depth_;
+
+    /** Le nombre d'éléments comptés. */
+    size_t total_;
+
+    /** Les compteurs, ligne par ligne. */
+    std::vector< size_t > counts_;
+
+    /** La fonction de hachage. */
+    SketchHash< T > hash_;
+
+  }; // CountMinSketch
+
+  /**
+   * @class HyperLogLog Sketch.hpp
+   *
+   * Sketch HyperLogLog : estimation du nombre d'éléments distincts d'un flux
+   * en mémoire constante (2^p registres d'un octet). L'erreur relative
+   * type de l'estimation vaut 1.04 / sqrt(2^p).
+   */
+  template< typename T >
+  class HyperLogLog {
+  public:
+
+    // Déclaration d'amitié envers la classe chargée de la construction en
+    // parallèle : seule cette dernière peut fusionner une partie des
+    // registres.
+    friend class Sketch;
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] precision le nombre p de bits du haché désignant le
+     *   registre, compris entre 4 et 18.
+     */
+    explicit HyperLogLog(const int& precision)
+      : precision_(precision) {
+      if (precision < 4 || precision > 18) {
+        throw std::invalid_argument("HyperLogLog : précision hors de [4, 18]");
+      }
+      registers_.resize(size_t(1) << precision);
+    }
+
+    /**
+     * Compte un élément : le registre désigné par les p premiers bits du
+     * haché retient la position du premier bit à 1 des bits suivants.
+     *
+     * @param[in] x l'élément.
+     */
+    void add(const T& x) {
+      const uint64_t h = hash_(x);
+      const uint64_t w = h << precision_;
+      const uint8_t rank = w == 0 ? 64 - precision_ + 1
+                                  : __builtin_clzll(w) + 1;
+      uint8_t& reg = registers_[h >> (64 - precision_)];
+      reg = std::max(reg, rank);
+    }
+
+    /**
+     * @return l'estimation du nombre d'éléments distincts. Les petites
+     *   cardinalités, pour lesquelles des registres restent nuls, sont
+     *   estimées par comptage linéaire.
+     */
+    double estimate() const {
+      const double m = registers_.size();
+      double sum = 0;
+      size_t zeros = 0;
+      for (size_t i = 0; i != registers_.size(); i ++) {
+        sum += std::ldexp(1.0, - registers_[i]);
+        zeros += registers_[i] == 0;
+      }
+      const double e = alpha() * m * m / sum;
+      if (e <= 2.5 * m && zeros != 0) {
+        return m * std::log(m / zeros);
+      }
+      return e;
+    }
+
+    /**
+     * Réunit à ce sketch un autre sketch de même précision.
+     *
+     * @param[in] other l'autre sketch.
+     */
+    void merge(const HyperLogLog& other) {
+      if (precision_ != other.precision_) {
+        throw std::invalid_argument("HyperLogLog : précisions différentes");
+      }
+      merge(other, 0, cells());
+    }
+
+    /** @return le nombre de bits du haché désignant le registre. */
+    const int& precision() const { return precision_; }
+
+    /** @return l'erreur relative type de l'estimation. */
+    double error() const { return 1.04 / std::sqrt(double(cells())); }
+
+  private:
+
+    /**
+     * @return le nombre de registres.
+     */
+    size_t cells() const {
+      return registers_.size();
+    }
+
+    /**
+     * Réunit à ce sketch une partie des registres d'un autre sketch.
+     *
+     * @param[in] other l'autre sketch.
+     * @param[in] lo l'indice du premier registre concerné.
+     * @param[in] hi l'indice du registre situé juste derrière le dernier
+     *   registre concerné.
+     */
+    void merge(const HyperLogLog& other,
+               const size_t& lo,
+               const size_t& hi) {
+      for (size_t i = lo; i != hi; i ++) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+      }
+    }
+
+    /**
+     * @return la constante de correction du biais de l'estimation.
+     */
+    double alpha() const {
+      switch (precision_) {
+      case 4:
+        return 0.673;
+      case 5:
+        return 0.697;
+      case 6:
+        return 0.709;
+      default:
+        return 0.7213 / (1 + 1.079 / cells());
+      }
+    }
+
+    /** Le nombre de bits du haché désignant le registre. */
+    int precision_;
+
+    /** Les registres. */
+    std::vector< uint8_t > registers_;
+
+    /** La fonction de hachage. */
+    SketchHash< T > hash_;
+
+  }; // HyperLogLog
+
+  /**
+   * @class Sketch Sketch.hpp
+   *
+   * Construction en parallèle des sketchs : chaque thread remplit son propre
+   * sketch (privatisation), puis les sketchs sont fusionnés en parallèle,
+   * chaque thread fusionnant un bloc de compteurs ou de registres.
+   */
+  class Sketch {
+  public:
+
+    /**
+     * Construit un sketch Count-Min au sein du contexte par défaut.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] epsilon l'erreur additive relative au nombre d'éléments.
+     * @param[in] delta la probabilité de dépasser cette erreur.
+     * @return le sketch.
+     */
+    template< typename InputIterator >
+    static CountMinSketch<
+      typename std::iterator_traits< InputIterator >::value_type >
+    countMin(const InputIterator& first,
+             const InputIterator& last,
+             const double& epsilon,
+             const double& delta) {
+      return countMin(first, last, epsilon, delta,
+                      ExecutionContext::standard());
+    } // countMin
+
+    /**
+     * Construit un sketch Count-Min.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] epsilon l'erreur additive relative au nombre d'éléments.
+     * @param[in] delta la probabilité de dépasser cette erreur.
+     * @param[in] context le contexte d'exécution.
+     * @return le sketch.
+     */
+    template< typename InputIterator >
+    static CountMinSketch<
+      typename std::iterator_traits< InputIterator >::value_type >
+    countMin(const InputIterator& first,
+             const InputIterator& last,
+             const double& epsilon,
+             const double& delta,
+             const ExecutionContext& context) {
+      typedef typename std::iterator_traits< InputIterator >::value_type T;
+      return build(first, last,
+                   CountMinSketch< T >(epsilon, delta),
+                   context);
+    } // countMin
+
+    /**
+     * Construit un sketch HyperLogLog au sein du contexte par défaut.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] precision le nombre de bits du haché désignant le registre.
+     * @return le sketch.
+     */
+    template< typename InputIterator >
+    static HyperLogLog<
+      typename std::iterator_traits< InputIterator >::value_type >
+    hyperLogLog(const InputIterator& first,
+                const InputIterator& last,
+                const int& precision) {
+      return hyperLogLog(first, last, precision,
+                         ExecutionContext::standard());
+    } // hyperLogLog
+
+    /**
+     * Construit un sketch HyperLogLog.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] precision le nombre de bits du haché désignant le registre.
+     * @param[in] context le contexte d'exécution.
+     * @return le sketch.
+     */
+    template< typename InputIterator >
+    static HyperLogLog<
+      typename std::iterator_traits< InputIterator >::value_type >
+    hyperLogLog(const InputIterator& first,
+                const InputIterator& last,
+                const int& precision,
+                const ExecutionContext& context) {
+      typedef typename std::iterator_traits< InputIterator >::value_type T;
+      return build(first, last, HyperLogLog< T >(precision), context);
+    } // hyperLogLog
+
+  private:
+
+    /**
+     * Remplit un sketch vide en parallèle.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in] empty le sketch vide, copié pour chaque thread.
+     * @param[in] context le contexte d'exécution.
+     * @return le sketch rempli.
+     */
+    template< typename InputIterator, typename S >
+    static S build(const InputIterator& first,
+                   const InputIterator& last,
+                   const S& empty,
+                   const ExecutionContext& context) {
+
+      // Instanciation de l'implémentation adéquate.
+      typedef typename std::iterator_traits< InputIterator >::
+        iterator_category Category;
+      typedef Impl< Category > Impl;
+
+      // Remplissage des sketchs privés de chaque thread.
+      const int threads = Impl::threads(first, last, context);
+      std::vector< S > sketches(threads, empty);
+      Impl::apply(first, last, sketches);
+
+      // Fusion.
+      merge(sketches);
+      return std::move(sketches[0]);
+
+    } // build
+
+    /**
+     * Fusion en parallèle des sketchs privés de chaque thread dans le premier
+     * d'entre eux : chaque thread fusionne un bloc de compteurs.
+     *
+     * @param[in, out] sketches les sketchs privés de chaque thread.
+     */
+    template< typename S >
+    static void merge(std::vector< S >& sketches) {
+      const int threads = sketches.size();
+      const size_t n = sketches[0].cells();
+#pragma omp parallel for schedule(static, 1) num_threads(threads)
+      for (int r = 0; r < threads; r ++) {
+        const size_t ir = n * r / threads;
+        const size_t ir1 = n * (r + 1) / threads;
+        for (int t = 1; t < threads; t ++) {
+          sketches[0].merge(sketches[t], ir, ir1);
+        }
+      }
+      total(sketches, sketches[0]);
+    } // merge
+
+    /**
+     * Met à jour le nombre d'éléments comptés par un sketch Count-Min
+     * fusionné.
+     */
+    template< typename T >
+    static void total(const std::vector< CountMinSketch< T > >& sketches,
+                      CountMinSketch< T >& result) {
+      for (size_t t = 1; t < sketches.size(); t ++) {
+        result.total_ += sketches[t].total_;
+      }
+    } // total
+
+    /**
+     * Un sketch HyperLogLog ne tient pas le compte de ses éléments.
+     */
+    template< typename T >
+    static void total(const std::vector< HyperLogLog< T > >&,
+                      HyperLogLog< T >&) {
+    } // total
+
+  public:
+
+    /**
+     * Implémentation du remplissage des sketchs dédiée aux InputIterator :
+     * un thread parcourt le conteneur et crée une tâche par tronçon de 128
+     * éléments par thread, chaque tâche remplissant le sketch du thread qui
+     * l'exécute.
+     */
+    template< typename Category >
+    class Impl {
+    public:
+
+      // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+      // invoquer les méthodes de classe privées.
+      friend class Sketch;
+
+    private:
+
+      /**
+       * @return le nombre de threads de l'équipe (le nombre d'éléments ne
+       *   pouvant être calculé sans un coût prohibitif).
+       */
+      template< typename InputIterator >
+      static int threads(const InputIterator&,
+                         const InputIterator&,
+                         const ExecutionContext& context) {
+        return context.threads();
+      } // threads
+
+      /**
+       * Remplissage des sketchs.
+       *
+       * @param[in] first un itérateur repérant le premier élément à traiter.
+       * @param[in] last un itérateur repérant l'élément situé juste derrière
+       *   le dernier élément à traiter.
+       * @param[in, out] sketches les sketchs privés de chaque thread.
+       */
+      template< typename InputIterator, typename S >
+      static void apply(const InputIterator& first,
+                        const InputIterator& last,
+                        std::vector< S >& sketches) {
+        ExecutionContext::forEachChunk(first, last, int(sketches.size()),
+                                       [&](const InputIterator& debut,
+                                           const InputIterator& fin) {
+          S& local = sketches[omp_get_thread_num()];
+          for (InputIterator it = debut; it != fin; ++ it) {
+            local.add(*it);
+          }
+        });
+      } // apply
+
+    }; // Impl< not RandomAccessIterator >
+
+  }; // Sketch
+
+  /**
+   * Implémentation du remplissage des sketchs dédiée aux
+   * RandomAccessIterator : chaque thread traite un bloc contigu d'éléments.
+   */
+  template<>
+  class Sketch::Impl< std::random_access_iterator_tag > {
+  public:
+
+    // Déclaration d'amitié envers la classe mère : seule cette dernière peut
+    // invoquer les méthodes de classe privées.
+    friend class Sketch;
+
+  private:
+
+    /**
+     * @return 1 si le nombre d'éléments est inférieur au seuil du contexte,
+     *   le nombre de threads de l'équipe sinon.
+     */
+    template< typename RandomAccessIterator >
+    static int threads(const RandomAccessIterator& first,
+                       const RandomAccessIterator& last,
+                       const ExecutionContext& context) {
+      return context.sequential(last - first) ? 1 : context.threads();
+    } // threads
+
+    /**
+     * Remplissage des sketchs.
+     *
+     * @param[in] first un itérateur repérant le premier élément à traiter.
+     * @param[in] last un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément à traiter.
+     * @param[in, out] sketches les sketchs privés de chaque thread.
+     */
+    template< typename RandomAccessIterator, typename S >
+    static void apply(const RandomAccessIterator& first,
+                      const RandomAccessIterator& last,
+                      std::vector< S >& sketches) {
+      typedef typename std::iterator_traits< RandomAccessIterator >::
+        difference_type Size;
+      const int threads = sketches.size();
+      const Size n = last - first;
+#pragma omp parallel for schedule(static, 1) num_threads(threads)
+      for (int r = 0; r < threads; r ++) {
+        const Size ir = n * r / threads;
+        const Size ir1 = n * (r + 1) / threads;
+        S& local = sketches[r];
+        for (Size i = ir; i != ir1; i ++) {
+          local.add(first[i]);
+        }
+      }
+    } // apply
+
+  }; // Impl< RandomAccessIterator >
+
+} // paralgos
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef TBBExecutor_hpp
+#define TBBExecutor_hpp
+
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#include <tbb/parallel_for.h>
+
+namespace merging {
+
+  /**
+   * @class TBBExecutor TBBExecutor.hpp
+   *
+   * Exécuteur confiant le parallélisme des algorithmes de fusion à TBB (Intel
+   * Threading Building Blocks) : les fonctions sont exécutées dans une arène
+   * de taille fixée, par les ouvriers de TBB, sans qu'aucune équipe OpenMP ne
+   * soit créée. Il convient donc aux services déjà bâtis sur TBB.
+   *
+   * @see OpenMPExecutor pour la description des opérations d'un exécuteur.
+   */
+  class TBBExecutor {
+  public:
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] threads - le nombre de threads de l'arène (0 pour le nombre
+     *   de threads par défaut de TBB).
+     */
+    explicit TBBExecutor(const int& threads = 0)
+      : arena_(threads > 0 ? threads : tbb::task_arena::automatic) {
+    }
+
+    /**
+     * @return le nombre de threads de l'arène.
+     */
+    int concurrency() const {
+      return arena_.max_concurrency();
+    }
+
+    /**
+     * Exécute une fonction dans l'arène.
+     *
+     * @param[in] f - la fonction, sans paramètre.
+     */
+    template< typename Function >
+    void run(const Function& f) const {
+      arena_.execute([&f]() { f(); });
+    } // run
+
+    /**
+     * Exécute deux fonctions de manière concurrente via un groupe de
+     * tâches : la première dans une tâche, la seconde par le thread appelant.
+     *
+     * @param[in] f - la première fonction, sans paramètre ;
+     * @param[in] g - la seconde fonction, sans paramètre.
+     */
+    template< typename Function1, typename Function2 >
+    void invoke(const Function1& f, const Function2& g) const {
+      tbb::task_group groupe;
+      groupe.run([&f]() { f(); });
+      g();
+      groupe.wait();
+    } // invoke
+
+    /**
+     * Exécute f(i) pour i dans [first, last[ de manière concurrente.
+     *
+     * @param[in] first - le premier indice ;
+     * @param[in] last - l'indice situé juste derrière le dernier indice ;
+     * @param[in] f - la fonction, paramétrée par un indice.
+     */
+    template< typename Function >
+    void parallelFor(const int& first,
+		     const int& last,
+		     const Function& f) const {
+      tbb::parallel_for(first, last, [&f](const int& i) { f(i); });
+    } // parallelFor
+
+  private:
+
+    /** L'arène dans laquelle sont exécutées les tâches. */
+    mutable tbb::task_arena arena_;
+
+  }; // TBBExecutor
+
+} // merging
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef ThreadPoolExecutor_hpp
+#define ThreadPoolExecutor_hpp
+
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <utility>
+
+namespace merging {
+
+  /**
+   * @class ThreadPoolExecutor ThreadPoolExecutor.hpp
+   *
+   * Exécuteur confiant le parallélisme des algorithmes de fusion à une
+   * réserve de std::thread à vol de tâches, sans dépendre d'OpenMP ni de
+   * TBB. Chaque ouvrier dispose d'une file de tâches : il empile et dépile
+   * ses propres tâches à l'arrière de sa file, les ouvriers inoccupés volant
+   * à l'avant des files des autres. Un thread extérieur à la réserve dépose
+   * ses tâches dans une file supplémentaire et s'endort jusqu'à leur terme.
+   *
+   * @note Un ouvrier attendant la fin d'une tâche volée exécute des tâches
+   *   volées à son tour au lieu de s'endormir.
+   * @note Les fonctions exécutées ne doivent pas lever d'exception.
+   * @see OpenMPExecutor pour la description des opérations d'un exécuteur.
+   */
+  class ThreadPoolExecutor {
+  public:
+
+    /**
+     * Constructeur : démarre les ouvriers.
+     *
+     * @param[in] threads - le nombre d'ouvriers (0 pour le nombre de coeurs).
+     */
+    explicit ThreadPoolExecutor(const int& threads = 0);
+
+    /**
+     * Destructeur : arrête les ouvriers.
+     */
+    ~ThreadPoolExecutor();
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    /**
+     * @return le nombre d'ouvriers.
+     */
+    const int& concurrency() const;
+
+    /**
+     * Exécute une fonction par un ouvrier, jusqu'à son terme.
+     *
+     * @param[in] f - la fonction, sans paramètre.
+     */
+    template< typename Function >
+    void run(const Function& f) const {
+      if (pool_ == this) {
+	f();
+	return;
+      }
+      Tache tache([&f]() { f(); }, true);
+      push(&tache, threads_);
+      std::unique_lock< std::mutex > verrou(mutex_);
+      fin_.wait(verrou, [&tache]() { return tache.terminee.load(); });
+    } // run
+
+    /**
+     * Exécute deux fonctions de manière concurrente : la première est
+     * empilée dans la file de l'ouvrier courant, où elle peut être volée, la
+     * seconde est exécutée par l'ouvrier courant qui reprend ensuite la
+     * première si elle n'a pas été volée.
+     *
+     * @param[in] f - la première fonction, sans paramètre ;
+     * @param[in] g - la seconde fonction, sans paramètre.
+     */
+    template< typename Function1, typename Function2 >
+    void invoke(const Function1& f, const Function2& g) const {
+      if (pool_ != this) {
+	run([this, &f, &g]() { invoke(f, g); });
+	return;
+      }
+      Tache tache([&f]() { f(); }, false);
+      push(&tache, courant_);
+      g();
+      if (reprendre(&tache)) {
+	f();
+      } else {
+	attendre(tache);
+      }
+    } // invoke
+
+    /**
+     * Exécute f(i) pour i dans [first, last[ de manière concurrente, par
+     * dichotomie sur l'intervalle.
+     *
+     * @param[in] first - le premier indice ;
+     * @param[in] last - l'indice situé juste derrière le dernier indice ;
+     * @param[in] f - la fonction, paramétrée par un indice.
+     */
+    template< typename Function >
+    void parallelFor(const int& first,
+		     const int& last,
+		     const Function& f) const {
+      if (last - first <= 1) {
+	if (first < last) {
+	  f(first);
+	}
+	return;
+      }
+      const int middle = first + (last - first) / 2;
+      invoke([this, first, middle, &f]() { parallelFor(first, middle, f); },
+	     [this, middle, last, &f]() { parallelFor(middle, last, f); });
+    } // parallelFor
+
+  private:
+
+    /**
+     * Une tâche : sa fonction et son état. Les tâches sont allouées sur la
+     * pile de celui qui attend leur terme.
+     */
+    struct Tache {
+
+      Tache(std::function< void() > c, const bool& e)
+	: corps(std::move(c)), terminee(false), externe(e) {
+      }
+
+      /** La fonction à exécuter. */
+      std::function< void() > corps;
+
+      /** Indique si la fonction a été exécutée. */
+      std::atomic< bool > terminee;
+
+      /** Indique si la tâche a été déposée par un thread extérieur. */
+      bool externe;
+
+    }; // Tache
+
+    /**
+     * Une file de tâches.
+     */
+    struct File {
+
+      /** Le verrou protégeant la file. */
+      std::mutex verrou;
+
+      /** Les tâches. */
+      std::deque< Tache* > taches;
+
+    }; // File
+
+    /**
+     * Empile une tâche à l'arrière d'une file et réveille un ouvrier.
+     */
+    void push(Tache* tache, const int& file) const;
+
+    /**
+     * Retire une tâche de l'arrière de la file de l'ouvrier courant si elle
+     * s'y trouve encore (i.e. si elle n'a pas été volée).
+     *
+     * @return @c true si la tâche a été retirée.
+     */
+    bool reprendre(Tache* tache) const;
+
+    /**
+     * Dépile une tâche de l'arrière d'une file.
+     *
+     * @return la tâche, ou @c nullptr si la file est vide.
+     */
+    Tache* pop(const int& file) const;
+
+    /**
+     * Vole une tâche à l'avant de la file d'un autre ouvrier ou de la file
+     * des threads extérieurs.
+     *
+     * @return la tâche, ou @c nullptr si toutes ces files sont vides.
+     */
+    Tache* steal() const;
+
+    /**
+     * Exécute une tâche puis signale son terme.
+     */
+    void execute(Tache* tache) const;
+
+    /**
+     * Attend le terme d'une tâche volée, en volant d'autres tâches.
+     */
+    void attendre(const Tache& tache) const;
+
+    /**
+     * Boucle d'un ouvrier.
+     */
+    void boucle(const int& id);
+
+    /** Le nombre d'ouvriers. */
+    int threads_;
+
+    /** Les files des ouvriers, suivies de celle des threads extérieurs. */
+    std::vector< std::unique_ptr< File > > files_;
+
+    /** Le nombre de tâches en file. */
+    mutable std::atomic< size_t > enAttente_;
+
+    /** Indique si les ouvriers doivent s'arrêter. */
+    bool arret_;
+
+    /** Le verrou associé aux deux conditions ci-dessous. */
+    mutable std::mutex mutex_;
+
+    /** Condition signalant de nouvelles tâches aux ouvriers endormis. */
+    mutable std::condition_variable travail_;
+
+    /** Condition signalant le terme des tâches des threads extérieurs. */
+    mutable std::condition_variable fin_;
+
+    /** Les ouvriers. */
+    std::vector< std::thread > ouvriers_;
+
+    /** La réserve à laquelle appartient le thread courant, le cas échéant. */
+    static thread_local const ThreadPoolExecutor* pool_;
+
+    /** Le rang du thread courant dans sa réserve. */
+    static thread_local int courant_;
+
+  }; // ThreadPoolExecutor
+
+} // merging
+
+#endif
@@ -0,0 +1,238 @@
+#ifndef mergeJoin_hpp
+#define mergeJoin_hpp
+
+#include "ParallelStableMerge.hpp"
+#include "TBBExecutor.hpp"
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace merging {
+
+  /**
+   * Les types de jointure : interne (les paires d'éléments de même clé) ou
+   * externe gauche (de plus, les éléments du premier conteneur sans
+   * correspondant, associés à la fin du second).
+   */
+  enum JoinType { INNER_JOIN, LEFT_OUTER_JOIN };
+
+  /**
+   * Jointure séquentielle de deux sous-conteneurs ordonnés : chaque groupe
+   * de clés égales présent dans les deux sous-conteneurs produit le produit
+   * cartésien de ses éléments, ceux du premier sous-conteneur dans l'ordre,
+   * puis ceux du second pour chacun d'eux.
+   *
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   sous-conteneur ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier sous-conteneur ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   sous-conteneur ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second sous-conteneur ;
+   * @param[in] none - l'itérateur associé aux éléments du premier
+   *   sous-conteneur sans correspondant (jointure externe gauche) ;
+   * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+   *   strict régissant les clés des éléments des deux sous-conteneurs ;
+   * @param[in] type - le type de jointure ;
+   * @param[in] result - un itérateur repérant la position où écrire la
+   *   première paire, ignoré si @c Write vaut @c false (dénombrement seul).
+   * @return le nombre de paires de la jointure.
+   */
+  template< bool Write,
+            typename InputRandomAccessIterator1,
+            typename InputRandomAccessIterator2,
+            typename Compare,
+            typename OutputIterator >
+  size_t
+  mergeJoinSlice(InputRandomAccessIterator1 first1,
+                 const InputRandomAccessIterator1& last1,
+                 InputRandomAccessIterator2 first2,
+                 const InputRandomAccessIterator2& last2,
+                 const InputRandomAccessIterator2& none,
+                 const Compare& comp,
+                 const JoinType& type,
+                 OutputIterator result) {
+    size_t pairs = 0;
+    while (first1 != last1) {
+      if (first2 == last2 || comp(*first1, *first2)) {
+
+        // Élément du premier sous-conteneur sans correspondant.
+        if (type == LEFT_OUTER_JOIN) {
+          if (Write) {
+            *result = std::make_pair(first1, none);
+            ++ result;
+          }
+          pairs ++;
+        }
+        ++ first1;
+      } else if (comp(*first2, *first1)) {
+        ++ first2;
+      } else {
+
+        // Groupe de clés égales : ses bornes dans chacun des sous-conteneurs.
+        InputRandomAccessIterator1 end1 = first1 + 1;
+        while (end1 != last1 && ! comp(*first2, *end1)) {
+          ++ end1;
+        }
+        InputRandomAccessIterator2 end2 = first2 + 1;
+        while (end2 != last2 && ! comp(*first1, *end2)) {
+          ++ end2;
+        }
+        if (Write) {
+          for (InputRandomAccessIterator1 i = first1; i != end1; ++ i) {
+            for (InputRandomAccessIterator2 j = first2; j != end2; ++ j) {
+              *result = std::make_pair(i, j);
+              ++ result;
+            }
+          }
+        }
+        pairs += (end1 - first1) * (end2 - first2);
+        first1 = end1;
+        first2 = end2;
+      }
+    }
+    return pairs;
+  } // mergeJoinSlice
+
+  /**
+   * Jointure parallèle de deux conteneurs ordonnés selon la même clé (merge
+   * join). Le conteneur cible de la fusion des deux conteneurs est partagé
+   * en tranches égales, une par thread de l'exécuteur, par co-rang (cf.
+   * ParallelStableMerge::coRankGroup), sans qu'aucun groupe de clés égales
+   * ne soit partagé entre deux tranches. La jointure se déroule alors en
+   * deux passes : chaque thread dénombre les paires de sa tranche, une somme
+   * préfixe donne la position de chaque tranche dans le résultat, alloué
+   * d'un bloc, puis chaque thread y écrit ses paires sans le moindre verrou.
+   *
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   conteneur (à gauche de la jointure) ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier conteneur ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   conteneur (à droite de la jointure) ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second conteneur ;
+   * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+   *   strict régissant les clés, applicable à toute paire d'éléments des
+   *   deux conteneurs ;
+   * @param[in] type - le type de jointure ;
+   * @param[in] executor - l'exécuteur (cf. OpenMPExecutor), chacun de ses
+   *   threads traitant une tranche.
+   * @return les paires (gauche, droite) de la jointure, dans l'ordre de
+   *   mergeJoinSlice, l'élément de droite valant last2 pour les éléments de
+   *   gauche sans correspondant (jointure externe gauche).
+   *
+   * @note Les tranches sont équilibrées selon le nombre d'éléments des
+   *   conteneurs et non selon le nombre de paires : un groupe de clés égales
+   *   très nombreuses dans les deux conteneurs est traité par un seul
+   *   thread.
+   */
+  template< typename InputRandomAccessIterator1,
+            typename InputRandomAccessIterator2,
+            typename Compare,
+            typename Executor >
+  std::vector< std::pair< InputRandomAccessIterator1,
+                          InputRandomAccessIterator2 > >
+  mergeJoin(const InputRandomAccessIterator1& first1,
+            const InputRandomAccessIterator1& last1,
+            const InputRandomAccessIterator2& first2,
+            const InputRandomAccessIterator2& last2,
+            const Compare& comp,
+            const JoinType& type,
+            const Executor& executor) {
+
+    // Types synonymes permettant de ne rien préjuger des types entiers
+    // manipulés.
+    typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+    typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+    typedef typename TraitsInput1::difference_type InputSize1;
+    typedef typename TraitsInput2::difference_type InputSize2;
+    typedef std::vector< std::pair< InputRandomAccessIterator1,
+                                    InputRandomAccessIterator2 > > Pairs;
+
+    // Tailles respectives des deux conteneurs et de leur fusion.
+    const InputSize1 m = last1 - first1;
+    const InputSize2 n = last2 - first2;
+    const InputSize1 mpn = m + n;
+
+    // Bornes des tranches dans les deux conteneurs (j et k), nombres de
+    // paires puis positions des tranches dans le résultat (o).
+    const int threads = executor.concurrency();
+    std::vector< InputSize1 > j(threads + 1);
+    std::vector< InputSize2 > k(threads + 1);
+    std::vector< size_t > o(threads + 1, 0);
+    Pairs pairs;
+    executor.run([&]() {
+        executor.parallelFor(0, threads + 1, [&](const int& r) {
+            const InputSize1 i = mpn * r / threads;
+            ParallelStableMerge::coRankGroup(i, first1, m, first2, n, comp,
+                                             j[r], k[r]);
+          });
+
+        // Première passe : dénombrement des paires de chaque tranche.
+        executor.parallelFor(0, threads, [&](const int& r) {
+            o[r + 1] =
+              mergeJoinSlice< false >(first1 + j[r], first1 + j[r + 1],
+                                      first2 + k[r], first2 + k[r + 1],
+                                      last2, comp, type,
+                                      static_cast< typename Pairs::pointer >(
+                                        nullptr));
+          });
+
+        // Somme préfixe : position des paires de chaque tranche.
+        std::partial_sum(o.begin(), o.end(), o.begin());
+        pairs.resize(o[threads]);
+
+        // Seconde passe : écriture des paires de chaque tranche.
+        executor.parallelFor(0, threads, [&](const int& r) {
+            mergeJoinSlice< true >(first1 + j[r], first1 + j[r + 1],
+                                   first2 + k[r], first2 + k[r + 1],
+                                   last2, comp, type,
+                                   pairs.begin() + o[r]);
+          });
+      });
+    return pairs;
+
+  } // mergeJoin
+
+  /**
+   * Jointure parallèle via TBB.
+   *
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   conteneur (à gauche de la jointure) ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier conteneur ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   conteneur (à droite de la jointure) ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second conteneur ;
+   * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+   *   strict régissant les clés, applicable à toute paire d'éléments des
+   *   deux conteneurs ;
+   * @param[in] type - le type de jointure ;
+   * @param[in] threads - le nombre de threads disponibles.
+   * @return les paires (gauche, droite) de la jointure.
+   */
+  template< typename InputRandomAccessIterator1,
+            typename InputRandomAccessIterator2,
+            typename Compare >
+  std::vector< std::pair< InputRandomAccessIterator1,
+                          InputRandomAccessIterator2 > >
+  mergeJoin(const InputRandomAccessIterator1& first1,
+            const InputRandomAccessIterator1& last1,
+            const InputRandomAccessIterator2& first2,
+            const InputRandomAccessIterator2& last2,
+            const Compare& comp,
+            const JoinType& type,
+            const int& threads) {
+    return mergeJoin(first1, last1, first2, last2, comp, type,
+                     TBBExecutor(threads));
+  } // mergeJoin
+
+} // merging
+
+#endif
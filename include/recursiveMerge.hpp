@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <iterator>
 
 namespace merging {
 
@@ -33,6 +34,8 @@ namespace merging {
    *   récursion est interrompue lorsque la somme des tailles des deux
    *   sous-conteneurs à fusionner passe sous une certaine tolérance. La fusion
    *   est alors effectuée via l'algorithme merge de la bibliothèque standard.
+   * @note Les itérateurs d'entrée peuvent être des std::move_iterator : les
+   *   éléments sont alors déplacés et non recopiés (cf. recursiveMoveMerge).
    */
   template< typename InputRandomAccessIterator1,
             typename InputRandomAccessIterator2,
@@ -56,17 +59,17 @@ namespace merging {
     }
 
     if (size1 < size2) {
-      return recursiveMerge(first2, last2, first1, last1, result, comp);
+      return recursiveMerge(first2, last2, first1, last1, result, comp, cutoff);
     }
 
     auto q1 = first1 + (size1/2);
     auto q2 = std::lower_bound(first2, last2, *q1, comp);
     auto q3 = result + (q1 - first1) + (q2 - first2);
 
-    *q3 = *q1
+    *q3 = *q1;
 
-    recursiveMerge(first1, q1, first2, q2, result, comp);
-    recursiveMerge(q1+1 ,last1 ,q2 ,last2 , q3 + 1, comp);
+    recursiveMerge(first1, q1, first2, q2, result, comp, cutoff);
+    recursiveMerge(q1+1 ,last1 ,q2 ,last2 , q3 + 1, comp, cutoff);
 
     return result + size1 + size2;
 
@@ -123,6 +126,51 @@ namespace merging {
 
   } // recursiveMerge
 
+  /**
+   * Variante de l'algorithme recursiveMerge déplaçant les éléments des deux
+   * sous-conteneurs au lieu de les recopier : ni copie ni allocation par
+   * élément, les deux sous-conteneurs n'étant plus exploitables (hormis
+   * pour y affecter de nouvelles valeurs ou les détruire) après la fusion.
+   *
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second sous-conteneur concerné par la fusion ;
+   * @param[in] result - un itérateur repérant la position ou déplacer le
+   *   premier élément résultant de la fusion ;
+   * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+   *   total régissant les sous-conteneurs ;
+   * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+   *   dessous de laquelle la fusion est effectuée via l'algorithme merge de
+   *   la bibliothèque standard.
+   * @return un itérateur repérant la fin de la zone de fusion dans le
+   *   conteneur cible.
+   */
+  template< typename InputRandomAccessIterator1,
+            typename InputRandomAccessIterator2,
+            typename OutputRandomAccessIterator,
+            typename Compare >
+  OutputRandomAccessIterator
+  recursiveMoveMerge(const InputRandomAccessIterator1& first1,
+                     const InputRandomAccessIterator1& last1,
+                     const InputRandomAccessIterator2& first2,
+                     const InputRandomAccessIterator2& last2,
+                     const OutputRandomAccessIterator& result,
+                     const Compare& comp,
+                     const size_t& cutoff = 128) {
+    return recursiveMerge(std::make_move_iterator(first1),
+                          std::make_move_iterator(last1),
+                          std::make_move_iterator(first2),
+                          std::make_move_iterator(last2),
+                          result,
+                          comp,
+                          cutoff);
+  } // recursiveMoveMerge
+
 } // merging
 
 #endif
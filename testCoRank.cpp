@@ -0,0 +1,207 @@
+#include "ParallelStableMerge.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <omp.h>
+
+/**
+ * Co-rang de l'implémentation initiale de ParallelStableMerge (recherche de
+ * Siebert et Träff, pas calculés en réels), conservé comme référence.
+ */
+template< typename Size, typename Iterator, typename Compare >
+void
+coRankInitial(const Size& i,
+	      const Iterator& a, const Size& m,
+	      const Iterator& b, const Size& n,
+	      const Compare& comp,
+	      Size& j, Size& k) {
+  j = std::min(i, m);
+  k = i - j;
+  Size klow = 0;
+  Size jlow = i < n ? 0 : i - n;
+  bool active = true;
+  while (active) {
+    if (j > 0 and k < n and comp(b[k], a[j-1])) {
+      Size sigma = std::ceil((j - jlow) / 2.);
+      klow = k;
+      j = j - sigma;
+      k = k + sigma;
+    } else if (k > 0 and j < m and ! comp(b[k-1], a[j])) {
+      Size sigma = std::ceil((k - klow) / 2.);
+      jlow = j;
+      j = j + sigma;
+      k = k - sigma;
+    } else {
+      active = false;
+    }
+  }
+}
+
+/**
+ * Mesure le débit d'un co-rang : les rangs des points de partage de P
+ * tranches égales sont recherchés iters fois.
+ *
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] lhs le premier conteneur ordonné.
+ * @param[in] rhs le second conteneur ordonné.
+ * @param[in] partages le nombre de points de partage.
+ * @param[out] j les rangs trouvés dans le premier conteneur.
+ * @param[in] coRank le co-rang évalué.
+ * @return le nombre de points de partage par seconde.
+ */
+template< typename CoRank >
+double
+mesurer(const size_t& iters,
+	const std::vector< int >& lhs,
+	const std::vector< int >& rhs,
+	const long& partages,
+	std::vector< long >& j,
+	const CoRank& coRank) {
+  const long m = lhs.size(), n = rhs.size(), mpn = m + n;
+  j.assign(partages + 1, 0);
+  const double start = omp_get_wtime();
+  for (size_t it = 0; it != iters; it ++) {
+    for (long r = 0; r <= partages; r ++) {
+      long k;
+      coRank(mpn * r / partages, lhs.begin(), m, rhs.begin(), n,
+	     std::less< const int& >(), j[r], k);
+    }
+  }
+  const double stop = omp_get_wtime();
+  return iters * (partages + 1) / (stop - start);
+}
+
+/**
+ * Compare les deux co-rangs sur une paire de conteneurs.
+ *
+ * @param[in] titre le titre du benchmark.
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] lhs le premier conteneur ordonné.
+ * @param[in] rhs le second conteneur ordonné.
+ * @param[in] partages le nombre de points de partage.
+ */
+void
+tester(const std::string& titre,
+       const size_t& iters,
+       const std::vector< int >& lhs,
+       const std::vector< int >& rhs,
+       const long& partages) {
+  typedef std::vector< int >::const_iterator Iterator;
+  std::vector< long > reference, result;
+  const double avant =
+    mesurer(iters, lhs, rhs, partages, reference,
+	    coRankInitial< long, Iterator, std::less< const int& > >);
+  const double apres =
+    mesurer(iters, lhs, rhs, partages, result,
+	    merging::ParallelStableMerge::coRank< long, Iterator, long,
+						  Iterator, long,
+						  std::less< const int& > >);
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tPartages/s (initial / galop):\t" << avant << " / " << apres
+	    << std::endl;
+  std::cout << "\tGain:\t\t" << apres / avant << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << (result == reference)
+	    << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof() || iters == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Fusions de 4K (nombreuses petites fusions, partagées tous les 16
+  // éléments) et de 8M éléments (1024 tranches), le premier conteneur étant
+  // de plus en plus court. Les éléments sont tirés par un générateur
+  // congruentiel (pour des résultats reproductibles) : clés presque toutes
+  // distinctes, puis 16 clés seulement (nombreuses égalités entre les deux
+  // conteneurs, que la stabilité départage), enfin conteneurs disjoints,
+  // toutes les clés du premier précédant celles du second ou l'inverse, cas
+  // les plus défavorables pour l'estimation du galop.
+  const long tailles[] = { 4 * 1024, 8 * 1024 * 1024 };
+  const long partages[] = { 256, 1024 };
+  for (int t = 0; t != 2; t ++) {
+    for (long ratio = 1; ratio <= 4096 && ratio < tailles[t]; ratio *= 16) {
+      const long m = tailles[t] / (ratio + 1), n = tailles[t] - m;
+      std::vector< int > tirage1(m), tirage2(n), lhs(m), rhs(n);
+      uint32_t graine = 12345;
+      for (int& x : tirage1) {
+	graine = graine * 1664525u + 1013904223u;
+	x = graine >> 1;
+      }
+      for (int& x : tirage2) {
+	graine = graine * 1664525u + 1013904223u;
+	x = graine >> 1;
+      }
+      const std::string titre =
+	std::to_string(m) + " + " + std::to_string(n) + " (1:"
+	+ std::to_string(ratio) + ")";
+      const size_t repetitions =
+	std::max(iters * (8 * 1024 * 1024 / tailles[t]) / 64, iters);
+
+      // Les deux conteneurs, obtenus des tirages par une transformation
+      // croissante propre à chacun, puis ordonnés.
+      const auto preparer = [&](int (*f1)(const int&), int (*f2)(const int&)) {
+	std::transform(tirage1.begin(), tirage1.end(), lhs.begin(), f1);
+	std::transform(tirage2.begin(), tirage2.end(), rhs.begin(), f2);
+	std::sort(lhs.begin(), lhs.end());
+	std::sort(rhs.begin(), rhs.end());
+      };
+      struct Cles {
+	static int identite(const int& x) { return x; }
+	static int classe(const int& x) { return x % 16; }
+	static int bas(const int& x) { return x / 2; }
+	static int haut(const int& x) { return x / 2 + (1 << 30); }
+      };
+      preparer(Cles::identite, Cles::identite);
+      tester(titre + ", entrelacés", repetitions, lhs, rhs, partages[t]);
+      preparer(Cles::classe, Cles::classe);
+      tester(titre + ", 16 clés", repetitions, lhs, rhs, partages[t]);
+      preparer(Cles::bas, Cles::haut);
+      tester(titre + ", disjoints", repetitions, lhs, rhs, partages[t]);
+      preparer(Cles::haut, Cles::bas);
+      tester(titre + ", inversés", repetitions, lhs, rhs, partages[t]);
+    }
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
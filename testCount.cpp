@@ -1,13 +1,20 @@
 #include "Count.hpp"
+#include "BatchCount.hpp"
+#include "FileCount.hpp"
 #include "Metrics.hpp"
 #include <array>
+#include <deque>
 #include <list>
+#include <vector>
+#include <string>
 #include <iostream>
 #include <sstream>
+#include <fstream>
 #include <cstdlib>
+#include <unistd.h>
 
 /**
- * Routine d'évaluation des performances.
+ * Routine d'évaluation des performances d'une version parallèle donnée.
  *
  * @param[in] first le paramètre @c first de l'algorithme.
  * @param[in] last le paramètre @c last de l'algorithme.
@@ -16,21 +23,23 @@
  * @param[in] titre le titre du benckmark.
  * @param[in] iters le nombre d'itérations à effectuer sur le même algorithme 
  *   pour obtenir des mesures de temps conséquentes.
+ * @param[in] algo la version parallèle, invoquée avec first, last et val.
  */
-template< typename InputIterator, typename T >
+template< typename InputIterator, typename T, typename Algorithm >
 void
 tester(const InputIterator& first, 
        const InputIterator& last, 
        const T& val,
        const int& threads,
        const std::string& titre,
-       const size_t& iters) {
+       const size_t& iters,
+       const Algorithm& algo) {
 
   using namespace paralgos;
 
   // Le résultat de l'algorithme (un par version).
-  typename std::iterator_traits< InputIterator >::difference_type resSeq,
-    resPar;
+  typename std::iterator_traits< InputIterator >::difference_type resSeq = 0,
+    resPar = 0;
 
   // Durée d'exécution de la version séquentielle (bibliothèque standard).
   double seq;
@@ -48,7 +57,7 @@ tester(const InputIterator& first,
   {
     const double start = omp_get_wtime( );
     for (size_t i = 0; i != iters; i ++) {
-      resPar = Count::apply(first, last, val);
+      resPar = algo(first, last, val);
     }
     const double stop = omp_get_wtime( );
     par = stop - start;
@@ -70,6 +79,252 @@ tester(const InputIterator& first,
 
 }
 
+/**
+ * Routine d'évaluation des performances de Count::apply.
+ *
+ * @param[in] first le paramètre @c first de l'algorithme.
+ * @param[in] last le paramètre @c last de l'algorithme.
+ * @param[in] val  le paramètre @c val de l'algorithme.
+ * @param[in] threads le nombre de threads utilisés.
+ * @param[in] titre le titre du benckmark.
+ * @param[in] iters le nombre d'itérations à effectuer sur le même algorithme 
+ *   pour obtenir des mesures de temps conséquentes.
+ */
+template< typename InputIterator, typename T >
+void
+tester(const InputIterator& first, 
+       const InputIterator& last, 
+       const T& val,
+       const int& threads,
+       const std::string& titre,
+       const size_t& iters) {
+  tester(first, last, val, threads, titre, iters,
+         [](const InputIterator& first,
+            const InputIterator& last,
+            const T& val) {
+           return paralgos::Count::apply(first, last, val);
+         });
+}
+
+/**
+ * Routine d'évaluation de la latence d'un appel sur de petits tableaux
+ * (de 1K à 64K éléments), pour lesquels le coût d'ouverture d'une région
+ * parallèle n'est plus négligeable.
+ *
+ * @param[in] iters le nombre d'appels effectués pour chaque taille.
+ */
+void
+latence(const size_t& iters) {
+
+  using namespace paralgos;
+
+  // Un contexte toujours parallèle (seuil nul) et le contexte par défaut, qui
+  // se replie sur le noyau séquentiel en dessous de son seuil.
+  const ExecutionContext parallele(0, 0);
+  const ExecutionContext& standard = ExecutionContext::standard();
+
+  // Le tableau dont seuls les n premiers éléments seront traités.
+  std::vector< int > tableau(64 * 1024);
+  for (size_t i = 0; i != tableau.size(); i ++) {
+    tableau[i] = i % 5;
+  }
+  const int val = 3;
+
+  for (size_t n = 1024; n <= tableau.size(); n *= 2) {
+
+    // Les résultats des trois versions.
+    std::iterator_traits< std::vector< int >::iterator >::difference_type
+      resSeq = 0, resPar = 0, resCtx = 0;
+
+    // Latence de la version séquentielle (bibliothèque standard).
+    double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      resSeq += std::count(tableau.begin(), tableau.begin() + n, val);
+    }
+    const double seq = (omp_get_wtime() - start) / iters;
+
+    // Latence de la version parallèle, quelle que soit la taille.
+    start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      resPar += Count::apply(tableau.begin(),
+                             tableau.begin() + n,
+                             val,
+                             parallele);
+    }
+    const double par = (omp_get_wtime() - start) / iters;
+
+    // Latence de la version utilisant le contexte par défaut.
+    start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      resCtx += Count::apply(tableau.begin(),
+                             tableau.begin() + n,
+                             val,
+                             standard);
+    }
+    const double ctx = (omp_get_wtime() - start) / iters;
+
+    // Affichage des résultats (en microsecondes par appel).
+    std::cout << "--[ latence (" << n << "): begin ] --" << std::endl;
+    std::cout << "\tstd::count :\t\t" << seq * 1e6 << " usec." << std::endl;
+    std::cout << "\tparallèle  :\t\t" << par * 1e6 << " usec." << std::endl;
+    std::cout << "\tcontexte   :\t\t" << ctx * 1e6 << " usec." << std::endl;
+    std::cout << "\tVerdict:\t\t"
+              << std::boolalpha
+              << (resSeq == resPar && resSeq == resCtx)
+              << std::endl;
+    std::cout << "\tThread(s):\t\t" << standard.threads() << std::endl;
+    std::cout << "\tSeuil:\t\t\t" << standard.threshold() << std::endl;
+    std::cout << "--[ latence (" << n << "): end ] --" << std::endl;
+    std::cout << std::endl;
+
+  }
+
+}
+
+/**
+ * Routine d'évaluation des performances du comptage simultané de plusieurs
+ * valeurs : un appel à BatchCount::apply contre un appel à Count::apply par
+ * valeur recherchée.
+ *
+ * @param[in] tableau le tableau dans lequel rechercher les valeurs.
+ * @param[in] vals les valeurs recherchées.
+ * @param[in] threads le nombre de threads utilisés.
+ * @param[in] iters le nombre d'itérations à effectuer sur le même algorithme
+ *   pour obtenir des mesures de temps conséquentes.
+ */
+void
+testerBatch(const std::vector< int >& tableau,
+            const std::vector< int >& vals,
+            const int& threads,
+            const size_t& iters) {
+
+  using namespace paralgos;
+
+  // Les résultats de chaque version.
+  std::vector< std::vector< int >::difference_type >
+    resCount(vals.size()), resBatch;
+
+  // Durée d'exécution d'un appel à Count::apply par valeur.
+  double seq;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      for (size_t q = 0; q != vals.size(); q ++) {
+        resCount[q] = Count::apply(tableau.begin(), tableau.end(), vals[q]);
+      }
+    }
+    const double stop = omp_get_wtime();
+    seq = stop - start;
+  }
+
+  // Durée d'exécution du comptage simultané.
+  double par;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      resBatch = BatchCount::apply(tableau.begin(), tableau.end(), vals);
+    }
+    const double stop = omp_get_wtime();
+    par = stop - start;
+  }
+
+  // Affichage des résultats.
+  std::cout << "--[ batch (" << vals.size() << " valeurs): begin ] --"
+            << std::endl;
+  std::cout << "\tDurée Count :\t\t" << seq << " sec." << std::endl;
+  std::cout << "\tDurée BatchCount :\t" << par << " sec." << std::endl;
+  std::cout << "\tVerdict:\t\t"
+            << std::boolalpha << (resCount == resBatch) << std::endl;
+  std::cout << "\tThread(s):\t\t" << threads << std::endl;
+  std::cout << "\tSpeedup:\t\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "--[ batch (" << vals.size() << " valeurs): end ] --"
+            << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Routine d'évaluation du débit du comptage dans un fichier projeté en
+ * mémoire, comparé à celui du comptage en mémoire via Count::apply.
+ *
+ * @param[in] tableau le tableau d'entiers, également écrit dans un fichier
+ *   temporaire.
+ * @param[in] val la valeur recherchée.
+ * @param[in] threads le nombre de threads utilisés.
+ * @param[in] iters le nombre d'itérations à effectuer sur le même algorithme
+ *   pour obtenir des mesures de temps conséquentes.
+ * @note Le fichier venant d'être écrit, il réside dans le cache du système :
+ *   ce sont les débits de la projection et du comptage qui sont mesurés, pas
+ *   celui du disque.
+ */
+void
+testerFichier(const std::vector< int >& tableau,
+              const int& val,
+              const int& threads,
+              const size_t& iters) {
+
+  using namespace paralgos;
+
+  // Écriture du tableau dans un fichier temporaire.
+  char path[] = "/tmp/testCountXXXXXX";
+  const int fd = mkstemp(path);
+  if (fd == -1) {
+    std::cerr << "Fichier temporaire impossible à créer." << std::endl;
+    return;
+  }
+  close(fd);
+  {
+    std::ofstream sortie(path, std::ios::binary);
+    sortie.write(reinterpret_cast< const char* >(tableau.data()),
+                 tableau.size() * sizeof(int));
+  }
+  const double octets = tableau.size() * sizeof(int) * 1.0 * iters;
+
+  // Les résultats de chaque version.
+  size_t resMem = 0, resFic = 0, resOct = 0, resOctMem = 0;
+  const unsigned char octet = val;
+
+  // Débit du comptage en mémoire.
+  double start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    resMem = Count::apply(tableau.begin(), tableau.end(), val);
+  }
+  const double mem = omp_get_wtime() - start;
+
+  // Débit du comptage des entiers du fichier.
+  start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    resFic = FileCount::apply(path, val);
+  }
+  const double fic = omp_get_wtime() - start;
+
+  // Débit du comptage des octets du fichier.
+  start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    resOct = FileCount::apply(path, octet);
+  }
+  const double oct = omp_get_wtime() - start;
+  const unsigned char* debut =
+    reinterpret_cast< const unsigned char* >(tableau.data());
+  resOctMem = std::count(debut, debut + tableau.size() * sizeof(int), octet);
+  unlink(path);
+
+  // Affichage des résultats.
+  std::cout << "--[ fichier: begin ] --" << std::endl;
+  std::cout << "\tDébit mémoire :\t\t" << octets / mem * 1e-9 << " Go/s"
+            << std::endl;
+  std::cout << "\tDébit entiers :\t\t" << octets / fic * 1e-9 << " Go/s"
+            << std::endl;
+  std::cout << "\tDébit octets :\t\t" << octets / oct * 1e-9 << " Go/s"
+            << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha
+            << (resMem == resFic && resOct == resOctMem) << std::endl;
+  std::cout << "\tThread(s):\t\t" << threads << std::endl;
+  std::cout << "--[ fichier: end ] --" << std::endl;
+  std::cout << std::endl;
+
+}
+
 /**
  * Programme principal.
  *
@@ -83,13 +338,14 @@ main(int argc, char* argv[]) {
 
   // La ligne de commandes est vide : l'utilisateur demande de l'aide.
   if (argc == 1) {
-    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    std::cout << "Usage: " << argv[0] << " nb_iterations [latence]"
+              << std::endl;
     return EXIT_SUCCESS;
   }
 
-  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
-  // quoi.
-  if (argc != 2) {
+  // Le nombre d'arguments est différent de 1 ou 2 : l'utilisateur fait
+  // n'importe quoi.
+  if (argc != 2 && argc != 3) {
     std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
     return EXIT_FAILURE;
   }
@@ -105,11 +361,18 @@ main(int argc, char* argv[]) {
     }
   }  
 
+  // Le mode latence ne traite que de petits tableaux.
+  if (argc == 3) {
+    if (std::string(argv[2]) != "latence") {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+    latence(iters);
+    return EXIT_SUCCESS;
+  }
+
   //  Nombre de threads utilisés.
-  int threads;
-#pragma omp parallel
-#pragma omp single
-    threads = omp_get_num_threads();
+  const int threads = paralgos::ExecutionContext::standard().threads();
 
   // Nombres d'éléments à traiter.
   const size_t n = 1024 * 1021;
@@ -119,9 +382,15 @@ main(int argc, char* argv[]) {
   // d'exécution.
   std::list< int > liste;
   std::array< int, n > tableau;
+  std::deque< int > fileDouble;
+  std::vector< double > reels(n);
+  std::vector< bool > bits(n);
   for (int i = 0; i != n; i ++) {
       liste.push_back(i % 5);
       tableau[i] = i % 5;
+      fileDouble.push_back(i % 5);
+      reels[i] = i % 5;
+      bits[i] = i % 5 == 3;
   }
 
   // La valeur recherchée.
@@ -135,13 +404,94 @@ main(int argc, char* argv[]) {
          "list",
          iters);
 
-  // Second test : le tableau d'entiers.
-  tester(tableau.begin(),
-         tableau.end(), 
+  // La liste d'entiers avec chacune des deux stratégies dédiées aux
+  // itérateurs qui ne sont pas à accès direct.
+  typedef std::list< int >::iterator Iterateur;
+  typedef paralgos::Count::Impl< std::bidirectional_iterator_tag > ImplListe;
+  tester(liste.begin(),
+         liste.end(),
+         val,
+         threads,
+         "list (strategyA)",
+         iters,
+         [threads](const Iterateur& first,
+                   const Iterateur& last,
+                   const int& val) {
+           return ImplListe::strategyA(first, last, val, threads);
+         });
+  tester(liste.begin(),
+         liste.end(),
          val,
          threads,
-         "array",
+         "list (strategyB)",
+         iters,
+         [threads](const Iterateur& first,
+                   const Iterateur& last,
+                   const int& val) {
+           return ImplListe::strategyB(first, last, val, threads);
+         });
+
+  // Tests suivants : le tableau d'entiers, la file à double entrée (traitée
+  // bloc par bloc), le vecteur de réels et le vecteur de bits, avec chacun
+  // des jeux d'instructions disponibles.
+  using paralgos::SimdCount;
+  const SimdCount::Isa best = SimdCount::detect();
+  for (int i = SimdCount::SCALAR; i <= best; i ++) {
+    const SimdCount::Isa isa = SimdCount::setIsa(SimdCount::Isa(i));
+    tester(tableau.begin(),
+           tableau.end(), 
+           val,
+           threads,
+           std::string("array (") + SimdCount::name(isa) + ")",
+           iters);
+    tester(fileDouble.begin(),
+           fileDouble.end(),
+           val,
+           threads,
+           std::string("deque (") + SimdCount::name(isa) + ")",
+           iters);
+    tester(reels.begin(),
+           reels.end(),
+           3.0,
+           threads,
+           std::string("vector<double> (") + SimdCount::name(isa) + ")",
+           iters);
+    tester(bits.cbegin(),
+           bits.cend(),
+           true,
+           threads,
+           std::string("vector<bool> (") + SimdCount::name(isa) + ")",
+           iters);
+  }
+
+  // Le vecteur de bits privé de quelques bits à chaque extrémité : le premier
+  // et le dernier mot ne sont que partiellement comptés.
+  tester(bits.cbegin() + 3,
+         bits.cend() - 5,
+         false,
+         threads,
+         "vector<bool> (mots partiels)",
          iters);
+
+  // Le tableau d'entiers, cette fois stocké dans un fichier.
+  testerFichier(std::vector< int >(tableau.begin(), tableau.end()),
+                val,
+                threads,
+                iters);
+
+  // Dernier test : le comptage simultané de 8 à 64 valeurs, comparé à autant
+  // d'appels à Count::apply, sur un tableau comptant 64 valeurs distinctes.
+  std::vector< int > codes(n);
+  for (int i = 0; i != n; i ++) {
+    codes[i] = (i * 37) % 64;
+  }
+  for (int nvals = 8; nvals <= 64; nvals *= 2) {
+    std::vector< int > vals(nvals);
+    for (int q = 0; q != nvals; q ++) {
+      vals[q] = q * 64 / nvals;
+    }
+    testerBatch(codes, vals, threads, iters);
+  }
  
   // Tout s'est bien passé.
   return EXIT_SUCCESS;
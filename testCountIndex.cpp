@@ -0,0 +1,155 @@
+#include "CountIndex.hpp"
+#include "Count.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdint>
+
+/**
+ * Routine d'évaluation des performances sous une charge mêlant mises à jour
+ * et requêtes : chaque tour modifie quelques éléments puis demande le nombre
+ * d'occurrences d'une valeur, soit par un appel à Count::apply sur un
+ * vecteur, soit par une requête à l'index.
+ *
+ * @param[in] tableau le contenu initial du conteneur.
+ * @param[in] val la valeur recherchée.
+ * @param[in] majs le nombre de mises à jour par requête.
+ * @param[in] threads le nombre de threads utilisés.
+ * @param[in] iters le nombre de tours (une requête par tour).
+ */
+void
+tester(const std::vector< int >& tableau,
+       const int& val,
+       const size_t& majs,
+       const int& threads,
+       const size_t& iters) {
+
+  using namespace paralgos;
+
+  // Les deux conteneurs, modifiés de la même manière.
+  std::vector< int > vecteur(tableau);
+  double construction;
+  CountIndex< int > index;
+  {
+    const double start = omp_get_wtime();
+    index.assign(tableau.cbegin(), tableau.cend());
+    const double stop = omp_get_wtime();
+    construction = stop - start;
+  }
+
+  // Les résultats cumulés de chaque version.
+  long resCount = 0, resIndex = 0;
+
+  // Durée d'exécution avec Count::apply (générateur congruentiel, pour des
+  // mises à jour reproductibles).
+  double seq;
+  {
+    uint32_t graine = 12345;
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      for (size_t m = 0; m != majs; m ++) {
+        graine = graine * 1664525u + 1013904223u;
+        vecteur[(graine >> 8) % vecteur.size()] = (graine >> 4) % 5;
+      }
+      resCount += Count::apply(vecteur.cbegin(), vecteur.cend(), val);
+    }
+    const double stop = omp_get_wtime();
+    seq = stop - start;
+  }
+
+  // Durée d'exécution avec l'index.
+  double par;
+  {
+    uint32_t graine = 12345;
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      for (size_t m = 0; m != majs; m ++) {
+        graine = graine * 1664525u + 1013904223u;
+        index.set(index.begin() + (graine >> 8) % index.size(),
+                  (graine >> 4) % 5);
+      }
+      resIndex += index.count(val);
+    }
+    const double stop = omp_get_wtime();
+    par = stop - start;
+  }
+
+  // Vérification des résultats, y compris après une reconstruction.
+  index.rebuild();
+  const bool verdict = resCount == resIndex
+    && index.count(val) == Count::apply(vecteur.cbegin(), vecteur.cend(), val);
+
+  // Affichage des résultats (en microsecondes par tour).
+  std::ostringstream titre;
+  titre << "mises à jour/requête = " << majs;
+  std::cout << "--[ " << titre.str() << ": begin ] --" << std::endl;
+  std::cout << "\tConstruction :\t\t" << construction * 1e6 << " µs"
+            << std::endl;
+  std::cout << "\tLatence Count :\t\t" << seq / iters * 1e6 << " µs"
+            << std::endl;
+  std::cout << "\tLatence CountIndex :\t" << par / iters * 1e6 << " µs"
+            << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "\tThread(s):\t\t" << threads << std::endl;
+  std::cout << "\tSpeedup:\t\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "--[ " << titre.str() << ": end ] --" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //  Nombre de threads utilisés.
+  const int threads = paralgos::ExecutionContext::standard().threads();
+
+  // Le conteneur initial (celui de testCount).
+  const int n = 1024 * 1021;
+  std::vector< int > tableau(n);
+  for (int i = 0; i != n; i ++) {
+    tableau[i] = i % 5;
+  }
+
+  // Charges de plus en plus dominées par les mises à jour.
+  for (size_t majs = 1; majs <= 1000; majs *= 10) {
+    tester(tableau, 3, majs, threads, iters);
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
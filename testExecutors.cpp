@@ -0,0 +1,186 @@
+#include "ParallelRecursiveMerge.hpp"
+#include "ParallelStableMerge.hpp"
+#include "OpenMPExecutor.hpp"
+#include "TBBExecutor.hpp"
+#include "ThreadPoolExecutor.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+
+/**
+ * Routine d'évaluation des performances d'une même fusion confiée à un
+ * exécuteur donné : fusion récursive (stratégie reposant sur l'exécuteur)
+ * puis fusion stable.
+ *
+ * @param[in] nom le nom de l'exécuteur.
+ * @param[in] executor l'exécuteur.
+ * @param[in] lhs le premier conteneur ordonné.
+ * @param[in] rhs le second conteneur ordonné.
+ * @param[in] reference le résultat de l'algorithme merge.
+ * @param[in] seq la durée d'exécution de l'algorithme merge.
+ * @param[in] cutoff la tolérance de la fusion récursive.
+ * @param[in] iters le nombre d'itérations.
+ */
+template< typename Type, typename Executor >
+void
+tester(const std::string& nom,
+       const Executor& executor,
+       const std::vector< Type >& lhs,
+       const std::vector< Type >& rhs,
+       const std::vector< Type >& reference,
+       const double& seq,
+       const size_t& cutoff,
+       const size_t& iters) {
+
+  std::vector< Type > result(reference.size());
+  const int threads = executor.concurrency();
+
+  // Durée d'exécution de la fusion récursive.
+  double recursive;
+  bool verdictRecursive;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::ParallelRecursiveMerge::apply(lhs.begin(),
+					     lhs.end(),
+					     rhs.begin(),
+					     rhs.end(),
+					     result.begin(),
+					     cutoff,
+					     executor);
+    }
+    const double stop = omp_get_wtime();
+    recursive = stop - start;
+    verdictRecursive = result == reference;
+  }
+
+  // Durée d'exécution de la fusion stable.
+  double stable;
+  bool verdictStable;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::ParallelStableMerge::apply(lhs.begin(),
+					  lhs.end(),
+					  rhs.begin(),
+					  rhs.end(),
+					  result.begin(),
+					  std::less< const Type& >(),
+					  executor);
+    }
+    const double stop = omp_get_wtime();
+    stable = stop - start;
+    verdictStable = result == reference;
+  }
+
+  // Affichage des performances des deux fusions, côte à côte.
+  std::cout << "--[ " << nom << ": begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tDurée (récursive / stable):\t"
+	    << recursive << " / " << stable << " sec." << std::endl;
+  std::cout << "\tVerdict (récursive / stable):\t"
+	    << std::boolalpha << verdictRecursive << " / " << verdictStable
+	    << std::endl;
+  std::cout << "\tSpeedup (récursive / stable):\t"
+	    << Metrics::speedup(seq, recursive) << " / "
+	    << Metrics::speedup(seq, stable) << std::endl;
+  std::cout << "\tEfficiency (récursive / stable):\t"
+	    << Metrics::efficiency(seq, recursive, threads) << " / "
+	    << Metrics::efficiency(seq, stable, threads) << std::endl;
+  std::cout << "--[ " << nom << ": end ]--" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Synonyme du type des éléments à fusionner.
+  typedef int Type;
+
+  // Deux tableaux ordonnés de tailles différentes, remplis par un générateur
+  // congruentiel (pour des résultats reproductibles).
+  std::vector< Type > lhs(4 * 1024 * 1024), rhs(lhs.size() + 211);
+  uint32_t graine = 12345;
+  for (Type& x : lhs) {
+    graine = graine * 1664525u + 1013904223u;
+    x = graine >> 1;
+  }
+  for (Type& x : rhs) {
+    graine = graine * 1664525u + 1013904223u;
+    x = graine >> 1;
+  }
+  std::sort(lhs.begin(), lhs.end());
+  std::sort(rhs.begin(), rhs.end());
+
+  // Durée d'exécution de l'algorithme merge de la bibliothèque standard.
+  std::vector< Type > reference(lhs.size() + rhs.size());
+  double seq;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      std::merge(lhs.begin(),
+		 lhs.end(),
+		 rhs.begin(),
+		 rhs.end(),
+		 reference.begin());
+    }
+    const double stop = omp_get_wtime();
+    seq = stop - start;
+  }
+  std::cout << "--[ merge: begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << seq << " sec." << std::endl;
+  std::cout << "--[ merge: end ]--" << std::endl;
+  std::cout << std::endl;
+
+  // La même fusion sur chacun des exécuteurs, avec le même nombre de threads.
+  const int threads = omp_get_max_threads();
+  const size_t cutoff = 64 * 1024;
+  tester("OpenMPExecutor", merging::OpenMPExecutor(threads),
+	 lhs, rhs, reference, seq, cutoff, iters);
+  tester("TBBExecutor", merging::TBBExecutor(threads),
+	 lhs, rhs, reference, seq, cutoff, iters);
+  tester("ThreadPoolExecutor", merging::ThreadPoolExecutor(threads),
+	 lhs, rhs, reference, seq, cutoff, iters);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
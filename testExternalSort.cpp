@@ -0,0 +1,156 @@
+#include "ExternalSort.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <omp.h>
+
+/**
+ * Un enregistrement de taille fixe : une clé et une charge utile.
+ */
+struct Record {
+  uint64_t key;
+  uint64_t payload;
+};
+
+/**
+ * Ordre des enregistrements : celui de leurs clés.
+ */
+struct ParCle {
+  bool operator()(const Record& x, const Record& y) const {
+    return x.key < y.key;
+  }
+};
+
+/**
+ * Affiche le débit d'une phase du tri.
+ *
+ * @param[in] titre le titre de la phase.
+ * @param[in] octets le volume traité en octets.
+ * @param[in] duree la durée de la phase en secondes.
+ */
+void
+afficher(const std::string& titre, const size_t& octets, const double& duree) {
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << duree << " sec." << std::endl;
+  std::cout << "\tDébit:\t\t" << octets / duree / (1024 * 1024) << " Mio/s"
+	    << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " taille_Mio memoire_Mio" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction de la taille du fichier et de la mémoire allouée
+  // au tri.
+  size_t taille, memoire;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> taille;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::istringstream entree2(argv[2]);
+    entree2 >> memoire;
+    if (! entree2 || ! entree2.eof() || memoire == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Génération du fichier à trier dans le répertoire temporaire, par un
+  // générateur congruentiel (pour des résultats reproductibles). La somme
+  // des charges utiles permet de vérifier que le tri est une permutation.
+  const std::string input = "/tmp/testExternalSort.in";
+  const std::string output = "/tmp/testExternalSort.out";
+  const size_t n = taille * 1024 * 1024 / sizeof(Record);
+  uint64_t somme = 0;
+  {
+    std::ofstream fichier(input, std::ios::binary);
+    std::vector< Record > bloc(64 * 1024);
+    uint64_t graine = 12345;
+    for (size_t i = 0; i < n; i += bloc.size()) {
+      const size_t longueur = std::min(bloc.size(), n - i);
+      for (size_t j = 0; j != longueur; j ++) {
+	graine = graine * 6364136223846793005ull + 1442695040888963407ull;
+	bloc[j].key = graine >> 16;
+	bloc[j].payload = i + j;
+	somme += i + j;
+      }
+      fichier.write(reinterpret_cast< const char* >(bloc.data()),
+		    longueur * sizeof(Record));
+    }
+    if (! fichier) {
+      std::cerr << "Écriture de " << input << " impossible." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Le tri externe.
+  const int threads = omp_get_max_threads();
+  const sorting::ExternalSort::Report report =
+    sorting::ExternalSort::apply< Record >(input, output, ParCle(),
+					   memoire * 1024 * 1024, threads);
+  std::cout << "Thread(s):\t" << threads << std::endl;
+  std::cout << "Suites:\t\t" << report.runs << std::endl << std::endl;
+  afficher("runs", report.bytes, report.runTime);
+  afficher("merge", report.bytes, report.mergeTime);
+  afficher("total", report.bytes, report.runTime + report.mergeTime);
+
+  // Vérification du fichier trié.
+  bool verdict = true;
+  {
+    std::ifstream fichier(output, std::ios::binary);
+    std::vector< Record > bloc(64 * 1024);
+    uint64_t precedente = 0, controle = 0;
+    size_t lus = 0;
+    while (fichier) {
+      fichier.read(reinterpret_cast< char* >(bloc.data()),
+		   bloc.size() * sizeof(Record));
+      const size_t longueur = fichier.gcount() / sizeof(Record);
+      for (size_t j = 0; j != longueur; j ++) {
+	verdict = verdict && precedente <= bloc[j].key;
+	precedente = bloc[j].key;
+	controle += bloc[j].payload;
+      }
+      lus += longueur;
+    }
+    verdict = verdict && lus == n && controle == somme;
+  }
+  std::cout << "Verdict:\t" << std::boolalpha << verdict << std::endl;
+
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+
+  // Tout s'est bien passé.
+  return verdict ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
@@ -0,0 +1,183 @@
+#include "Histogram.hpp"
+#include "Count.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <list>
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+
+/**
+ * Routine d'évaluation des performances : un histogramme complet contre un
+ * appel à Count::apply par valeur distincte.
+ *
+ * @param[in] first le premier élément du conteneur.
+ * @param[in] last l'élément situé juste derrière le dernier élément du
+ *   conteneur.
+ * @param[in] cles les valeurs distinctes présentes dans le conteneur.
+ * @param[in] threads le nombre de threads utilisés.
+ * @param[in] titre le titre du benchmark.
+ * @param[in] iters le nombre d'itérations à effectuer sur le même algorithme
+ *   pour obtenir des mesures de temps conséquentes.
+ * @param[in] histogramme la version à évaluer, retournant un histogramme
+ *   indexable par les valeurs distinctes.
+ */
+template< typename InputIterator, typename Key, typename Algorithm >
+void
+tester(const InputIterator& first,
+       const InputIterator& last,
+       const std::vector< Key >& cles,
+       const int& threads,
+       const std::string& titre,
+       const size_t& iters,
+       const Algorithm& histogramme) {
+
+  using namespace paralgos;
+
+  // Les résultats de chaque version.
+  std::vector< typename std::iterator_traits< InputIterator >::
+               difference_type > resCount(cles.size());
+  decltype(histogramme(first, last)) resHisto;
+
+  // Durée d'exécution d'un appel à Count::apply par valeur distincte.
+  double seq;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      for (size_t k = 0; k != cles.size(); k ++) {
+        resCount[k] = Count::apply(first, last, cles[k]);
+      }
+    }
+    const double stop = omp_get_wtime();
+    seq = stop - start;
+  }
+
+  // Durée d'exécution de l'histogramme.
+  double par;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      resHisto = histogramme(first, last);
+    }
+    const double stop = omp_get_wtime();
+    par = stop - start;
+  }
+
+  // Vérification des résultats.
+  bool verdict = true;
+  for (size_t k = 0; k != cles.size(); k ++) {
+    verdict = verdict && resHisto[cles[k]] == resCount[k];
+  }
+
+  // Affichage des résultats.
+  std::cout << "--[ " << titre << ": begin ] --" << std::endl;
+  std::cout << "\tValeurs :\t\t" << cles.size() << std::endl;
+  std::cout << "\tDurée Count :\t\t" << seq << " sec." << std::endl;
+  std::cout << "\tDurée Histogram :\t" << par << " sec." << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "\tThread(s):\t\t" << threads << std::endl;
+  std::cout << "\tSpeedup:\t\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "--[ " << titre << ": end ] --" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  using paralgos::Histogram;
+
+  //  Nombre de threads utilisés.
+  const int threads = paralgos::ExecutionContext::standard().threads();
+
+  // Nombres d'éléments à traiter et de valeurs distinctes.
+  const int n = 1024 * 1021;
+  const int k = 48;
+
+  // Conteneurs manipulés : les mêmes valeurs sous forme d'entiers, d'entiers
+  // courts et de liste. Les valeurs du dernier tableau sont dispersées sur un
+  // large intervalle.
+  std::vector< int > tableau(n), disperse(n);
+  std::vector< short > courts(n);
+  std::list< int > liste;
+  for (int i = 0; i != n; i ++) {
+    tableau[i] = (i * 7) % k;
+    courts[i] = tableau[i];
+    disperse[i] = tableau[i] * 1000003;
+    liste.push_back(tableau[i]);
+  }
+  std::vector< int > cles(k), clesDispersees(k);
+  std::vector< short > clesCourtes(k);
+  for (int i = 0; i != k; i ++) {
+    cles[i] = i;
+    clesCourtes[i] = i;
+    clesDispersees[i] = i * 1000003;
+  }
+
+  // Premier test : compteurs denses, intervalle fourni.
+  typedef std::vector< int >::const_iterator Iterateur;
+  tester(tableau.cbegin(), tableau.cend(), cles, threads,
+         "vector<int> (dense)", iters,
+         [k](const Iterateur& first, const Iterateur& last) {
+           return Histogram::apply(first, last, 0, k - 1);
+         });
+
+  // Deuxième test : compteurs denses sur toutes les valeurs du type.
+  typedef std::vector< short >::const_iterator IterateurCourt;
+  tester(courts.cbegin(), courts.cend(), clesCourtes, threads,
+         "vector<short> (dense)", iters,
+         [](const IterateurCourt& first, const IterateurCourt& last) {
+           return Histogram::apply(first, last);
+         });
+
+  // Troisième test : compteurs hachés.
+  tester(disperse.cbegin(), disperse.cend(), clesDispersees, threads,
+         "vector<int> (haché)", iters,
+         [](const Iterateur& first, const Iterateur& last) {
+           return Histogram::apply(first, last);
+         });
+
+  // Quatrième test : la liste, compteurs hachés.
+  typedef std::list< int >::const_iterator IterateurListe;
+  tester(liste.cbegin(), liste.cend(), cles, threads,
+         "list (haché)", iters,
+         [](const IterateurListe& first, const IterateurListe& last) {
+           return Histogram::apply(first, last);
+         });
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
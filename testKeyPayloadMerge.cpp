@@ -0,0 +1,237 @@
+#include "KeyPayloadMerge.hpp"
+#include "ParallelRecursiveMerge.hpp"
+#include "ParallelStableMerge.hpp"
+#include "OpenMPExecutor.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+
+/**
+ * Charge d'un enregistrement : P octets, dont les premiers mémorisent le
+ * rang d'origine de l'enregistrement (pour vérifier la stabilité).
+ */
+template< size_t P >
+struct Charge {
+  char octets[P];
+};
+
+/**
+ * Un enregistrement : une clé de 8 octets et sa charge.
+ */
+template< size_t P >
+struct Enregistrement {
+  uint64_t cle;
+  Charge< P > charge;
+};
+
+/**
+ * Comparaison des enregistrements selon leur clé.
+ */
+struct ParCle {
+  template< size_t P >
+  bool operator()(const Enregistrement< P >& lhs,
+                  const Enregistrement< P >& rhs) const {
+    return lhs.cle < rhs.cle;
+  }
+};
+
+/**
+ * Mesure la durée d'exécution d'une fusion.
+ *
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] fusion la fusion.
+ * @return la durée d'exécution en secondes.
+ */
+template< typename Fusion >
+double
+mesurer(const size_t& iters, const Fusion& fusion) {
+  const double start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    fusion();
+  }
+  const double stop = omp_get_wtime();
+  return stop - start;
+}
+
+/**
+ * Affiche les performances de la fusion par clé comparées à celles de la
+ * fusion des enregistrements.
+ *
+ * @param[in] titre le titre du benchmark.
+ * @param[in] verdict @c true si les deux fusions donnent le même résultat.
+ * @param[in] aos la durée d'exécution de la fusion des enregistrements.
+ * @param[in] perm la durée d'exécution du calcul de la permutation seul.
+ * @param[in] soa la durée d'exécution de la fusion par clé.
+ */
+void
+afficher(const std::string& titre,
+         const bool& verdict,
+         const double& aos,
+         const double& perm,
+         const double& soa) {
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tDurée (AoS / permutation / SoA):\t" << aos << " / " << perm
+            << " / " << soa << " sec." << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "\tSpeedup (permutation / SoA):\t"
+            << Metrics::speedup(aos, perm) << " / "
+            << Metrics::speedup(aos, soa) << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Compare, pour une taille de charge, la fusion par clé de deux structures
+ * de tableaux à la fusion des structures d'enregistrements correspondantes,
+ * pour les deux fusions parallèles.
+ *
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] n le nombre d'enregistrements de chaque conteneur.
+ */
+template< size_t P >
+void
+tester(const size_t& iters, const size_t& n) {
+  typedef Enregistrement< P > Record;
+  const int threads = omp_get_max_threads();
+  const merging::OpenMPExecutor executor(threads);
+  const size_t cutoff = 8192;
+  const std::less< const uint64_t& > comp;
+
+  // Deux structures d'enregistrements aux clés ordonnées, comportant des
+  // doublons, et les structures de tableaux correspondantes.
+  uint64_t graine = 12345;
+  std::vector< Record > aos1(n), aos2(n), aos(2 * n);
+  std::vector< uint64_t > keys1(n), keys2(n), keys(2 * n);
+  std::vector< Charge< P > > payload1(n), payload2(n), payload(2 * n);
+  std::vector< uint32_t > perm(2 * n);
+  for (std::vector< Record >* v : { &aos1, &aos2 }) {
+    for (Record& x : *v) {
+      graine = graine * 6364136223846793005ull + 1442695040888963407ull;
+      x.cle = (graine >> 32) % n;
+    }
+    std::sort(v->begin(), v->end(), ParCle());
+  }
+  for (size_t i = 0; i != n; i ++) {
+    const uint64_t rangs[] = { i, n + i };
+    std::memset(aos1[i].charge.octets, 0, P);
+    std::memset(aos2[i].charge.octets, 0, P);
+    std::memcpy(aos1[i].charge.octets, &rangs[0], std::min(P, size_t(8)));
+    std::memcpy(aos2[i].charge.octets, &rangs[1], std::min(P, size_t(8)));
+    keys1[i] = aos1[i].cle;
+    keys2[i] = aos2[i].cle;
+    payload1[i] = aos1[i].charge;
+    payload2[i] = aos2[i].charge;
+  }
+
+  // Le résultat de la fusion par clé est-il celui de la fusion des
+  // enregistrements ?
+  const auto identiques = [&]() {
+    for (size_t i = 0; i != 2 * n; i ++) {
+      if (keys[i] != aos[i].cle
+          || std::memcmp(payload[i].octets, aos[i].charge.octets, P) != 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  std::cout << "==[ Charge de " << P << " octets ]==" << std::endl
+            << std::endl;
+
+  // Fusions récursives.
+  double tAos = mesurer(iters, [&]() {
+      merging::ParallelRecursiveMerge::apply(aos1.begin(), aos1.end(),
+                                             aos2.begin(), aos2.end(),
+                                             aos.begin(), ParCle(), cutoff,
+                                             executor);
+    });
+  double tPerm = mesurer(iters, [&]() {
+      merging::KeyPayloadMerge::permutation(keys1.begin(), keys1.end(),
+                                            keys2.begin(), keys2.end(),
+                                            perm.begin(), comp, cutoff,
+                                            executor);
+    });
+  double tSoa = mesurer(iters, [&]() {
+      merging::KeyPayloadMerge::apply(keys1.begin(), keys1.end(),
+                                      keys2.begin(), keys2.end(),
+                                      payload1.begin(), payload2.begin(),
+                                      keys.begin(), payload.begin(), comp,
+                                      cutoff, executor);
+    });
+  afficher("ParallelRecursiveMerge", identiques(), tAos, tPerm, tSoa);
+
+  // Fusions stables.
+  tAos = mesurer(iters, [&]() {
+      merging::ParallelStableMerge::apply(aos1.begin(), aos1.end(),
+                                          aos2.begin(), aos2.end(),
+                                          aos.begin(), ParCle(), executor);
+    });
+  tPerm = mesurer(iters, [&]() {
+      merging::KeyPayloadMerge::permutation(keys1.begin(), keys1.end(),
+                                            keys2.begin(), keys2.end(),
+                                            perm.begin(), comp, executor);
+    });
+  tSoa = mesurer(iters, [&]() {
+      merging::KeyPayloadMerge::apply(keys1.begin(), keys1.end(),
+                                      keys2.begin(), keys2.end(),
+                                      payload1.begin(), payload2.begin(),
+                                      keys.begin(), payload.begin(), comp,
+                                      executor);
+    });
+  afficher("ParallelStableMerge", identiques(), tAos, tPerm, tSoa);
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof() || iters == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Deux conteneurs de 1M enregistrements, pour des enregistrements de 16,
+  // 64 et 256 octets.
+  const size_t n = 1024 * 1024;
+  tester< 8 >(iters, n);
+  tester< 56 >(iters, n);
+  tester< 248 >(iters, n);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
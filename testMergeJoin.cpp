@@ -0,0 +1,197 @@
+#include "mergeJoin.hpp"
+#include "OpenMPExecutor.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <string>
+#include <utility>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <omp.h>
+
+/**
+ * Une ligne de la table de gauche.
+ */
+struct Commande {
+  uint32_t client;
+  uint32_t montant;
+};
+
+/**
+ * Une ligne de la table de droite.
+ */
+struct Adresse {
+  uint32_t client;
+  double latitude;
+  double longitude;
+};
+
+/**
+ * Comparaison des lignes des deux tables selon l'identifiant du client.
+ */
+struct ParClient {
+  template< typename Lhs, typename Rhs >
+  bool operator()(const Lhs& lhs, const Rhs& rhs) const {
+    return lhs.client < rhs.client;
+  }
+};
+
+typedef std::vector< Commande >::const_iterator Gauche;
+typedef std::vector< Adresse >::const_iterator Droite;
+typedef std::vector< std::pair< Gauche, Droite > > Paires;
+
+/**
+ * Jointure séquentielle de référence : pour chaque groupe de lignes de
+ * gauche de même client, parcours des lignes de droite correspondantes.
+ *
+ * @param[in] gauche la table de gauche, ordonnée.
+ * @param[in] droite la table de droite, ordonnée.
+ * @param[in] type le type de jointure.
+ * @return les paires de la jointure.
+ */
+Paires
+joindre(const std::vector< Commande >& gauche,
+        const std::vector< Adresse >& droite,
+        const merging::JoinType& type) {
+  Paires paires;
+  Droite d = droite.begin();
+  Gauche g = gauche.begin();
+  while (g != gauche.end()) {
+    const uint32_t client = g->client;
+    while (d != droite.end() && d->client < client) {
+      ++ d;
+    }
+    Droite fin = d;
+    while (fin != droite.end() && fin->client == client) {
+      ++ fin;
+    }
+    for (; g != gauche.end() && g->client == client; ++ g) {
+      if (d == fin) {
+        if (type == merging::LEFT_OUTER_JOIN) {
+          paires.push_back(std::make_pair(g, droite.end()));
+        }
+      } else {
+        for (Droite x = d; x != fin; ++ x) {
+          paires.push_back(std::make_pair(g, x));
+        }
+      }
+    }
+    d = fin;
+  }
+  return paires;
+}
+
+/**
+ * Compare la jointure parallèle à la jointure séquentielle de référence.
+ *
+ * @param[in] titre le titre du benchmark.
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] gauche la table de gauche, ordonnée.
+ * @param[in] droite la table de droite, ordonnée.
+ * @param[in] type le type de jointure.
+ */
+void
+tester(const std::string& titre,
+       const size_t& iters,
+       const std::vector< Commande >& gauche,
+       const std::vector< Adresse >& droite,
+       const merging::JoinType& type) {
+  const int threads = omp_get_max_threads();
+  const merging::OpenMPExecutor executor(threads);
+  Paires reference, resultat;
+
+  double start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    reference = joindre(gauche, droite, type);
+  }
+  double stop = omp_get_wtime();
+  const double seq = stop - start;
+
+  start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    resultat = merging::mergeJoin(gauche.cbegin(), gauche.cend(),
+                                  droite.cbegin(), droite.cend(),
+                                  ParClient(), type, executor);
+  }
+  stop = omp_get_wtime();
+  const double par = stop - start;
+
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tRésultat:\t" << resultat.size() << " paires" << std::endl;
+  std::cout << "\tDurée (seq. / par.):\t" << seq << " / " << par << " sec."
+            << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << (resultat == reference)
+            << std::endl;
+  std::cout << "\tSpeedup:\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "\tEfficiency:\t" << Metrics::efficiency(seq, par, threads)
+            << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof() || iters == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Deux tables de 10M lignes, dont les identifiants de clients sont tirés
+  // dans [0, 10M[ : environ un client sur trois n'a ni commande ni adresse,
+  // les autres en ont souvent plusieurs.
+  const size_t n = 10 * 1000 * 1000;
+  uint64_t graine = 12345;
+  std::vector< Commande > gauche(n);
+  std::vector< Adresse > droite(n);
+  for (Commande& c : gauche) {
+    graine = graine * 6364136223846793005ull + 1442695040888963407ull;
+    c.client = (graine >> 32) % n;
+    c.montant = graine & 0xFFFF;
+  }
+  for (Adresse& a : droite) {
+    graine = graine * 6364136223846793005ull + 1442695040888963407ull;
+    a.client = (graine >> 32) % n;
+    a.latitude = a.longitude = graine & 0xFFFF;
+  }
+  std::stable_sort(gauche.begin(), gauche.end(), ParClient());
+  std::stable_sort(droite.begin(), droite.end(), ParClient());
+
+  tester("Jointure interne", iters, gauche, droite, merging::INNER_JOIN);
+  tester("Jointure externe gauche", iters, gauche, droite,
+         merging::LEFT_OUTER_JOIN);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,224 @@
+#include "MergePlan.hpp"
+#include "ParallelStableMerge.hpp"
+#include "OpenMPExecutor.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cstdint>
+#include <omp.h>
+
+/**
+ * Un enregistrement : une clé et une charge utile.
+ */
+struct Record {
+  int key;
+  int payload;
+};
+
+bool
+operator==(const Record& x, const Record& y) {
+  return x.key == y.key && x.payload == y.payload;
+}
+
+/**
+ * Ordre des enregistrements : celui de leurs clés.
+ */
+struct ParCle {
+  bool operator()(const Record& x, const Record& y) const {
+    return x.key < y.key;
+  }
+};
+
+/**
+ * Affiche les durées d'exécution de ParallelStableMerge et d'un plan.
+ *
+ * @param[in] titre le titre du benchmark.
+ * @param[in] verdict @c true si les deux fusions donnent le même résultat.
+ * @param[in] sans la durée d'exécution de ParallelStableMerge.
+ * @param[in] avec la durée d'exécution du plan.
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] builds le nombre de calculs du plan.
+ */
+void
+afficher(const std::string& titre,
+         const bool& verdict,
+         const double& sans,
+         const double& avec,
+         const size_t& iters,
+         const size_t& builds) {
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tDurée par fusion (sans / avec plan):\t"
+            << sans / iters * 1e6 << " / " << avec / iters * 1e6 << " µs."
+            << std::endl;
+  std::cout << "\tGain:\t\t" << sans / avec << std::endl;
+  std::cout << "\tCalculs du plan:\t" << builds << " / " << iters << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Fusionne iters fois les deux mêmes conteneurs d'entiers, avec et sans
+ * plan.
+ *
+ * @param[in] taille la taille totale des deux conteneurs.
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] executor l'exécuteur.
+ */
+template< typename Executor >
+void
+tester(const size_t& taille, const size_t& iters, const Executor& executor) {
+  typedef std::vector< int > Tableau;
+  typedef std::less< const int& > Compare;
+  Tableau lhs(taille / 2), rhs(taille - lhs.size());
+  uint32_t graine = 12345;
+  for (int& x : lhs) {
+    graine = graine * 1664525u + 1013904223u;
+    x = graine >> 1;
+  }
+  for (int& x : rhs) {
+    graine = graine * 1664525u + 1013904223u;
+    x = graine >> 1;
+  }
+  std::sort(lhs.begin(), lhs.end());
+  std::sort(rhs.begin(), rhs.end());
+
+  Tableau reference(taille), result(taille);
+  double start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    merging::ParallelStableMerge::apply(lhs.begin(), lhs.end(),
+                                        rhs.begin(), rhs.end(),
+                                        reference.begin(), Compare(),
+                                        executor);
+  }
+  const double sans = omp_get_wtime() - start;
+
+  merging::MergePlan< Tableau::const_iterator,
+                      Tableau::const_iterator,
+                      Compare > plan;
+  start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    plan.apply(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(),
+               result.begin(), executor);
+  }
+  const double avec = omp_get_wtime() - start;
+
+  afficher(std::to_string(taille) + " entiers", result == reference,
+           sans, avec, iters, plan.builds());
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof() || iters == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const int threads = omp_get_max_threads();
+  const merging::OpenMPExecutor executor(threads);
+  std::cout << "Thread(s):\t" << threads << std::endl << std::endl;
+
+  // Les mêmes conteneurs, fusionnés de manière répétée : le gain est
+  // d'autant plus grand que les conteneurs sont petits.
+  for (size_t taille = 4 * 1024; taille <= 16 * 1024 * 1024; taille *= 16) {
+    tester(taille, iters, executor);
+  }
+
+  // Un pipeline incrémental : les clés restent les mêmes, seules les
+  // charges utiles changent d'une fusion à l'autre (hors mesure).
+  typedef std::vector< Record > Enregistrements;
+  Enregistrements lhs(32 * 1024), rhs(32 * 1024 + 211);
+  for (size_t i = 0; i != lhs.size(); i ++) {
+    lhs[i].key = 3 * i;
+  }
+  for (size_t i = 0; i != rhs.size(); i ++) {
+    rhs[i].key = 2 * i;
+  }
+  Enregistrements reference(lhs.size() + rhs.size());
+  Enregistrements result(reference.size());
+  merging::MergePlan< Enregistrements::iterator,
+                      Enregistrements::iterator,
+                      ParCle > plan;
+  double sans = 0, avec = 0;
+  bool verdict = true;
+  for (size_t i = 0; i != iters; i ++) {
+    for (Record& x : lhs) {
+      x.payload = x.key + i;
+    }
+    for (Record& x : rhs) {
+      x.payload = x.key - i;
+    }
+    double start = omp_get_wtime();
+    merging::ParallelStableMerge::apply(lhs.begin(), lhs.end(),
+                                        rhs.begin(), rhs.end(),
+                                        reference.begin(), ParCle(),
+                                        executor);
+    sans += omp_get_wtime() - start;
+    start = omp_get_wtime();
+    plan.apply(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+               result.begin(), executor);
+    avec += omp_get_wtime() - start;
+    verdict = verdict && result == reference;
+  }
+  afficher("charges utiles modifiées", verdict, sans, avec, iters,
+           plan.builds());
+
+  // Les clés changent elles aussi : le plan est recalculé lorsque ses points
+  // de partage ne sont plus valides.
+  const size_t avant = plan.builds();
+  sans = avec = 0;
+  for (size_t i = 0; i != iters; i ++) {
+    for (Record& x : rhs) {
+      x.key += i % 2 ? 1 : 7;
+    }
+    double start = omp_get_wtime();
+    merging::ParallelStableMerge::apply(lhs.begin(), lhs.end(),
+                                        rhs.begin(), rhs.end(),
+                                        reference.begin(), ParCle(),
+                                        executor);
+    sans += omp_get_wtime() - start;
+    start = omp_get_wtime();
+    plan.apply(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+               result.begin(), executor);
+    avec += omp_get_wtime() - start;
+    verdict = verdict && result == reference;
+  }
+  afficher("clés modifiées", verdict, sans, avec, iters,
+           plan.builds() - avant);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
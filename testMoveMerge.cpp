@@ -0,0 +1,271 @@
+#include "recursiveMerge.hpp"
+#include "ParallelRecursiveMerge.hpp"
+#include "ParallelStableMerge.hpp"
+#include "OpenMPExecutor.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+
+/**
+ * Le nombre d'allocations dynamiques effectuées par le programme.
+ */
+static std::atomic< size_t > allocations(0);
+
+// Les opérateurs de remplacement ci-dessous reposent sur malloc et free :
+// GCC (11 et suivants) ne reconnaît pas la paire et signale à tort chaque
+// free d'un bloc alloué par new.
+#if defined(__GNUC__) && ! defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+/**
+ * Opérateur new global, instrumenté pour compter les allocations.
+ */
+void*
+operator new(size_t size) {
+  allocations ++;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (! p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+/**
+ * Opérateur delete global, associé à l'opérateur new ci-dessus.
+ */
+void
+operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+/**
+ * Opérateur delete global dimensionné, associé à l'opérateur new ci-dessus.
+ */
+void
+operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+#if defined(__GNUC__) && ! defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * Une structure de 256 octets : une clé et une charge utile.
+ */
+struct Gros {
+  uint64_t cle;
+  char charge[248];
+};
+
+bool
+operator==(const Gros& x, const Gros& y) {
+  return x.cle == y.cle && std::memcmp(x.charge, y.charge, sizeof(x.charge)) == 0;
+}
+
+/**
+ * Ordre des structures : celui de leurs clés.
+ */
+struct Inferieur {
+  bool operator()(const Gros& x, const Gros& y) const {
+    return x.cle < y.cle;
+  }
+};
+
+/**
+ * Mesure la durée d'exécution et le nombre d'allocations d'une fusion, les
+ * conteneurs sources étant restaurés (hors mesure) avant chaque itération
+ * puisqu'une fusion par déplacement les consomme.
+ *
+ * @param[in] titre le titre du benchmark.
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] lhs le premier conteneur ordonné.
+ * @param[in] rhs le second conteneur ordonné.
+ * @param[in] reference le résultat de l'algorithme merge.
+ * @param[in] fusion la fusion, paramétrée par les deux conteneurs sources et
+ *   le conteneur cible.
+ */
+template< typename T, typename Merge >
+void
+mesurer(const std::string& titre,
+        const size_t& iters,
+        const std::vector< T >& lhs,
+        const std::vector< T >& rhs,
+        const std::vector< T >& reference,
+        const Merge& fusion) {
+  double duree = 0;
+  size_t allocs = 0;
+  std::vector< T > a, b, c;
+  for (size_t i = 0; i != iters; i ++) {
+    a = lhs;
+    b = rhs;
+    std::vector< T >(reference.size()).swap(c);
+    const size_t avant = allocations;
+    const double start = omp_get_wtime();
+    fusion(a, b, c);
+    const double stop = omp_get_wtime();
+    allocs += allocations - avant;
+    duree += stop - start;
+  }
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << duree << " sec." << std::endl;
+  std::cout << "\tAllocations:\t" << allocs / iters << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << (c == reference)
+            << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Compare fusions par recopie et par déplacement pour un type d'éléments.
+ *
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] lhs le premier conteneur ordonné.
+ * @param[in] rhs le second conteneur ordonné.
+ * @param[in] comp l'ordre strict des éléments.
+ */
+template< typename T, typename Compare >
+void
+tester(const size_t& iters,
+       const std::vector< T >& lhs,
+       const std::vector< T >& rhs,
+       const Compare& comp) {
+  typedef std::vector< T > Tableau;
+  const size_t cutoff = 8 * 1024;
+  const merging::OpenMPExecutor executor(omp_get_max_threads());
+
+  Tableau reference(lhs.size() + rhs.size());
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+             reference.begin(), comp);
+
+  mesurer("recursiveMerge", iters, lhs, rhs, reference,
+          [&](Tableau& a, Tableau& b, Tableau& c) {
+            merging::recursiveMerge(a.begin(), a.end(), b.begin(), b.end(),
+                                    c.begin(), comp, cutoff);
+          });
+  mesurer("recursiveMoveMerge", iters, lhs, rhs, reference,
+          [&](Tableau& a, Tableau& b, Tableau& c) {
+            merging::recursiveMoveMerge(a.begin(), a.end(),
+                                        b.begin(), b.end(),
+                                        c.begin(), comp, cutoff);
+          });
+  mesurer("ParallelRecursiveMerge::apply", iters, lhs, rhs, reference,
+          [&](Tableau& a, Tableau& b, Tableau& c) {
+            merging::ParallelRecursiveMerge::apply(a.begin(), a.end(),
+                                                   b.begin(), b.end(),
+                                                   c.begin(), comp, cutoff,
+                                                   executor);
+          });
+  mesurer("ParallelRecursiveMerge::applyMove", iters, lhs, rhs, reference,
+          [&](Tableau& a, Tableau& b, Tableau& c) {
+            merging::ParallelRecursiveMerge::applyMove(a.begin(), a.end(),
+                                                       b.begin(), b.end(),
+                                                       c.begin(), comp,
+                                                       cutoff, executor);
+          });
+  mesurer("ParallelStableMerge::apply", iters, lhs, rhs, reference,
+          [&](Tableau& a, Tableau& b, Tableau& c) {
+            merging::ParallelStableMerge::apply(a.begin(), a.end(),
+                                                b.begin(), b.end(),
+                                                c.begin(), comp, executor);
+          });
+  mesurer("ParallelStableMerge::applyMove", iters, lhs, rhs, reference,
+          [&](Tableau& a, Tableau& b, Tableau& c) {
+            merging::ParallelStableMerge::applyMove(a.begin(), a.end(),
+                                                    b.begin(), b.end(),
+                                                    c.begin(), comp,
+                                                    executor);
+          });
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof() || iters == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Les éléments des conteneurs sont tirés par un générateur congruentiel
+  // (pour des résultats reproductibles).
+  const size_t m = 512 * 1024, n = m + 211;
+  uint32_t graine = 12345;
+
+  // Chaînes trop longues pour l'optimisation des petites chaînes : chaque
+  // recopie alloue.
+  {
+    std::vector< std::string > lhs(m), rhs(n);
+    for (std::string& x : lhs) {
+      graine = graine * 1664525u + 1013904223u;
+      x = std::to_string(graine) + std::string(40, '*');
+    }
+    for (std::string& x : rhs) {
+      graine = graine * 1664525u + 1013904223u;
+      x = std::to_string(graine) + std::string(40, '*');
+    }
+    std::sort(lhs.begin(), lhs.end());
+    std::sort(rhs.begin(), rhs.end());
+    std::cout << "==[ std::string ]==" << std::endl << std::endl;
+    tester(iters, lhs, rhs, std::less< const std::string& >());
+  }
+
+  // Structures de 256 octets : déplacer revient à recopier.
+  {
+    std::vector< Gros > lhs(m), rhs(n);
+    for (Gros& x : lhs) {
+      graine = graine * 1664525u + 1013904223u;
+      x.cle = graine;
+      std::memset(x.charge, graine & 0xFF, sizeof(x.charge));
+    }
+    for (Gros& x : rhs) {
+      graine = graine * 1664525u + 1013904223u;
+      x.cle = graine;
+      std::memset(x.charge, graine & 0xFF, sizeof(x.charge));
+    }
+    std::sort(lhs.begin(), lhs.end(), Inferieur());
+    std::sort(rhs.begin(), rhs.end(), Inferieur());
+    std::cout << "==[ Gros (256 octets) ]==" << std::endl << std::endl;
+    tester(iters, lhs, rhs, Inferieur());
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
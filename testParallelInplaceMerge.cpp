@@ -0,0 +1,160 @@
+#include "ParallelInplaceMerge.hpp"
+#include "ParallelRecursiveMerge.hpp"
+#include "OpenMPExecutor.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+
+/**
+ * Affiche les performances et l'empreinte mémoire d'une fusion.
+ *
+ * @param[in] titre le titre du benchmark.
+ * @param[in] verdict @c true si le résultat est celui de l'algorithme merge.
+ * @param[in] seq la durée d'exécution de l'algorithme inplace_merge.
+ * @param[in] par la durée d'exécution de la fusion évaluée.
+ * @param[in] threads le nombre de threads utilisés.
+ * @param[in] octets la mémoire supplémentaire requise par la fusion.
+ */
+void
+afficher(const std::string& titre,
+	 const bool& verdict,
+	 const double& seq,
+	 const double& par,
+	 const int& threads,
+	 const size_t& octets) {
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tDurée:\t\t" << par << " sec." << std::endl;
+  std::cout << "\tMémoire:\t" << octets / 1024 << " Kio" << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "\tSpeedup:\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "\tEfficiency:\t"
+	    << Metrics::efficiency(seq, par, threads)
+	    << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Synonyme du type des éléments à fusionner.
+  typedef int Type;
+  const auto comp = std::less< const Type& >();
+
+  // Deux suites ordonnées adjacentes de tailles différentes, remplies par un
+  // générateur congruentiel (pour des résultats reproductibles). Les fusions
+  // sur place écrasant leur entrée, elle est restaurée avant chaque
+  // itération (hors chronométrage).
+  const size_t m = 8 * 1024 * 1024, n = m + 211;
+  std::vector< Type > entree(m + n);
+  uint32_t graine = 12345;
+  for (Type& x : entree) {
+    graine = graine * 1664525u + 1013904223u;
+    x = graine >> 1;
+  }
+  std::sort(entree.begin(), entree.begin() + m);
+  std::sort(entree.begin() + m, entree.end());
+
+  // Le résultat attendu, calculé par l'algorithme merge.
+  std::vector< Type > reference(m + n);
+  std::merge(entree.begin(), entree.begin() + m,
+	     entree.begin() + m, entree.end(),
+	     reference.begin(), comp);
+
+  std::vector< Type > data(m + n);
+  const int threads = omp_get_max_threads();
+  const merging::OpenMPExecutor executor(threads);
+
+  // Durée d'exécution de l'algorithme inplace_merge de la bibliothèque
+  // standard, dont le tampon temporaire compte min(m, n) éléments (à
+  // défaut, il fusionne par rotations en O(n log n)).
+  double seq = 0;
+  for (size_t i = 0; i != iters; i ++) {
+    data = entree;
+    const double start = omp_get_wtime();
+    std::inplace_merge(data.begin(), data.begin() + m, data.end(), comp);
+    const double stop = omp_get_wtime();
+    seq += stop - start;
+  }
+  afficher("inplace_merge", data == reference, seq, seq, 1,
+	   std::min(m, n) * sizeof(Type));
+
+  // Durée d'exécution de la fusion parallèle hors place, qui requiert un
+  // conteneur cible de m + n éléments.
+  double recursive = 0;
+  for (size_t i = 0; i != iters; i ++) {
+    std::fill(data.begin(), data.end(), 0);
+    const double start = omp_get_wtime();
+    merging::ParallelRecursiveMerge::apply(entree.begin(),
+					   entree.begin() + m,
+					   entree.begin() + m,
+					   entree.end(),
+					   data.begin(),
+					   comp,
+					   64 * 1024,
+					   executor);
+    const double stop = omp_get_wtime();
+    recursive += stop - start;
+  }
+  afficher("ParallelRecursiveMerge", data == reference, seq, recursive,
+	   threads, (m + n) * sizeof(Type));
+
+  // Durée d'exécution de la fusion parallèle sur place, dont le tampon
+  // compte ceil(sqrt(m + n)) éléments.
+  double inplace = 0;
+  for (size_t i = 0; i != iters; i ++) {
+    data = entree;
+    const double start = omp_get_wtime();
+    merging::ParallelInplaceMerge::apply(data.begin(),
+					 data.begin() + m,
+					 data.end(),
+					 comp,
+					 executor);
+    const double stop = omp_get_wtime();
+    inplace += stop - start;
+  }
+  afficher("ParallelInplaceMerge", data == reference, seq, inplace,
+	   threads, merging::ParallelInplaceMerge::buffer(m + n) * sizeof(Type));
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
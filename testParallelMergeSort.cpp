@@ -0,0 +1,152 @@
+#include "ParallelMergeSort.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+
+/**
+ * Mesure la durée d'exécution d'un tri : chaque itération recopie le tableau
+ * non trié avant de le trier.
+ *
+ * @param[in] source le tableau non trié.
+ * @param[out] tableau le tableau trié.
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] tri le tri, invoqué avec les bornes du tableau.
+ * @return la durée d'exécution en secondes.
+ */
+template< typename Type, typename Sort >
+double
+mesurer(const std::vector< Type >& source,
+	std::vector< Type >& tableau,
+	const size_t& iters,
+	const Sort& tri) {
+  const double start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    std::copy(source.begin(), source.end(), tableau.begin());
+    tri(tableau.begin(), tableau.end());
+  }
+  const double stop = omp_get_wtime();
+  return stop - start;
+}
+
+/**
+ * Affiche les performances d'un tri.
+ *
+ * @param[in] titre le titre du benchmark.
+ * @param[in] tableau le tableau trié.
+ * @param[in] seq la durée d'exécution de la version de référence.
+ * @param[in] par la durée d'exécution de la version évaluée.
+ * @param[in] threads le nombre de threads utilisés.
+ */
+template< typename Type >
+void
+afficher(const std::string& titre,
+	 const std::vector< Type >& tableau,
+	 const double& seq,
+	 const double& par,
+	 const int& threads) {
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tDurée:\t\t" << par << " sec." << std::endl;
+  std::cout << "\tVerdict:\t\t"
+	    << std::boolalpha
+	    << std::is_sorted(tableau.begin(), tableau.end())
+	    << std::endl;
+  std::cout << "\tSpeedup:\t"
+	    << Metrics::speedup(seq, par)
+	    << std::endl;
+  std::cout << "\tEfficiency:\t"
+	    << Metrics::efficiency(seq, par, threads)
+	    << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Synonyme du type des éléments à trier.
+  typedef int Type;
+  typedef std::vector< Type >::iterator Iterateur;
+
+  // Le tableau à trier, rempli par un générateur congruentiel (pour des
+  // résultats reproductibles), et le tableau trié.
+  std::vector< Type > source(4 * 1024 * 1024), tableau(source.size());
+  uint32_t graine = 12345;
+  for (size_t i = 0; i != source.size(); i ++) {
+    graine = graine * 1664525u + 1013904223u;
+    source[i] = graine >> 1;
+  }
+
+  // Durées d'exécution des algorithmes sort et stable_sort de la bibliothèque
+  // standard.
+  const double seq =
+    mesurer(source, tableau, iters,
+	    [](const Iterateur& first, const Iterateur& last) {
+	      std::sort(first, last);
+	    });
+  afficher("sort", tableau, seq, seq, 1);
+  const double stable =
+    mesurer(source, tableau, iters,
+	    [](const Iterateur& first, const Iterateur& last) {
+	      std::stable_sort(first, last);
+	    });
+  afficher("stable_sort", tableau, seq, stable, 1);
+
+  // Durées d'exécution de l'algorithme ParallelMergeSort. Nous allons
+  // utiliser plusieurs valeurs du nombre de threads disponibles.
+  const size_t leaf = 16 * 1024;
+  const size_t cutoff = 8 * 1024;
+  const int threads = omp_get_max_threads();
+  for (int nb = 1; nb <= threads; nb ++) {
+    const double par =
+      mesurer(source, tableau, iters,
+	      [nb, leaf, cutoff](const Iterateur& first,
+				 const Iterateur& last) {
+		sorting::ParallelMergeSort::apply(first, last,
+						  leaf, cutoff, nb);
+	      });
+    afficher("ParallelMergeSort / sort", tableau, seq, par, nb);
+    afficher("ParallelMergeSort / stable_sort", tableau, stable, par, nb);
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
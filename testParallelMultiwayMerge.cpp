@@ -0,0 +1,160 @@
+#include "ParallelMultiwayMerge.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+
+/**
+ * Fusion de k conteneurs ordonnés par un arbre de fusions deux à deux via
+ * l'algorithme merge de la bibliothèque standard : log2(k) passes sur les
+ * données.
+ *
+ * @param[in] runs les conteneurs à fusionner, stockés bout à bout.
+ * @param[in] bornes les rangs délimitant les conteneurs (k + 1 rangs).
+ * @param[out] result le résultat de la fusion.
+ * @param[in, out] tampon un tampon de même taille que le résultat.
+ */
+template< typename Type >
+void
+arbreDeFusions(const std::vector< Type >& runs,
+	       std::vector< size_t > bornes,
+	       std::vector< Type >& result,
+	       std::vector< Type >& tampon) {
+  std::copy(runs.begin(), runs.end(), result.begin());
+  while (bornes.size() > 2) {
+    std::vector< size_t > suivantes;
+    for (size_t s = 0; s + 1 < bornes.size(); s += 2) {
+      const size_t fin = s + 2 < bornes.size() ? bornes[s + 2] : bornes[s + 1];
+      std::merge(result.begin() + bornes[s],
+		 result.begin() + bornes[s + 1],
+		 result.begin() + bornes[s + 1],
+		 result.begin() + fin,
+		 tampon.begin() + bornes[s]);
+      suivantes.push_back(bornes[s]);
+    }
+    suivantes.push_back(bornes.back());
+    bornes.swap(suivantes);
+    result.swap(tampon);
+  }
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Synonymes des types manipulés.
+  typedef int Type;
+  typedef std::vector< Type >::const_iterator Iterateur;
+
+  // Nombre total d'éléments et nombre de threads disponibles.
+  const size_t n = 4 * 1024 * 1024;
+  const int threads = omp_get_max_threads();
+
+  for (size_t k = 4; k <= 256; k *= 4) {
+
+    // Les k conteneurs ordonnés, de tailles inégales, stockés bout à bout
+    // (générateur congruentiel, pour des résultats reproductibles).
+    std::vector< Type > runs(n);
+    std::vector< size_t > bornes(1, 0);
+    uint32_t graine = 12345;
+    for (size_t s = 0; s != k; s ++) {
+      const size_t fin = s + 1 == k ? n : n / k * (s + 1) + (s % 3) * 17;
+      for (size_t i = bornes.back(); i != fin; i ++) {
+	graine = graine * 1664525u + 1013904223u;
+	runs[i] = (graine >> 8) % (n / 4);
+      }
+      std::sort(runs.begin() + bornes.back(), runs.begin() + fin);
+      bornes.push_back(fin);
+    }
+    std::vector< std::pair< Iterateur, Iterateur > > sequences(k);
+    for (size_t s = 0; s != k; s ++) {
+      sequences[s].first = runs.cbegin() + bornes[s];
+      sequences[s].second = runs.cbegin() + bornes[s + 1];
+    }
+
+    // Durée d'exécution de l'arbre de fusions deux à deux.
+    std::vector< Type > reference(n), tampon(n);
+    double seq;
+    {
+      const double start = omp_get_wtime();
+      for (size_t i = 0; i != iters; i ++) {
+	arbreDeFusions(runs, bornes, reference, tampon);
+      }
+      const double stop = omp_get_wtime();
+      seq = stop - start;
+    }
+
+    // Durée d'exécution de notre version parallèle.
+    std::vector< Type > result(n);
+    double par;
+    {
+      const double start = omp_get_wtime();
+      for (size_t i = 0; i != iters; i ++) {
+	merging::ParallelMultiwayMerge::apply(sequences,
+					      result.begin(),
+					      threads);
+      }
+      const double stop = omp_get_wtime();
+      par = stop - start;
+    }
+
+    // Affichage des performances de notre version parallèle.
+    std::cout << "--[ ParallelMultiwayMerge(" << k << "): begin ]--"
+	      << std::endl;
+    std::cout << "\tThread(s):\t" << threads << std::endl;
+    std::cout << "\tDurée merge:\t" << seq << " sec." << std::endl;
+    std::cout << "\tDurée:\t\t" << par << " sec." << std::endl;
+    std::cout << "\tVerdict:\t\t"
+	      << std::boolalpha
+	      << (result == reference)
+	      << std::endl;
+    std::cout << "\tSpeedup:\t"
+	      << Metrics::speedup(seq, par)
+	      << std::endl;
+    std::cout << "\tEfficiency:\t"
+	      << Metrics::efficiency(seq, par, threads)
+	      << std::endl;
+    std::cout << "--[ ParallelMultiwayMerge(" << k << "): end ]--"
+	      << std::endl;
+    std::cout << std::endl;
+
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -81,6 +81,40 @@ main(int argc, char* argv[]) {
   std::cout << "--[ merge: end ]--" << std::endl;
   std::cout << std::endl;
 
+  // Durée d'exécution du noyau vectoriel utilisé comme feuille de la fusion
+  // récursive.
+  double vec;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::BitonicMerge::merge(lhs.begin(),
+				   lhs.end(),
+				   rhs.begin(),
+				   rhs.end(),
+				   result.begin(),
+				   comp);
+    }
+    const double stop = omp_get_wtime();
+    vec = stop - start;
+  }
+
+  // Affichage des performances du noyau vectoriel.
+  std::cout << "--[ BitonicMerge("
+	    << paralgos::SimdCount::name(paralgos::SimdCount::isa())
+	    << "): begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << vec << " sec." << std::endl;
+  std::cout << "\tVerdict:\t\t"
+	    << std::boolalpha
+	    << std::is_sorted(result.begin(), result.end(), comp)
+	    << std::endl;
+  std::cout << "\tSpeedup:\t"
+	    << Metrics::speedup(seq, vec)
+	    << std::endl;
+  std::cout << "--[ BitonicMerge("
+	    << paralgos::SimdCount::name(paralgos::SimdCount::isa())
+	    << "): end ]--" << std::endl;
+  std::cout << std::endl;
+
   // Obtention du nombre de threads disponibles.
   int threads;
 #pragma omp parallel
@@ -0,0 +1,279 @@
+#include "ParallelRecursiveMerge.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+
+/**
+ * Accès au partage des sous-conteneurs de ParallelRecursiveMerge.
+ */
+struct Strategies : public merging::ParallelRecursiveMerge {
+  using merging::ParallelRecursiveMerge::split;
+};
+
+/**
+ * Un enregistrement : une clé et le rang de l'enregistrement dans son
+ * conteneur d'origine, afin de vérifier la stabilité de la fusion.
+ */
+struct Record {
+  int key;
+  int rang;
+};
+
+bool
+operator==(const Record& x, const Record& y) {
+  return x.key == y.key && x.rang == y.rang;
+}
+
+/**
+ * Générateur congruentiel (pour des résultats reproductibles).
+ */
+struct Generateur {
+
+  explicit Generateur(const uint32_t& graine)
+    : graine_(graine) {
+  }
+
+  /** @return un entier pseudo-aléatoire de 31 bits. */
+  int operator()() {
+    graine_ = graine_ * 1664525u + 1013904223u;
+    return graine_ >> 1;
+  }
+
+  /** @return un réel pseudo-aléatoire de [0, 1[. */
+  double uniforme() {
+    return (*this)() / 2147483648.;
+  }
+
+  uint32_t graine_;
+
+};
+
+/**
+ * Tire n clés selon une loi de Zipf d'exposant s sur k clés (la clé 0 étant
+ * la plus fréquente), par inversion de la fonction de répartition.
+ */
+std::vector< int >
+zipf(const size_t& n, const int& k, const double& s, Generateur& gen) {
+  std::vector< double > repartition(k);
+  double somme = 0;
+  for (int i = 0; i != k; i ++) {
+    somme += 1. / std::pow(i + 1., s);
+    repartition[i] = somme;
+  }
+  std::vector< int > cles(n);
+  for (int& x : cles) {
+    const double u = gen.uniforme() * somme;
+    x = std::lower_bound(repartition.begin(), repartition.end(), u)
+      - repartition.begin();
+  }
+  return cles;
+}
+
+/**
+ * Taille maximale des fusions d'un niveau de la récursion.
+ *
+ * @param[in] a le premier conteneur ordonné.
+ * @param[in] m sa taille.
+ * @param[in] b le second conteneur ordonné.
+ * @param[in] n sa taille.
+ * @param[in] niveau le niveau de récursion (0 pour la fusion initiale).
+ * @param[in] partage le partage évalué, paramétré par les deux
+ *   sous-conteneurs et renvoyant les deux points de partage.
+ * @return la taille de la plus grande fusion de ce niveau.
+ */
+template< typename Split >
+size_t
+charge(const int* a, const size_t& m, const int* b, const size_t& n,
+       const int& niveau, const Split& partage) {
+  if (niveau == 0 || m + n < 2) {
+    return m + n;
+  }
+  const std::pair< const int*, const int* > p = partage(a, m, b, n);
+  const size_t j = p.first - a, k = p.second - b;
+  return std::max(charge(a, j, b, k, niveau - 1, partage),
+                  charge(a + j, m - j, b + k, n - k, niveau - 1, partage));
+}
+
+/**
+ * Partage de l'implémentation initiale : élément médian du plus long
+ * sous-conteneur et sa position (lower_bound) dans l'autre.
+ */
+std::pair< const int*, const int* >
+partageMedian(const int* a, const size_t& m, const int* b, const size_t& n) {
+  if (m < n) {
+    const std::pair< const int*, const int* > p = partageMedian(b, n, a, m);
+    return std::make_pair(p.second, p.first);
+  }
+  const int* const milieu = a + m / 2 + m % 2;
+  const int* const pivot = std::lower_bound(b, b + n, *milieu);
+
+  // L'élément médian revient à la seconde fusion.
+  return std::make_pair(milieu, pivot);
+}
+
+/**
+ * Partage tenant compte des suites de clés égales.
+ */
+std::pair< const int*, const int* >
+partageEgaux(const int* a, const size_t& m, const int* b, const size_t& n) {
+  return Strategies::split(a, a + m, b, b + n, std::less< const int& >());
+}
+
+/**
+ * Évalue l'équilibre et la durée de la fusion sur une distribution.
+ *
+ * @param[in] titre le nom de la distribution.
+ * @param[in] lhs le premier conteneur (non ordonné).
+ * @param[in] rhs le second conteneur (non ordonné).
+ * @param[in] iters le nombre d'itérations.
+ */
+void
+tester(const std::string& titre,
+       std::vector< int > lhs,
+       std::vector< int > rhs,
+       const size_t& iters) {
+
+  std::sort(lhs.begin(), lhs.end());
+  std::sort(rhs.begin(), rhs.end());
+  const size_t m = lhs.size(), n = rhs.size();
+  const size_t cutoff = 64 * 1024;
+  const int threads = omp_get_max_threads();
+
+  // Équilibre des 16 fusions du quatrième niveau de récursion : taille de la
+  // plus grande, rapportée à la taille idéale (m + n) / 16.
+  const int niveau = 4;
+  const double ideal = (m + n) / double(1 << niveau);
+  const double median =
+    charge(lhs.data(), m, rhs.data(), n, niveau, partageMedian) / ideal;
+  const double egaux =
+    charge(lhs.data(), m, rhs.data(), n, niveau, partageEgaux) / ideal;
+
+  // Durées d'exécution de l'algorithme merge et de la fusion parallèle.
+  std::vector< int > reference(m + n), result(m + n);
+  double seq, par;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                 reference.begin());
+    }
+    const double stop = omp_get_wtime();
+    seq = stop - start;
+  }
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::ParallelRecursiveMerge::apply(lhs.begin(), lhs.end(),
+                                             rhs.begin(), rhs.end(),
+                                             result.begin(), cutoff);
+    }
+    const double stop = omp_get_wtime();
+    par = stop - start;
+  }
+
+  // Stabilité : fusion d'enregistrements portant les mêmes clés.
+  std::vector< Record > a(m), b(n), stable(m + n), attendu(m + n);
+  for (size_t i = 0; i != m; i ++) {
+    a[i].key = lhs[i];
+    a[i].rang = i;
+  }
+  for (size_t i = 0; i != n; i ++) {
+    b[i].key = rhs[i];
+    b[i].rang = -1 - int(i);
+  }
+  const auto parCle = [](const Record& x, const Record& y) {
+    return x.key < y.key;
+  };
+  std::merge(a.begin(), a.end(), b.begin(), b.end(), attendu.begin(), parCle);
+  merging::ParallelRecursiveMerge::apply(a.begin(), a.end(),
+                                         b.begin(), b.end(),
+                                         stable.begin(), parCle, cutoff);
+
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tCharge max. au niveau " << niveau
+            << " (médiane / doublons):\t" << median << " / " << egaux
+            << std::endl;
+  std::cout << "\tDurée:\t\t" << par << " sec." << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << (result == reference)
+            << std::endl;
+  std::cout << "\tStable:\t\t" << std::boolalpha << (stable == attendu)
+            << std::endl;
+  std::cout << "\tSpeedup:\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "\tEfficiency:\t" << Metrics::efficiency(seq, par, threads)
+            << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Deux conteneurs de tailles différentes, pour chaque distribution.
+  const size_t m = 4 * 1024 * 1024, n = m / 2 + 211;
+  Generateur gen(12345);
+  std::vector< int > lhs(m), rhs(n);
+
+  // Clés distinctes (ou presque) : la situation nominale.
+  for (int& x : lhs) x = gen();
+  for (int& x : rhs) x = gen();
+  tester("uniforme", lhs, rhs, iters);
+
+  // Faible cardinalité : 4 puis 1 clé(s).
+  for (int& x : lhs) x = gen() % 4;
+  for (int& x : rhs) x = gen() % 4;
+  tester("4 clés", lhs, rhs, iters);
+  std::fill(lhs.begin(), lhs.end(), 7);
+  std::fill(rhs.begin(), rhs.end(), 7);
+  tester("1 clé", lhs, rhs, iters);
+
+  // Loi de Zipf sur un million de clés.
+  tester("Zipf (s = 1.2)", zipf(m, 1000000, 1.2, gen),
+         zipf(n, 1000000, 1.2, gen), iters);
+  tester("Zipf (s = 2)", zipf(m, 1000000, 2., gen),
+         zipf(n, 1000000, 2., gen), iters);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
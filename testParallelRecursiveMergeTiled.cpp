@@ -0,0 +1,188 @@
+#include "ParallelRecursiveMerge.hpp"
+#include "OpenMPExecutor.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstdint>
+
+/**
+ * Accès aux stratégies de parallélisation de ParallelRecursiveMerge.
+ */
+struct Strategies : public merging::ParallelRecursiveMerge {
+  using merging::ParallelRecursiveMerge::strategyA;
+  using merging::ParallelRecursiveMerge::strategyB;
+};
+
+/**
+ * Mesure la durée d'exécution d'une fusion.
+ *
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] fusion la fusion.
+ * @return la durée d'exécution en secondes.
+ */
+template< typename Merge >
+double
+mesurer(const size_t& iters, const Merge& fusion) {
+  const double start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    fusion();
+  }
+  const double stop = omp_get_wtime();
+  return stop - start;
+}
+
+/**
+ * Affiche les performances d'une fusion.
+ *
+ * @param[in] titre le titre du benchmark.
+ * @param[in] verdict @c true si le résultat est celui de l'algorithme merge.
+ * @param[in] seq la durée d'exécution de l'algorithme merge.
+ * @param[in] par la durée d'exécution de la fusion évaluée.
+ * @param[in] threads le nombre de threads utilisés.
+ */
+void
+afficher(const std::string& titre,
+	 const bool& verdict,
+	 const double& seq,
+	 const double& par,
+	 const int& threads) {
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tDurée:\t\t" << par << " sec." << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "\tSpeedup:\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "\tEfficiency:\t"
+	    << Metrics::efficiency(seq, par, threads)
+	    << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Synonyme du type des éléments à fusionner.
+  typedef int Type;
+  const auto comp = std::less< const Type& >();
+
+  // Tailles des caches L2 et de dernier niveau (à défaut, valeurs
+  // courantes).
+  long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  l2 = l2 > 0 ? l2 : 256 * 1024;
+  llc = llc > 0 ? llc : 8 * 1024 * 1024;
+  std::cout << "L2: " << l2 / 1024 << " Kio, LLC: " << llc / 1024 << " Kio"
+	    << std::endl << std::endl;
+
+  // Nombre de threads et tolérance des stratégies récursives.
+  const int threads = omp_get_max_threads();
+  const merging::OpenMPExecutor executor(threads);
+  const size_t cutoff = 64 * 1024;
+
+  // Les deux conteneurs à fusionner occupent ensemble de la taille du cache
+  // L2 à dix fois celle du cache de dernier niveau.
+  const size_t fin = 10 * llc;
+  for (size_t octets = l2; ; octets = std::min(4 * octets, fin)) {
+
+    // Deux tableaux ordonnés de tailles voisines, construits par incréments
+    // aléatoires (générateur congruentiel, pour des résultats
+    // reproductibles).
+    const size_t total = octets / sizeof(Type);
+    std::vector< Type > lhs(total / 2 - 211), rhs(total - lhs.size());
+    uint32_t graine = 12345;
+    Type valeur = 0;
+    for (Type& x : lhs) {
+      graine = graine * 1664525u + 1013904223u;
+      valeur += (graine >> 24) % 4;
+      x = valeur;
+    }
+    valeur = 0;
+    for (Type& x : rhs) {
+      graine = graine * 1664525u + 1013904223u;
+      valeur += (graine >> 24) % 4;
+      x = valeur;
+    }
+
+    std::cout << "==[ " << octets / 1024 << " Kio ]==" << std::endl
+	      << std::endl;
+
+    // Durée d'exécution de l'algorithme merge de la bibliothèque standard.
+    std::vector< Type > reference(total), result(total);
+    const double seq = mesurer(iters, [&]() {
+	std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+		   reference.begin(), comp);
+      });
+    afficher("merge", true, seq, seq, 1);
+
+    // Durées d'exécution des trois stratégies.
+    const double a = mesurer(iters, [&]() {
+	executor.run([&]() {
+	    Strategies::strategyA(lhs.begin(), lhs.end(),
+				  rhs.begin(), rhs.end(),
+				  result.begin(), comp, cutoff, executor);
+	  });
+      });
+    afficher("strategyA", result == reference, seq, a, threads);
+    std::fill(result.begin(), result.end(), 0);
+    const double b = mesurer(iters, [&]() {
+	Strategies::strategyB(lhs.begin(), lhs.end(),
+			      rhs.begin(), rhs.end(),
+			      result.begin(), comp, cutoff);
+      });
+    afficher("strategyB", result == reference, seq, b, threads);
+    std::fill(result.begin(), result.end(), 0);
+    const double c = mesurer(iters, [&]() {
+	merging::ParallelRecursiveMerge::applyTiled(lhs.begin(), lhs.end(),
+						    rhs.begin(), rhs.end(),
+						    result.begin(), comp,
+						    executor);
+      });
+    afficher("applyTiled", result == reference, seq, c, threads);
+
+    if (octets == fin) {
+      break;
+    }
+
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,240 @@
+#include "ParallelSetOperations.hpp"
+#include "SimdIntersection.hpp"
+#include "OpenMPExecutor.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cstdint>
+#include <omp.h>
+
+/**
+ * Mesure la durée d'exécution d'une opération.
+ *
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] operation l'opération, renvoyant la fin de son résultat.
+ * @param[out] fin la fin du résultat de la dernière itération.
+ * @return la durée d'exécution en secondes.
+ */
+template< typename Operation, typename Iterator >
+double
+mesurer(const size_t& iters, const Operation& operation, Iterator& fin) {
+  const double start = omp_get_wtime();
+  for (size_t i = 0; i != iters; i ++) {
+    fin = operation();
+  }
+  const double stop = omp_get_wtime();
+  return stop - start;
+}
+
+/**
+ * Affiche les performances d'une opération.
+ *
+ * @param[in] titre le titre du benchmark.
+ * @param[in] taille la taille du résultat.
+ * @param[in] verdict @c true si le résultat est celui de la bibliothèque
+ *   standard.
+ * @param[in] seq la durée d'exécution de l'algorithme de la bibliothèque
+ *   standard.
+ * @param[in] par la durée d'exécution de l'opération évaluée.
+ * @param[in] threads le nombre de threads utilisés.
+ */
+void
+afficher(const std::string& titre,
+	 const size_t& taille,
+	 const bool& verdict,
+	 const double& seq,
+	 const double& par,
+	 const int& threads) {
+  std::cout << "--[ " << titre << ": begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tRésultat:\t" << taille << " éléments" << std::endl;
+  std::cout << "\tDurée (std / par.):\t" << seq << " / " << par << " sec."
+	    << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "\tSpeedup:\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "\tEfficiency:\t"
+	    << Metrics::efficiency(seq, par, threads)
+	    << std::endl;
+  std::cout << "--[ " << titre << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Compare les trois opérations parallèles aux algorithmes de la bibliothèque
+ * standard, ainsi que le noyau vectoriel d'intersection à l'algorithme
+ * set_intersection, pour deux listes ordonnées d'identifiants.
+ *
+ * @param[in] titre le nom de la densité.
+ * @param[in] iters le nombre d'itérations.
+ * @param[in] lhs la première liste.
+ * @param[in] rhs la seconde liste.
+ */
+void
+tester(const std::string& titre,
+       const size_t& iters,
+       const std::vector< uint32_t >& lhs,
+       const std::vector< uint32_t >& rhs) {
+  typedef std::vector< uint32_t > Tableau;
+  typedef Tableau::iterator Iterator;
+  const std::less< const uint32_t& > comp;
+  const int threads = omp_get_max_threads();
+  const merging::OpenMPExecutor executor(threads);
+  Tableau reference(lhs.size() + rhs.size()), result(reference.size());
+  Iterator finRef, fin;
+  double seq, par;
+
+  std::cout << "==[ " << titre << " ]==" << std::endl << std::endl;
+
+  // Noyau vectoriel, séquentiel.
+  seq = mesurer(iters, [&]() {
+      return std::set_intersection(lhs.begin(), lhs.end(),
+				   rhs.begin(), rhs.end(),
+				   reference.begin(), comp);
+    }, finRef);
+  par = mesurer(iters, [&]() {
+      return merging::SimdIntersection::intersect(lhs.begin(), lhs.end(),
+						  rhs.begin(), rhs.end(),
+						  result.begin(), comp);
+    }, fin);
+  afficher("SimdIntersection", fin - result.begin(),
+	   fin - result.begin() == finRef - reference.begin()
+	   && std::equal(reference.begin(), finRef, result.begin()),
+	   seq, par, 1);
+
+  // Intersection parallèle.
+  par = mesurer(iters, [&]() {
+      return merging::ParallelSetOperations::setIntersection(lhs.begin(),
+							     lhs.end(),
+							     rhs.begin(),
+							     rhs.end(),
+							     result.begin(),
+							     comp, executor);
+    }, fin);
+  afficher("setIntersection", fin - result.begin(),
+	   fin - result.begin() == finRef - reference.begin()
+	   && std::equal(reference.begin(), finRef, result.begin()),
+	   seq, par, threads);
+
+  // Union parallèle.
+  seq = mesurer(iters, [&]() {
+      return std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+			    reference.begin(), comp);
+    }, finRef);
+  par = mesurer(iters, [&]() {
+      return merging::ParallelSetOperations::setUnion(lhs.begin(), lhs.end(),
+						      rhs.begin(), rhs.end(),
+						      result.begin(), comp,
+						      executor);
+    }, fin);
+  afficher("setUnion", fin - result.begin(),
+	   fin - result.begin() == finRef - reference.begin()
+	   && std::equal(reference.begin(), finRef, result.begin()),
+	   seq, par, threads);
+
+  // Différence parallèle.
+  seq = mesurer(iters, [&]() {
+      return std::set_difference(lhs.begin(), lhs.end(),
+				 rhs.begin(), rhs.end(),
+				 reference.begin(), comp);
+    }, finRef);
+  par = mesurer(iters, [&]() {
+      return merging::ParallelSetOperations::setDifference(lhs.begin(),
+							   lhs.end(),
+							   rhs.begin(),
+							   rhs.end(),
+							   result.begin(),
+							   comp, executor);
+    }, fin);
+  afficher("setDifference", fin - result.begin(),
+	   fin - result.begin() == finRef - reference.begin()
+	   && std::equal(reference.begin(), finRef, result.begin()),
+	   seq, par, threads);
+}
+
+/**
+ * Tire n identifiants ordonnés dans [0, univers[.
+ *
+ * @param[in] n le nombre de tirages.
+ * @param[in] univers le nombre d'identifiants possibles.
+ * @param[in] uniques @c true pour éliminer les doublons.
+ * @param[in,out] graine la graine du générateur congruentiel (pour des
+ *   résultats reproductibles).
+ * @return les identifiants, ordonnés.
+ */
+std::vector< uint32_t >
+tirer(const size_t& n, const uint64_t& univers, const bool& uniques,
+      uint64_t& graine) {
+  std::vector< uint32_t > ids(n);
+  for (uint32_t& x : ids) {
+    graine = graine * 6364136223846793005ull + 1442695040888963407ull;
+    x = (graine >> 32) % univers;
+  }
+  std::sort(ids.begin(), ids.end());
+  if (uniques) {
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  }
+  return ids;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof() || iters == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Deux listes de 4M identifiants (au plus), tirés dans des univers de
+  // plus en plus grands : la part des identifiants communs passe d'environ
+  // 80 % à 0,1 %.
+  const size_t n = 4 * 1024 * 1024;
+  uint64_t graine = 12345;
+  const uint64_t facteurs[] = { 1, 4, 64, 1024 };
+  for (const uint64_t& facteur : facteurs) {
+    const std::vector< uint32_t > lhs = tirer(n, n * facteur, true, graine);
+    const std::vector< uint32_t > rhs = tirer(n, n * facteur, true, graine);
+    tester("univers de " + std::to_string(facteur) + " x 4M identifiants",
+	   iters, lhs, rhs);
+  }
+
+  // Multi-ensembles : chaque identifiant est répété 16 fois en moyenne.
+  const std::vector< uint32_t > lhs = tirer(n, n / 16, false, graine);
+  const std::vector< uint32_t > rhs = tirer(n, n / 16, false, graine);
+  tester("multi-ensembles", iters, lhs, rhs);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
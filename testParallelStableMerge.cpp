@@ -1,12 +1,28 @@
 #include "ParallelStableMerge.hpp"
 #include "Metrics.hpp"
-#include <tbb/task_scheduler_init.h>
+#include <tbb/task_arena.h>
 #include <vector>
-#include <numeric>
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <chrono>
 #include <cstdlib>
+#include <cstdint>
+
+/**
+ * Un enregistrement : une clé et son rang d'origine (positif dans le premier
+ * conteneur, négatif dans le second), afin de vérifier la stabilité.
+ */
+struct Record {
+  int key;
+  int rang;
+};
+
+bool
+operator==(const Record& x, const Record& y) {
+  return x.key == y.key && x.rang == y.rang;
+}
 
 /**
  * Programme principal.
@@ -49,15 +65,25 @@ main(int argc, char* argv[]) {
   // Relation d'ordre utilisée : strictement inférieur à.
   const auto comp = std::less< const Type& >();
 
-  // Deux tableaux d'entiers de taille différentes à fusionner.
-//  std::vector< Type > lhs(128 * 1024), rhs(lhs.size() + 211);
-
-  std::vector< Type > lhs(4), rhs(4);
-  std::iota(lhs.begin(), lhs.end(), 19);
-  std::iota(rhs.begin(), rhs.end(), 5);
+  // Deux tableaux d'entiers de tailles différentes à fusionner, tirés par un
+  // générateur congruentiel (pour des résultats reproductibles) parmi peu de
+  // valeurs, de sorte que les doublons abondent.
+  std::vector< Type > lhs(4 * 1024 * 1024), rhs(lhs.size() + 211);
+  uint32_t graine = 12345;
+  for (Type& x : lhs) {
+    graine = graine * 1664525u + 1013904223u;
+    x = (graine >> 1) % (lhs.size() / 4);
+  }
+  for (Type& x : rhs) {
+    graine = graine * 1664525u + 1013904223u;
+    x = (graine >> 1) % (lhs.size() / 4);
+  }
+  std::sort(lhs.begin(), lhs.end(), comp);
+  std::sort(rhs.begin(), rhs.end(), comp);
 
-  // Conteneur accueillant le résultat de la fusion.
-  std::vector< Type > result(lhs.size() + rhs.size());
+  // Conteneurs accueillant le résultat de référence et celui de la fusion.
+  std::vector< Type > reference(lhs.size() + rhs.size());
+  std::vector< Type > result(reference.size());
 
   // Temps auquel sont démarrées et arrêtées chaque séquence de calcul.
   std::chrono::time_point< std::chrono::steady_clock > start, stop;
@@ -66,11 +92,11 @@ main(int argc, char* argv[]) {
   start = std::chrono::steady_clock::now();
   for (size_t i = 0; i != iters; i ++) {
     std::merge(lhs.begin(),
-    	       lhs.end(),
-    	       rhs.begin(),
-    	       rhs.end(),
-    	       result.begin(),
-    	       comp);
+	       lhs.end(),
+	       rhs.begin(),
+	       rhs.end(),
+	       reference.begin(),
+	       comp);
   }
   stop = std::chrono::steady_clock::now();
   const int seq =
@@ -80,28 +106,61 @@ main(int argc, char* argv[]) {
   std::cout << "--[ merge: begin ]--" << std::endl;
   std::cout << "\tDurée:\t\t" << seq << " msec." << std::endl;
   std::cout << "\tVerdict:\t\t"
-  	    << std::boolalpha
-  	    << std::is_sorted(result.begin(), result.end(), comp)
-  	    << std::endl;
+	    << std::boolalpha
+	    << std::is_sorted(reference.begin(), reference.end(), comp)
+	    << std::endl;
   std::cout << "--[ merge: end ]--" << std::endl;
   std::cout << std::endl;
 
-  // Initialisation du scheduler de TBB avec le nombre de cores logiques.
-  const int threads = tbb::task_scheduler_init::default_num_threads();
-  tbb::task_scheduler_init init(threads);
-
-  // L'algorithme ParallelStableMerge ne peut fonctionner qu'avec une relation
-  // d'ordre telle que <= ou >= mais pas < ou >, ce qui est justement notre
-  // cas. Nous allons donc ruser en deux temps :
-  // 1) nous allons définir la relation d'ordre inverse : ici >=.
-  // 2) nous allons fusionner nos conteneurs en les balayant tous de la droite
-  //    vers la gauche.
-  // 3) Bonjour le mal de tête ...
-  const auto invComp = std::greater_equal< const Type& >();
-
-  // Durées d'exécution de l'algorithme ParallelStableMerge. Nous allons
-  // utiliser plusieurs valeurs du nombre de threads disponibles.
+  // Les mêmes clés, munies de leur rang d'origine : la fusion stable doit
+  // reproduire le résultat de l'algorithme merge.
+  std::vector< Record > a(lhs.size()), b(rhs.size());
+  for (size_t i = 0; i != a.size(); i ++) {
+    a[i].key = lhs[i];
+    a[i].rang = i;
+  }
+  for (size_t i = 0; i != b.size(); i ++) {
+    b[i].key = rhs[i];
+    b[i].rang = -1 - int(i);
+  }
+  const auto parCle = [](const Record& x, const Record& y) {
+    return x.key < y.key;
+  };
+  const auto parCleInverse = [](const Record& x, const Record& y) {
+    return x.key > y.key;
+  };
+  std::vector< Record > attendu(a.size() + b.size()), stable(attendu.size());
+  std::merge(a.begin(), a.end(), b.begin(), b.end(), attendu.begin(), parCle);
+
+  // Durées d'exécution de l'algorithme ParallelStableMerge, pour plusieurs
+  // valeurs du nombre de threads disponibles, selon deux variantes :
+  // - le parcours naturel des conteneurs, muni de la relation d'ordre < ;
+  // - leur parcours de la droite vers la gauche (reverse_iterator), muni de
+  //   la relation d'ordre inverse >, seul possible lorsque la fusion
+  //   attendait une relation d'ordre <= : le résultat est ordonné, mais à
+  //   égalité ce sont alors les éléments du second conteneur qui précèdent
+  //   ceux du premier.
+  const int threads = tbb::this_task_arena::max_concurrency();
   for (int nb = 1; nb <= threads; nb ++) {
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::ParallelStableMerge::apply(lhs.begin(),
+					  lhs.end(),
+					  rhs.begin(),
+					  rhs.end(),
+					  result.begin(),
+					  comp,
+					  nb);
+    }
+    stop = std::chrono::steady_clock::now();
+    const int par =
+      std::chrono::duration_cast< std::chrono::milliseconds >(stop - start).count();
+    const bool verdict = result == reference;
+    merging::ParallelStableMerge::apply(a.begin(), a.end(),
+					b.begin(), b.end(),
+					stable.begin(), parCle, nb);
+    const bool stabilite = stable == attendu;
+
     start = std::chrono::steady_clock::now();
     for (size_t i = 0; i != iters; i ++) {
       merging::ParallelStableMerge::apply(lhs.rbegin(),
@@ -109,30 +168,39 @@ main(int argc, char* argv[]) {
 					  rhs.rbegin(),
 					  rhs.rend(),
 					  result.rbegin(),
-					  invComp,
+					  std::greater< const Type& >(),
 					  nb);
     }
     stop = std::chrono::steady_clock::now();
-  const int par =
-    std::chrono::duration_cast< std::chrono::milliseconds >(stop - start).count();
-
-  // Affichage des résultats de la version parallèle avec, en plus, le calcul
-  // des facteurs d'accélération et d'efficacité. Une accélération sur-linéaire
-  // indique une meilleure utilisation des caches L2 (partagé) et L1 (privé).
+    const int inv =
+      std::chrono::duration_cast< std::chrono::milliseconds >(stop - start).count();
+    const bool verdictInverse = result == reference;
+    merging::ParallelStableMerge::apply(a.rbegin(), a.rend(),
+					b.rbegin(), b.rend(),
+					stable.rbegin(), parCleInverse, nb);
+    const bool stabiliteInverse = stable == attendu;
+
+    // Affichage des résultats des deux variantes avec, en plus, le calcul
+    // des facteurs d'accélération et d'efficacité de la variante naturelle.
+    // Une accélération sur-linéaire indique une meilleure utilisation des
+    // caches L2 (partagé) et L1 (privé).
     std::cout << "--[ ParallelStableMerge: begin ]--" << std::endl;
     std::cout << "\tThread(s):\t" << nb << std::endl;
-    std::cout << "\tDurée:\t\t" << par << " msec." << std::endl;
+    std::cout << "\tDurée (avant / arrière):\t"
+	      << par << " / " << inv << " msec." << std::endl;
     std::cout << "\tVerdict:\t\t"
-  	      << std::boolalpha
-  	      << std::is_sorted(result.begin(), result.end(), comp)
-  	      << std::endl;
+	      << std::boolalpha << verdict << " / " << verdictInverse
+	      << std::endl;
+    std::cout << "\tStable:\t\t"
+	      << std::boolalpha << stabilite << " / " << stabiliteInverse
+	      << std::endl;
     std::cout << "\tSpeedup:\t"
-  	      << Metrics::speedup(seq, par)
-  	      << std::endl;
+	      << Metrics::speedup(seq, par)
+	      << std::endl;
     std::cout << "\tEfficiency:\t"
-  	      << Metrics::efficiency(seq, par, nb)
-  	      << std::endl;
-    std::cout << "--[ parallelStableMerge: end ]--" << std::endl;
+	      << Metrics::efficiency(seq, par, nb)
+	      << std::endl;
+    std::cout << "--[ ParallelStableMerge: end ]--" << std::endl;
     std::cout << std::endl;
   }
 
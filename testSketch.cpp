@@ -0,0 +1,244 @@
+#include "Sketch.hpp"
+#include "Count.hpp"
+#include "Histogram.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdint>
+
+/**
+ * Routine d'évaluation du sketch Count-Min : sa construction suivie d'une
+ * estimation par valeur recherchée contre un appel à Count::apply par valeur
+ * recherchée.
+ *
+ * @param[in] tableau le tableau à traiter.
+ * @param[in] cles les valeurs recherchées.
+ * @param[in] epsilon l'erreur additive relative au nombre d'éléments.
+ * @param[in] delta la probabilité de dépasser cette erreur.
+ * @param[in] threads le nombre de threads utilisés.
+ * @param[in] iters le nombre d'itérations à effectuer sur le même algorithme
+ *   pour obtenir des mesures de temps conséquentes.
+ */
+void
+testerCountMin(const std::vector< int >& tableau,
+               const std::vector< int >& cles,
+               const double& epsilon,
+               const double& delta,
+               const int& threads,
+               const size_t& iters) {
+
+  using namespace paralgos;
+
+  // Les résultats de chaque version.
+  std::vector< long > exacts(cles.size());
+  std::vector< size_t > estimations(cles.size());
+
+  // Durée d'exécution d'un appel à Count::apply par valeur recherchée.
+  double seq;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      for (size_t k = 0; k != cles.size(); k ++) {
+        exacts[k] = Count::apply(tableau.cbegin(), tableau.cend(), cles[k]);
+      }
+    }
+    const double stop = omp_get_wtime();
+    seq = stop - start;
+  }
+
+  // Durée d'exécution de la construction du sketch et des estimations.
+  double par;
+  size_t largeur = 0, profondeur = 0;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      const CountMinSketch< int > sketch =
+        Sketch::countMin(tableau.cbegin(), tableau.cend(), epsilon, delta);
+      for (size_t k = 0; k != cles.size(); k ++) {
+        estimations[k] = sketch.estimate(cles[k]);
+      }
+      largeur = sketch.width();
+      profondeur = sketch.depth();
+    }
+    const double stop = omp_get_wtime();
+    par = stop - start;
+  }
+
+  // Vérification des résultats : une estimation n'est jamais inférieure à la
+  // valeur exacte, et ne la dépasse de plus de epsilon * N qu'avec une
+  // probabilité d'au plus delta.
+  const double borne = epsilon * tableau.size();
+  bool verdict = true;
+  size_t erreurMax = 0, horsBorne = 0;
+  for (size_t k = 0; k != cles.size(); k ++) {
+    verdict = verdict && long(estimations[k]) >= exacts[k];
+    const size_t erreur = estimations[k] - exacts[k];
+    erreurMax = std::max(erreurMax, erreur);
+    horsBorne += erreur > borne;
+  }
+
+  // Affichage des résultats.
+  const double elements = double(tableau.size()) * iters / 1e6;
+  std::cout << "--[ Count-Min: begin ] --" << std::endl;
+  std::cout << "\tValeurs :\t\t" << cles.size() << std::endl;
+  std::cout << "\tDimensions :\t\t" << profondeur << " x " << largeur
+            << std::endl;
+  std::cout << "\tDurée Count :\t\t" << seq << " sec." << std::endl;
+  std::cout << "\tDurée Count-Min :\t" << par << " sec." << std::endl;
+  std::cout << "\tDébit Count-Min :\t" << elements / par << " Méléments/s"
+            << std::endl;
+  std::cout << "\tErreur max. :\t\t" << erreurMax << " (borne "
+            << borne << ")" << std::endl;
+  std::cout << "\tHors borne :\t\t" << horsBorne << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "\tThread(s):\t\t" << threads << std::endl;
+  std::cout << "\tSpeedup:\t\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "--[ Count-Min: end ] --" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Routine d'évaluation du sketch HyperLogLog contre le dénombrement exact
+ * des valeurs distinctes par un histogramme.
+ *
+ * @param[in] tableau le tableau à traiter.
+ * @param[in] precision le nombre de bits du haché désignant le registre.
+ * @param[in] threads le nombre de threads utilisés.
+ * @param[in] iters le nombre d'itérations à effectuer sur le même algorithme
+ *   pour obtenir des mesures de temps conséquentes.
+ */
+void
+testerHyperLogLog(const std::vector< int >& tableau,
+                  const int& precision,
+                  const int& threads,
+                  const size_t& iters) {
+
+  using namespace paralgos;
+
+  // Les résultats de chaque version.
+  size_t exact = 0;
+  double estimation = 0, erreurType = 0;
+
+  // Durée d'exécution du dénombrement exact.
+  double seq;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      exact = Histogram::apply(tableau.cbegin(), tableau.cend()).size();
+    }
+    const double stop = omp_get_wtime();
+    seq = stop - start;
+  }
+
+  // Durée d'exécution de la construction du sketch et de l'estimation.
+  double par;
+  {
+    const double start = omp_get_wtime();
+    for (size_t i = 0; i != iters; i ++) {
+      const HyperLogLog< int > sketch =
+        Sketch::hyperLogLog(tableau.cbegin(), tableau.cend(), precision);
+      estimation = sketch.estimate();
+      erreurType = sketch.error();
+    }
+    const double stop = omp_get_wtime();
+    par = stop - start;
+  }
+
+  // Vérification des résultats : l'erreur relative ne dépasse trois fois
+  // l'erreur type qu'avec une probabilité négligeable.
+  const double erreur = std::abs(estimation - exact) / exact;
+  const bool verdict = erreur <= 3 * erreurType;
+
+  // Affichage des résultats.
+  const double elements = double(tableau.size()) * iters / 1e6;
+  std::cout << "--[ HyperLogLog (p = " << precision << "): begin ] --"
+            << std::endl;
+  std::cout << "\tDistincts :\t\t" << exact << std::endl;
+  std::cout << "\tEstimation :\t\t" << estimation << std::endl;
+  std::cout << "\tDurée exacte :\t\t" << seq << " sec." << std::endl;
+  std::cout << "\tDurée HyperLogLog :\t" << par << " sec." << std::endl;
+  std::cout << "\tDébit HyperLogLog :\t" << elements / par << " Méléments/s"
+            << std::endl;
+  std::cout << "\tErreur relative :\t" << erreur << " (type "
+            << erreurType << ")" << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << verdict << std::endl;
+  std::cout << "\tThread(s):\t\t" << threads << std::endl;
+  std::cout << "\tSpeedup:\t\t" << Metrics::speedup(seq, par) << std::endl;
+  std::cout << "--[ HyperLogLog (p = " << precision << "): end ] --"
+            << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //  Nombre de threads utilisés.
+  const int threads = paralgos::ExecutionContext::standard().threads();
+
+  // Nombre d'éléments à traiter (celui de testCount).
+  const int n = 1024 * 1021;
+
+  // Le tableau manipulé : un quart des éléments se partagent 16 valeurs
+  // fréquentes, les autres sont tirés parmi 200000 valeurs (générateur
+  // congruentiel, pour des résultats reproductibles).
+  std::vector< int > tableau(n);
+  uint32_t graine = 12345;
+  for (int i = 0; i != n; i ++) {
+    graine = graine * 1664525u + 1013904223u;
+    const uint32_t tirage = graine >> 8;
+    tableau[i] = tirage % 4 == 0 ? (tirage >> 2) % 16 : (tirage >> 2) % 200000;
+  }
+
+  // Les valeurs recherchées : les 16 valeurs fréquentes et 48 valeurs rares.
+  std::vector< int > cles(64);
+  for (int k = 0; k != 64; k ++) {
+    cles[k] = k < 16 ? k : 1000 + k * 3001;
+  }
+
+  // Premier test : le sketch Count-Min.
+  testerCountMin(tableau, cles, 0.001, 0.01, threads, iters);
+
+  // Tests suivants : le sketch HyperLogLog, à deux précisions.
+  testerHyperLogLog(tableau, 10, threads, iters);
+  testerHyperLogLog(tableau, 14, threads, iters);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}